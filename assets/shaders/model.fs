@@ -0,0 +1,15 @@
+#version 330
+// raylib's default fragment shader, for variants that only replace the
+// vertex stage (ShaderCache.hpp)
+in vec2 fragTexCoord;
+in vec4 fragColor;
+
+uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+
+out vec4 finalColor;
+
+void main() {
+    vec4 texelColor = texture(texture0, fragTexCoord);
+    finalColor = texelColor * colDiffuse * fragColor;
+}
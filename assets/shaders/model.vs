@@ -0,0 +1,25 @@
+#version 330
+// raylib's default vertex shader, with a variant for packed vertices
+// (VertexPacking.hpp). Packed positions arrive as 0..1 and the model
+// matrix scales them back out, UVs are half floats the hardware widens.
+// Packed meshes have no vertex colours.
+in vec3 vertexPosition;
+in vec2 vertexTexCoord;
+#ifndef PACKED_VERTICES
+in vec4 vertexColor;
+#endif
+
+uniform mat4 mvp;
+
+out vec2 fragTexCoord;
+out vec4 fragColor;
+
+void main() {
+    fragTexCoord = vertexTexCoord;
+#ifdef PACKED_VERTICES
+    fragColor = vec4(1.0);
+#else
+    fragColor = vertexColor;
+#endif
+    gl_Position = mvp * vec4(vertexPosition, 1.0);
+}
@@ -0,0 +1,21 @@
+#version 330
+in vec2 fragTexCoord;
+in vec4 fragColor;
+
+uniform sampler2D texture0; // SDF glyph atlas (distance stored in alpha)
+uniform vec4 colDiffuse;
+
+out vec4 finalColor;
+
+void main() {
+    // 1. Signed distance to the glyph edge (0.5 = exactly on the edge)
+    float dist = texture(texture0, fragTexCoord).a - 0.5;
+
+    // 2. How much the distance changes across one screen pixel, so the edge
+    // stays about one pixel wide no matter how big the text is drawn
+    float width = length(vec2(dFdx(dist), dFdy(dist)));
+
+    float alpha = smoothstep(-width, width, dist);
+
+    finalColor = vec4(fragColor.rgb, fragColor.a * alpha) * colDiffuse;
+}
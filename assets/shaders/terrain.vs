@@ -1,19 +1,41 @@
 #version 330
 in vec3 vertexPosition;
 in vec2 vertexTexCoord;
+#ifdef PACKED_VERTICES
+in vec2 vertexNormal;   // Octahedral, see VertexPacking.hpp
+#else
 in vec3 vertexNormal;
+#endif
 
 uniform mat4 mvp;
 uniform mat4 matModel;
+uniform mat4 matNormal;
 
 out vec2 fragTexCoord;
 out vec3 fragNormal;
 out vec3 fragPosition;
 
+#ifdef PACKED_VERTICES
+// Unfold the lower half of the octahedron back over the diagonals
+vec3 decodeNormal(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x += (n.x >= 0.0) ? -t : t;
+    n.y += (n.y >= 0.0) ? -t : t;
+    return normalize(n);
+}
+#endif
+
 void main() {
     fragTexCoord = vertexTexCoord;
-    // Pass the normal to fragment shader, adjusted by model rotation
-    fragNormal = normalize(vec3(matModel * vec4(vertexNormal, 0.0)));
+#ifdef PACKED_VERTICES
+    vec3 normal = decodeNormal(vertexNormal);
+#else
+    vec3 normal = vertexNormal;
+#endif
+    // Pass the normal to fragment shader, adjusted by model rotation. The
+    // normal matrix, since packed meshes put a non-uniform scale in matModel.
+    fragNormal = normalize(vec3(matNormal * vec4(normal, 0.0)));
     gl_Position = mvp * vec4(vertexPosition, 1.0);
     fragPosition = (matModel * vec4(vertexPosition, 1.0)).xyz;
-}
\ No newline at end of file
+}
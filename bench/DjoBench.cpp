@@ -0,0 +1,382 @@
+// Engine hot-path benchmarks on the Towers map: terrain queries, prop
+// transforms, walking through a forest, the ball and asset loading. Models
+// load through ObjLoader on a JobSystem, the way the game loads them, with
+// raylib's LoadModel timed next to it as the baseline.
+//
+// Every benchmark runs a fixed, seeded workload several times and reports
+// the median time per operation, so two runs on the same machine agree to a
+// few percent. Results go out as JSON; a stored result can be used as the
+// baseline for the next run.
+//
+// Run from the repo root:
+//   build/bench/djo_bench [--runs=N] [--json=out.json] [--pack=build/assets.pack]
+//   build/bench/djo_bench --compare=baseline.json [--threshold=10]
+
+#include "raylib.h"
+#include "raymath.h"
+#include "rlgl.h"
+#include "Ball.hpp"
+#include "CharacterController.hpp"
+#include "Collision.hpp"
+#include "JobSystem.hpp"
+#include "ObjLoader.hpp"
+#include "PackArchive.hpp"
+#include "Placement.hpp"
+#include "RayMesh.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    struct Result {
+        std::string name;
+        int ops = 0;            // Operations per run
+        int runs = 0;
+        double nsPerOp = 0.0;   // Median over the runs
+        double minNsPerOp = 0.0;
+    };
+
+    struct Options {
+        int runs = 9;
+        const char* jsonPath = nullptr;
+        const char* comparePath = nullptr;
+        const char* packPath = nullptr;     // Load through a mounted pack like the game, loose files without
+        double threshold = 10.0;    // Percent slower than the baseline that counts as a regression
+    };
+
+    // Keeps the optimiser from deleting work whose result nobody reads
+    volatile float sink;
+
+    double nowNs() {
+        using namespace std::chrono;
+        return duration<double, std::nano>(steady_clock::now().time_since_epoch()).count();
+    }
+
+    // One untimed warm-up run (caches, first-touch page faults), then runs timed ones
+    template <typename Fn>
+    Result measure(const char* name, int ops, int runs, Fn fn) {
+        fn();
+
+        std::vector<double> perOp(runs);
+        for (int r = 0; r < runs; r++) {
+            double start = nowNs();
+            fn();
+            perOp[r] = (nowNs() - start) / ops;
+        }
+        std::sort(perOp.begin(), perOp.end());
+
+        Result result;
+        result.name = name;
+        result.ops = ops;
+        result.runs = runs;
+        result.nsPerOp = perOp[runs / 2];
+        result.minNsPerOp = perOp[0];
+        printf("%-28s %12.1f ns/op %12.1f min %8d ops\n", name, result.nsPerOp, result.minNsPerOp, ops);
+        return result;
+    }
+
+    bool writeJson(const char* path, const std::vector<Result>& results) {
+        FILE* file = fopen(path, "w");
+        if (!file) return false;
+
+        // One benchmark per line, same order every run, so results diff cleanly
+        fprintf(file, "{\n  \"benchmarks\": [\n");
+        for (size_t i = 0; i < results.size(); i++) {
+            const Result& r = results[i];
+            fprintf(file, "    { \"name\": \"%s\", \"ns_per_op\": %.1f, \"min_ns_per_op\": %.1f, \"ops\": %d, \"runs\": %d }%s\n",
+                    r.name.c_str(), r.nsPerOp, r.minNsPerOp, r.ops, r.runs, (i + 1 < results.size()) ? "," : "");
+        }
+        fprintf(file, "  ]\n}\n");
+        fclose(file);
+        return true;
+    }
+
+    // Reads back what writeJson() wrote: every "name" and the "ns_per_op" after it
+    bool readBaseline(const char* path, std::vector<Result>& out) {
+        FILE* file = fopen(path, "rb");
+        if (!file) return false;
+
+        std::string text;
+        char buffer[4096];
+        size_t n;
+        while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) text.append(buffer, n);
+        fclose(file);
+
+        size_t pos = 0;
+        while ((pos = text.find("\"name\"", pos)) != std::string::npos) {
+            size_t open = text.find('"', text.find(':', pos) + 1);
+            size_t close = text.find('"', open + 1);
+            size_t value = text.find("\"ns_per_op\"", close);
+            if (open == std::string::npos || close == std::string::npos || value == std::string::npos) break;
+
+            Result r;
+            r.name = text.substr(open + 1, close - open - 1);
+            r.nsPerOp = strtod(text.c_str() + text.find(':', value) + 1, nullptr);
+            out.push_back(r);
+            pos = close;
+        }
+        return !out.empty();
+    }
+
+    // Prints every benchmark against its baseline. Returns the number of regressions.
+    int compare(const std::vector<Result>& results, const std::vector<Result>& baseline, double threshold) {
+        int regressions = 0;
+        printf("\n%-28s %12s %12s %9s\n", "", "baseline", "now", "change");
+
+        for (const Result& r : results) {
+            auto it = std::find_if(baseline.begin(), baseline.end(), [&](const Result& b) { return b.name == r.name; });
+            if (it == baseline.end() || it->nsPerOp <= 0.0) {
+                printf("%-28s %12s %12.1f %9s\n", r.name.c_str(), "-", r.nsPerOp, "new");
+                continue;
+            }
+
+            double change = 100.0 * (r.nsPerOp - it->nsPerOp) / it->nsPerOp;
+            bool regressed = change > threshold;
+            regressions += regressed;
+            printf("%-28s %12.1f %12.1f %+8.1f%%%s\n", r.name.c_str(), it->nsPerOp, r.nsPerOp, change,
+                   regressed ? "  REGRESSION" : (change < -threshold ? "  faster" : ""));
+        }
+        return regressions;
+    }
+
+    Options parseOptions(int argc, char** argv) {
+        Options options;
+        for (int i = 1; i < argc; i++) {
+            const char* arg = argv[i];
+            if (strncmp(arg, "--runs=", 7) == 0) options.runs = std::max(1, atoi(arg + 7));
+            else if (strncmp(arg, "--json=", 7) == 0) options.jsonPath = arg + 7;
+            else if (strncmp(arg, "--compare=", 10) == 0) options.comparePath = arg + 10;
+            else if (strncmp(arg, "--threshold=", 12) == 0) options.threshold = atof(arg + 12);
+            else if (strncmp(arg, "--pack=", 7) == 0) options.packPath = arg + 7;
+            else printf("Unknown option '%s'\n", arg);
+        }
+        return options;
+    }
+
+    // UnloadModel leaves material textures alone, so both loaders' textures
+    // go here too or every run would leak them
+    void unloadAll(Model model) {
+        for (int m = 0; m < model.materialCount; m++) {
+            for (int map : { MATERIAL_MAP_DIFFUSE, MATERIAL_MAP_SPECULAR, MATERIAL_MAP_NORMAL, MATERIAL_MAP_HEIGHT }) {
+                Texture2D texture = model.materials[m].maps[map].texture;
+                if (texture.id > 0 && texture.id != rlGetTextureIdDefault()) UnloadTexture(texture);
+            }
+        }
+        UnloadModel(model);
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options = parseOptions(argc, argv);
+
+    // LoadModel and LoadTexture upload to the GPU, so they need a GL context.
+    // The window stays hidden.
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    SetTraceLogLevel(LOG_WARNING);
+    InitWindow(64, 64, "djo_bench");
+
+    // Same pack and workers the game loads with
+    PackArchive pack;
+    if (options.packPath) {
+        if (!pack.open(options.packPath)) {
+            printf("Couldn't open %s\n", options.packPath);
+            CloseWindow();
+            return 1;
+        }
+        pack.mount();
+    }
+
+    JobSystem jobs;
+    jobs.init();
+
+    Model map = LoadModel("assets/maps/Towers/Towers.obj");
+    if (map.meshCount == 0) {
+        printf("Couldn't load assets/maps/Towers/Towers.obj (run from the repo root)\n");
+        jobs.shutdown();
+        CloseWindow();
+        return 1;
+    }
+
+    // The same collision copies the game builds
+    RayMesh terrainRays;
+    terrainRays.build(map.meshes[0], map.transform);
+    CollisionWorld world;
+    world.buildTerrain(map.meshes[0], map.transform);
+
+    BoundingBox bounds = world.getTerrain().getBounds();
+    float halfSize = 0.5f * fminf(bounds.max.x - bounds.min.x, bounds.max.z - bounds.min.z);
+    Vector3 center = Vector3Scale(Vector3Add(bounds.min, bounds.max), 0.5f);
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> spread(-halfSize * 0.9f, halfSize * 0.9f);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    auto heightAt = [&](float x, float z) {
+        float height;
+        Vector3 normal;
+        return world.getTerrain().sampleSurface(x, z, height, normal) ? height : 0.0f;
+    };
+
+    // A forest like the scattered one, dense enough that walking hits trunks
+    const int treeCount = 4000;
+    for (int i = 0; i < treeCount; i++) {
+        float x = center.x + spread(rng), z = center.z + spread(rng);
+        world.addCylinder({ x, heightAt(x, z), z }, 0.5f, 12.0f);
+    }
+    world.buildBroadphase();
+
+    printf("Towers.obj: %d triangles, %d trees, %d workers, %d runs, %s\n\n", map.meshes[0].triangleCount, treeCount,
+           jobs.getWorkerCount(), options.runs, pack.isOpen() ? options.packPath : "loose files");
+    std::vector<Result> results;
+
+    // 1. Terrain queries. getMapHeightAt/getMapNormalAt answer from the collider
+    // (surface_grid); the ray cases time RayMesh, the GetRayCollisionMesh
+    // stand-in, for picking and line-of-sight style casts.
+    const int queryCount = 4096;
+    std::vector<Vector2> spots(queryCount);
+    for (Vector2& s : spots) s = { center.x + spread(rng), center.z + spread(rng) };
+
+    results.push_back(measure("terrain/height_ray", queryCount, options.runs, [&] {
+        float sum = 0.0f;
+        for (const Vector2& s : spots) {
+            RayCollision hit = terrainRays.cast({ { s.x, 1000.0f, s.y }, { 0, -1, 0 } });
+            sum += hit.hit ? hit.point.y : 0.0f;
+        }
+        sink = sum;
+    }));
+
+    // The second ray case is a slanted one: a look from eye height, 20
+    // degrees down in a random heading, which crosses many cells before it
+    // lands. Its own generator, so the workloads after it stay the same.
+    std::vector<Ray> sightRays(queryCount);
+    std::mt19937 sightRng(4321);
+    std::uniform_real_distribution<float> heading(0.0f, 2.0f * PI);
+    for (int i = 0; i < queryCount; i++) {
+        float angle = heading(sightRng);
+        float down = 20.0f * DEG2RAD;
+        Vector3 origin = { spots[i].x, heightAt(spots[i].x, spots[i].y) + 1.7f, spots[i].y };
+        sightRays[i] = { origin, { cosf(angle) * cosf(down), -sinf(down), sinf(angle) * cosf(down) } };
+    }
+
+    results.push_back(measure("terrain/slanted_ray", queryCount, options.runs, [&] {
+        float sum = 0.0f;
+        for (const Ray& ray : sightRays) {
+            RayCollision hit = terrainRays.cast(ray);
+            sum += hit.hit ? hit.distance + hit.normal.y : 0.0f;
+        }
+        sink = sum;
+    }));
+
+    results.push_back(measure("terrain/surface_grid", queryCount, options.runs, [&] {
+        float sum = 0.0f;
+        for (const Vector2& s : spots) {
+            float height;
+            Vector3 normal;
+            if (world.getTerrain().sampleSurface(s.x, s.y, height, normal)) sum += height + normal.y;
+        }
+        sink = sum;
+    }));
+
+    // 2. Prop transforms: half ground-aligned like fences, half upright like trees
+    const int propCount = 4096;
+    std::vector<Vector3> propNormals(propCount);
+    for (Vector3& n : propNormals) n = Vector3Normalize({ unit(rng) * 0.3f, 1.0f, unit(rng) * 0.3f });
+
+    results.push_back(measure("scene/prop_transform", propCount, options.runs, [&] {
+        float sum = 0.0f;
+        for (int i = 0; i < propCount; i++) {
+            Vector3 position = { spots[i].x, 0.0f, spots[i].y };
+            Matrix m = placementTransform(position, (float)i, { 1.5f, 1.5f, 1.5f }, propNormals[i], (i & 1) == 0);
+            sum += m.m0 + m.m12;
+        }
+        sink = sum;
+    }));
+
+    // 3. Walking through the forest: the player's horizontal sweep-and-slide
+    CharacterController controller;
+    const int walkers = 256, walkSteps = 16;
+    std::vector<Vector3> walkStart(walkers), walkDirection(walkers);
+    for (int i = 0; i < walkers; i++) {
+        walkStart[i] = { spots[i].x, heightAt(spots[i].x, spots[i].y), spots[i].y };
+        walkDirection[i] = Vector3Normalize({ unit(rng), 0.0f, unit(rng) });
+    }
+
+    results.push_back(measure("collision/walk_trees", walkers * walkSteps, options.runs, [&] {
+        float sum = 0.0f;
+        for (int i = 0; i < walkers; i++) {
+            Vector3 feet = walkStart[i];
+            for (int s = 0; s < walkSteps; s++) {
+                feet = controller.moveHorizontal(world, feet, 1.8f, Vector3Scale(walkDirection[i], 0.25f), true);
+            }
+            sum += feet.x + feet.z;
+        }
+        sink = sum;
+    }));
+
+    // 4. Balls dropped onto the map, a second of 60 Hz steps each
+    const int balls = 64, ballSteps = 60;
+    std::vector<Ball> ballStart(balls);
+    for (int i = 0; i < balls; i++) {
+        float x = spots[i].x, z = spots[i].y;
+        ballStart[i] = { { x, heightAt(x, z) + 5.0f, z }, { unit(rng) * 20.0f, -10.0f, unit(rng) * 20.0f }, 1.0f, 0.8f };
+    }
+
+    results.push_back(measure("physics/ball_step", balls * ballSteps, options.runs, [&] {
+        float sum = 0.0f;
+        for (const Ball& start : ballStart) {
+            Ball ball = start;
+            for (int s = 0; s < ballSteps; s++) ball.integrate(1.0f / 60.0f, world);
+            sum += ball.position.y;
+        }
+        sink = sum;
+    }));
+
+    // 5. Loading, with the upload: what a level load pays per asset.
+    // model_fence is the game's path; model_fence_raylib is LoadModel on the
+    // same file, the baseline ObjLoader has to beat.
+    const char* fencePath = "assets/objects/Farm Buildings - Sept 2018/OBJ/Fence.obj";
+    results.push_back(measure("load/model_fence", 1, options.runs, [&] {
+        Model model = ObjLoader::load(fencePath, jobs);
+        sink = (float)model.meshCount;
+        unloadAll(model);
+    }));
+
+    results.push_back(measure("load/model_fence_raylib", 1, options.runs, [&] {
+        Model model = LoadModel(fencePath);
+        sink = (float)model.meshCount;
+        unloadAll(model);
+    }));
+
+    results.push_back(measure("load/texture_grass", 1, options.runs, [] {
+        Texture2D texture = LoadTexture("assets/textures/grass.jpg");
+        sink = (float)texture.width;
+        UnloadTexture(texture);
+    }));
+
+    UnloadModel(map);
+    jobs.shutdown();
+    CloseWindow();
+
+    if (options.jsonPath) {
+        if (writeJson(options.jsonPath, results)) printf("\nWrote %s\n", options.jsonPath);
+        else printf("\nCouldn't write %s\n", options.jsonPath);
+    }
+
+    if (options.comparePath) {
+        std::vector<Result> baseline;
+        if (!readBaseline(options.comparePath, baseline)) {
+            printf("\nCouldn't read a baseline from %s\n", options.comparePath);
+            return 1;
+        }
+
+        int regressions = compare(results, baseline, options.threshold);
+        printf("\n%s: %d regression(s) over %.0f%%\n", regressions ? "FAIL" : "OK", regressions, options.threshold);
+        return regressions ? 1 : 0;
+    }
+    return 0;
+}
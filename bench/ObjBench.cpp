@@ -0,0 +1,189 @@
+// OBJ loading benchmark: raylib's LoadModel against ObjLoader on every .obj
+// under assets/, upload included, plus ObjLoader's parse on its own. Also
+// checks each pair of models has the same layout and the same vertices, and
+// that ObjLoader's number parsing agrees with strtof.
+//
+// tinyobj doesn't round its floats exactly, ObjLoader does, so positions may
+// differ in the last bit; anything more than a tiny fraction is a mismatch.
+//
+// Run from the repo root: build/bench/obj_bench [runs]
+
+#include "raylib.h"
+#include "rlgl.h"
+#include "JobSystem.hpp"
+#include "ObjLoader.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+static double nowMs() {
+    using namespace std::chrono;
+    return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+// Fastest of runs, loading is at the mercy of the page cache and the driver
+template <typename Fn>
+static double fastest(int runs, Fn fn) {
+    double best = 1e30;
+    for (int r = 0; r < runs; r++) {
+        double start = nowMs();
+        fn();
+        best = std::min(best, nowMs() - start);
+    }
+    return best;
+}
+
+// UnloadModel leaves material textures alone
+static void unloadAll(Model model) {
+    for (int m = 0; m < model.materialCount; m++) {
+        for (int map : { MATERIAL_MAP_DIFFUSE, MATERIAL_MAP_SPECULAR, MATERIAL_MAP_NORMAL, MATERIAL_MAP_HEIGHT }) {
+            Texture2D texture = model.materials[m].maps[map].texture;
+            if (texture.id > 0 && texture.id != rlGetTextureIdDefault()) UnloadTexture(texture);
+        }
+    }
+    UnloadModel(model);
+}
+
+static float maxDifference(const float* a, const float* b, int count) {
+    float worst = 0.0f;
+    if (count == 0) return 0.0f;
+    if (!a || !b) return (a == b) ? 0.0f : INFINITY;
+    for (int i = 0; i < count; i++) worst = fmaxf(worst, fabsf(a[i] - b[i]));
+    return worst;
+}
+
+// ObjLoader::parseFloat against strtof, bit for bit: the usual edge cases,
+// then numbers right next to the halfway points between floats, which is
+// where rounding through a double first goes wrong
+static int checkParseFloat() {
+    int failures = 0;
+    auto check = [&](const char* text) {
+        float ours = 0.0f;
+        const char* stop = ObjLoader::parseFloat(text, text + strlen(text), ours);
+        char* expectedStop = nullptr;
+        float expected = strtof(text, &expectedStop);
+        if (stop != expectedStop || memcmp(&ours, &expected, sizeof(float)) != 0) {
+            if (failures++ < 5) printf("parseFloat(\"%s\") = %.9g, strtof = %.9g\n", text, ours, expected);
+        }
+    };
+
+    const char* edges[] = {
+        "0", "-0", "-0.0", "+3", ".5", "5.", "-.5e1", "1e", "1e+", "1E-3", "0.000001", "123456.789012",
+        "16777216", "16777217", "16777217.0", "3.4028235e38", "3.4028236e38", "1e39", "1.17549435e-38",
+        "1e-45", "7e-46", "1.0000000596046448", "1.00000005960464477539", "0.30000001192092896"
+    };
+    for (const char* text : edges) check(text);
+
+    char text[64];
+    std::mt19937 rng(1);
+    for (int i = 0; i < 100000; i++) {
+        uint32_t bits = rng() & 0x7F7FFFFF;
+        float f;
+        memcpy(&f, &bits, sizeof(f));
+        double halfway = ((double)f + (double)nextafterf(f, INFINITY)) / 2.0;
+        snprintf(text, sizeof(text), "%.*g", 6 + i % 13, halfway);
+        check(text);
+    }
+    return failures;
+}
+
+// Same meshes, materials and colours, and how far apart the vertices are
+static bool sameLayout(const Model& a, const Model& b, float& difference) {
+    difference = 0.0f;
+    if (a.meshCount != b.meshCount || a.materialCount != b.materialCount) return false;
+
+    for (int i = 0; i < a.meshCount; i++) {
+        const Mesh& ma = a.meshes[i];
+        const Mesh& mb = b.meshes[i];
+        if (ma.vertexCount != mb.vertexCount || ma.triangleCount != mb.triangleCount || a.meshMaterial[i] != b.meshMaterial[i]) return false;
+        if ((ma.indices != nullptr) != (mb.indices != nullptr)) return false;
+
+        difference = fmaxf(difference, maxDifference(ma.vertices, mb.vertices, ma.vertexCount * 3));
+        difference = fmaxf(difference, maxDifference(ma.texcoords, mb.texcoords, ma.vertexCount * 2));
+        difference = fmaxf(difference, maxDifference(ma.normals, mb.normals, ma.vertexCount * 3));
+    }
+    for (int m = 0; m < a.materialCount; m++) {
+        Color ca = a.materials[m].maps[MATERIAL_MAP_DIFFUSE].color;
+        Color cb = b.materials[m].maps[MATERIAL_MAP_DIFFUSE].color;
+        if (ca.r != cb.r || ca.g != cb.g || ca.b != cb.b || ca.a != cb.a) return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    int runs = (argc > 1) ? atoi(argv[1]) : 3;
+    if (runs <= 0) runs = 3;
+
+    // Both upload to the GPU, so they need a (hidden) GL context
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    SetTraceLogLevel(LOG_WARNING);
+    InitWindow(64, 64, "obj_bench");
+
+    int parseFailures = checkParseFloat();
+    printf("parseFloat: %s against strtof\n", parseFailures ? "MISMATCH" : "matches");
+
+    JobSystem jobs;
+    jobs.init();
+
+    std::vector<std::string> files;
+    std::error_code error;
+    for (auto it = std::filesystem::recursive_directory_iterator("assets", error); !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error)) {
+        if (it->is_regular_file() && it->path().extension() == ".obj") files.push_back(it->path().generic_string());
+    }
+    std::sort(files.begin(), files.end());
+    if (files.empty()) {
+        printf("No .obj files under assets/ (run from the repo root)\n");
+        CloseWindow();
+        return 1;
+    }
+
+    printf("%d files, %d workers, fastest of %d runs\n\n", (int)files.size(), jobs.getWorkerCount(), runs);
+    printf("%-40s %8s %10s %10s %10s %8s\n", "", "tris", "LoadModel", "ObjLoader", "parse", "speedup");
+
+    double totalRaylib = 0.0, totalOurs = 0.0, totalParse = 0.0;
+    int mismatches = 0;
+    for (const std::string& file : files) {
+        // 1. Both loaders, the whole way to the GPU
+        double raylibMs = fastest(runs, [&] { unloadAll(LoadModel(file.c_str())); });
+        double oursMs = fastest(runs, [&] { unloadAll(ObjLoader::load(file.c_str(), jobs)); });
+
+        // 2. ObjLoader's share that runs on the workers
+        int triangles = 0;
+        double parseMs = fastest(runs, [&] {
+            ObjLoader::Data data;
+            ObjLoader::parse(file.c_str(), jobs, data);
+            triangles = data.triangles;
+        });
+
+        // 3. Same model either way
+        Model expected = LoadModel(file.c_str());
+        Model model = ObjLoader::load(file.c_str(), jobs);
+        float difference = 0.0f;
+        bool same = sameLayout(expected, model, difference) && difference <= 1e-4f;
+        mismatches += !same;
+        unloadAll(expected);
+        unloadAll(model);
+
+        std::string name = std::filesystem::path(file).filename().string();
+        printf("%-40s %8d %8.2f ms %8.2f ms %8.2f ms %7.1fx%s\n", name.c_str(), triangles, raylibMs, oursMs, parseMs,
+               raylibMs / oursMs, same ? "" : "  MISMATCH");
+
+        totalRaylib += raylibMs;
+        totalOurs += oursMs;
+        totalParse += parseMs;
+    }
+
+    printf("\n%-40s %8s %8.2f ms %8.2f ms %8.2f ms %7.1fx\n", "total", "", totalRaylib, totalOurs, totalParse, totalRaylib / totalOurs);
+    printf("%s: %d mismatching models, %d mismatching floats\n", (mismatches || parseFailures) ? "FAIL" : "OK", mismatches, parseFailures);
+
+    jobs.shutdown();
+    CloseWindow();
+    return (mismatches || parseFailures) ? 1 : 0;
+}
@@ -0,0 +1,108 @@
+// Ray vs terrain benchmark: raylib's GetRayCollisionMesh against RayMesh on
+// Towers.obj, every ISA the CPU has, single rays and packets. Also checks
+// every result is bit-identical to raylib's.
+//
+// Run from the repo root: build/bench/ray_bench [rayCount]
+
+#include "raylib.h"
+#include "raymath.h"
+#include "RayMesh.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+static double nowMs() {
+    using namespace std::chrono;
+    return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+static bool sameBits(const RayCollision& a, const RayCollision& b) {
+    if (a.hit != b.hit) return false;
+    if (!a.hit) return true;
+    return memcmp(&a.distance, &b.distance, sizeof(float)) == 0 &&
+           memcmp(&a.point, &b.point, sizeof(Vector3)) == 0 &&
+           memcmp(&a.normal, &b.normal, sizeof(Vector3)) == 0;
+}
+
+static void report(const char* name, double ms, int rays, double baselineMs) {
+    printf("%-28s %10.2f ms %10.2f us/ray %8.1fx\n", name, ms, ms * 1000.0 / rays, baselineMs / ms);
+}
+
+int main(int argc, char** argv) {
+    int rayCount = (argc > 1) ? atoi(argv[1]) : 2000;
+    if (rayCount <= 0) rayCount = 2000;
+
+    // LoadModel uploads to the GPU, so it needs a (hidden) GL context
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    SetTraceLogLevel(LOG_WARNING);
+    InitWindow(64, 64, "ray_bench");
+
+    Model map = LoadModel("assets/maps/Towers/Towers.obj");
+    if (map.meshCount == 0) {
+        printf("Couldn't load assets/maps/Towers/Towers.obj (run from the repo root)\n");
+        CloseWindow();
+        return 1;
+    }
+    const Mesh& mesh = map.meshes[0];
+
+    double buildStart = nowMs();
+    RayMesh rayMesh;
+    rayMesh.build(mesh, map.transform);
+    double buildMs = nowMs() - buildStart;
+
+    // Half straight-down height probes, half arbitrary rays
+    BoundingBox bounds = GetMeshBoundingBox(mesh);
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> rx(bounds.min.x, bounds.max.x);
+    std::uniform_real_distribution<float> rz(bounds.min.z, bounds.max.z);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    std::vector<Ray> rays(rayCount);
+    for (int i = 0; i < rayCount; i++) {
+        if (i % 2 == 0) {
+            rays[i] = { { rx(rng), 1000.0f, rz(rng) }, { 0, -1, 0 } };
+        } else {
+            Vector3 dir = Vector3Normalize({ unit(rng), -fabsf(unit(rng)) - 0.1f, unit(rng) });
+            rays[i] = { { rx(rng), bounds.max.y + 10.0f, rz(rng) }, dir };
+        }
+    }
+
+    printf("Towers.obj: %d triangles, %d rays, RayMesh build %.2f ms\n\n", mesh.triangleCount, rayCount, buildMs);
+
+    // 1. Baseline
+    std::vector<RayCollision> expected(rayCount);
+    double start = nowMs();
+    for (int i = 0; i < rayCount; i++) expected[i] = GetRayCollisionMesh(rays[i], mesh, map.transform);
+    double baselineMs = nowMs() - start;
+    report("GetRayCollisionMesh", baselineMs, rayCount, baselineMs);
+
+    // 2. Every kernel the CPU supports, one ray at a time and as packets
+    int mismatches = 0;
+    std::vector<RayCollision> results(rayCount);
+    for (int level = 0; level <= (int)RayMesh::detectIsa(); level++) {
+        rayMesh.setIsa((RayMesh::Isa)level);
+        char name[64];
+
+        start = nowMs();
+        for (int i = 0; i < rayCount; i++) results[i] = rayMesh.cast(rays[i]);
+        snprintf(name, sizeof(name), "%s", RayMesh::isaName(rayMesh.getIsa()));
+        report(name, nowMs() - start, rayCount, baselineMs);
+        for (int i = 0; i < rayCount; i++) mismatches += !sameBits(expected[i], results[i]);
+
+        start = nowMs();
+        rayMesh.castPacket(rays.data(), rayCount, results.data());
+        snprintf(name, sizeof(name), "  packets of %d", RayMesh::maxPacket);
+        report(name, nowMs() - start, rayCount, baselineMs);
+        for (int i = 0; i < rayCount; i++) mismatches += !sameBits(expected[i], results[i]);
+    }
+
+    printf("\n%s: %d mismatching results\n", mismatches ? "FAIL" : "OK", mismatches);
+
+    UnloadModel(map);
+    CloseWindow();
+    return mismatches ? 1 : 0;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// On-disk cache for things we bake at load time (navmesh, ...). Each entry is
+// one file holding a key; if the key doesn't match what the caller computed
+// from its inputs, the entry is stale and gets rebuilt.
+class AssetCache {
+    public:
+        explicit AssetCache(const std::string& directory = "cache") : directory(directory) {}
+
+        // True and fills data if the entry exists and was baked from the same key
+        bool load(const std::string& name, uint64_t key, std::vector<uint8_t>& data) const;
+
+        // Writes to a temp file first, so a crash never leaves a half entry
+        bool store(const std::string& name, uint64_t key, const std::vector<uint8_t>& data) const;
+
+        // FNV-1a, chain calls through seed to hash several inputs
+        static uint64_t hash(const void* data, size_t size, uint64_t seed = 14695981039346656037ull);
+
+        template <typename T>
+        static uint64_t hashValue(const T& value, uint64_t seed) { return hash(&value, sizeof(T), seed); }
+
+    private:
+        std::string pathFor(const std::string& name) const;
+
+        std::string directory;
+};
+
+// Little helpers for (de)serialising plain data into a cache entry
+class CacheWriter {
+    public:
+        template <typename T>
+        void put(const T& value) {
+            const uint8_t* p = (const uint8_t*)&value;
+            bytes.insert(bytes.end(), p, p + sizeof(T));
+        }
+
+        template <typename T>
+        void putArray(const std::vector<T>& values) {
+            put((uint64_t)values.size());
+            const uint8_t* p = (const uint8_t*)values.data();
+            bytes.insert(bytes.end(), p, p + values.size() * sizeof(T));
+        }
+
+        std::vector<uint8_t> bytes;
+};
+
+class CacheReader {
+    public:
+        explicit CacheReader(const std::vector<uint8_t>& bytes) : bytes(bytes) {}
+
+        template <typename T>
+        bool get(T& value) {
+            if (offset + sizeof(T) > bytes.size()) return false;
+            memcpy(&value, bytes.data() + offset, sizeof(T));
+            offset += sizeof(T);
+            return true;
+        }
+
+        template <typename T>
+        bool getArray(std::vector<T>& values) {
+            uint64_t count = 0;
+            if (!get(count) || count > (bytes.size() - offset) / sizeof(T)) return false;
+            values.resize((size_t)count);
+            memcpy(values.data(), bytes.data() + offset, (size_t)count * sizeof(T));
+            offset += (size_t)count * sizeof(T);
+            return true;
+        }
+
+        bool atEnd() const { return offset == bytes.size(); }
+
+    private:
+        const std::vector<uint8_t>& bytes;
+        size_t offset = 0;
+};
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "raylib.h"
+#include "Collision.hpp"
+
+// The kickable ball. integrate() is the physics step on its own (gravity,
+// drag, and a swept bounce off terrain and props), so it runs without a Game.
+struct Ball {
+    Vector3 position;
+    Vector3 velocity;
+    float radius;
+    float restitution; // Bounciness (0.0 to 1.0)
+
+    void integrate(float deltaTime, const CollisionWorld& world);
+};
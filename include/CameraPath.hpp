@@ -0,0 +1,43 @@
+#pragma once
+
+#include "raylib.h"
+#include <vector>
+
+// A camera flight through a list of keys, smoothed with a Catmull-Rom
+// spline. Each segment gets time in proportion to its length, so the camera
+// keeps a steady speed however the keys are spaced.
+//
+// Text format, one key per line ('#' starts a comment):
+//     x y z yaw pitch
+// with yaw and pitch in degrees, same convention as the game's mouse look.
+class CameraPath {
+    public:
+        struct Key {
+            Vector3 position;
+            float yaw;
+            float pitch;
+        };
+
+        float speed = 90.0f;            // Metres per second, creative-mode flying pace. Set before adding keys.
+
+        bool load(const char* path);
+        bool save(const char* path) const;
+
+        // Yaw is unwrapped against the previous key, so the camera always
+        // turns the short way round
+        void add(Key key);
+        void clear();
+
+        int size() const { return (int)keys.size(); }
+        bool empty() const { return keys.empty(); }
+
+        // Seconds from the first key to the last
+        float getDuration() const { return startTimes.empty() ? 0.0f : startTimes.back(); }
+
+        // Clamped to the ends
+        Key sample(float time) const;
+
+    private:
+        std::vector<Key> keys;
+        std::vector<float> startTimes;  // When the camera passes each key
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "raylib.h"
+#include "Collision.hpp"
+
+// Capsule character controller. The capsule stands on its feet position and
+// reaches up to feet + height. Every query goes through the CollisionWorld
+// grids, so the cost per move depends on what's nearby, not the prop count.
+class CharacterController {
+    public:
+        struct Settings {
+            float radius = 0.4f;
+            float stepHeight = 0.5f;    // Ledges lower than this are stepped onto
+            float slopeLimit = 0.65f;   // Ground normal.y below this is too steep to stand on
+            float snapDistance = 0.25f; // How close to floor before we stick
+            float skin = 0.01f;         // Gap kept between the capsule and surfaces
+            int maxSlides = 4;
+        };
+
+        struct GroundInfo {
+            bool hit = false;
+            bool walkable = false;
+            float distance = 0.0f;
+            Vector3 normal = { 0, 1, 0 };
+        };
+
+        Settings settings;
+
+        // Earliest hit of the capsule moving by motion. Swept as a stack of
+        // spheres no more than one radius apart along the capsule's axis.
+        bool sweep(const CollisionWorld& world, Vector3 feet, float height, Vector3 motion, SweepHit& hit) const;
+
+        // Horizontal walk with sweep-and-slide. Walls and too-steep slopes
+        // block (we never get lifted up them), walkable slopes are climbed,
+        // and when grounded, ledges up to stepHeight are stepped onto.
+        Vector3 moveHorizontal(const CollisionWorld& world, Vector3 feet, float height, Vector3 displacement, bool grounded) const;
+
+        // Vertical move (gravity/jumps). Returns where the capsule stopped.
+        Vector3 moveVertical(const CollisionWorld& world, Vector3 feet, float height, float dy, SweepHit& hit, bool& blocked) const;
+
+        // Look for ground within snapDistance below the feet
+        GroundInfo probeGround(const CollisionWorld& world, Vector3 feet, float height) const;
+
+        // Can the capsule grow from height to newHeight without hitting a ceiling?
+        bool canGrow(const CollisionWorld& world, Vector3 feet, float height, float newHeight) const;
+
+    private:
+        Vector3 slide(const CollisionWorld& world, Vector3 feet, float height, Vector3 motion) const;
+};
@@ -0,0 +1,225 @@
+#pragma once
+
+#include "raylib.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Result of a sweep: the shape first touches something at start + motion * t
+struct SweepHit {
+    float t = 1.0f;         // Time of impact, 0..1 along the motion
+    Vector3 point;          // Contact point on the surface
+    Vector3 normal;         // Surface normal at the contact, facing the mover
+};
+
+// Swept sphere vs one triangle (Fauerby, "Improved Collision detection and
+// Response"). Tests the face, then the three vertices and edges, and keeps
+// the earliest contact. Returns true only if it's earlier than hit.t.
+bool sweepSphereTriangle(Vector3 start, Vector3 motion, float radius,
+                         Vector3 a, Vector3 b, Vector3 c, SweepHit& hit);
+
+// Terrain as heights on a regular XZ grid (generated maps). Every quad is
+// split along its (x, z)-(x+1, z+1) diagonal, same as the render meshes.
+struct Heightfield {
+    Vector2 origin = { 0, 0 };      // World XZ of sample (0, 0)
+    float spacing = 1.0f;
+    int samplesX = 0;
+    int samplesZ = 0;
+    std::vector<float> heights;     // Row by row along x
+
+    Vector3 vertex(int x, int z) const {
+        return { origin.x + x * spacing, heights[(size_t)z * samplesX + x], origin.y + z * spacing };
+    }
+};
+
+// Terrain triangles bucketed into a uniform XZ grid, so a query only touches
+// the handful of triangles near it instead of all 35k in Towers.obj. A
+// heightfield needs no buckets, its triangles are made on the fly.
+class TerrainCollider {
+    public:
+        void build(const Mesh& mesh, const Matrix& transform, float cellSize = 8.0f);
+        void build(Heightfield heightfield);
+
+        bool sweepSphere(Vector3 start, Vector3 motion, float radius, SweepHit& hit) const;
+
+        // Highest surface straight below x,z (what a ray cast down from the sky
+        // hits first) and its upward-facing normal. Only tests that grid cell.
+        bool sampleSurface(float x, float z, float& height, Vector3& normal) const;
+
+        // Calls fn(a, b, c) once for every triangle whose XZ bounds overlap the box
+        template <typename Fn>
+        void forEachTriangle(float minX, float minZ, float maxX, float maxZ, Fn fn) const;
+
+        bool isBuilt() const { return !triangles.empty() || !field.heights.empty(); }
+        BoundingBox getBounds() const { return bounds; }
+
+        // RAM held by the collision copy
+        size_t getMemoryBytes() const;
+
+    private:
+        // Mesh terrain is kept welded and quantised to 16 bits per axis over
+        // the bounds (about 1.5cm steps across a 1km map): 6 bytes a vertex
+        // and 16 a triangle, where float triangles took 40
+        struct Triangle {
+            uint32_t v[3];                // Into vertices
+            int16_t minCellX, minCellZ;   // First cell the triangle lives in (for de-duplication)
+        };
+
+        Vector3 vertex(uint32_t i) const {
+            const uint16_t* q = &vertices[(size_t)i * 3];
+            return { bounds.min.x + q[0] * quantStep.x, bounds.min.y + q[1] * quantStep.y, bounds.min.z + q[2] * quantStep.z };
+        }
+
+        int cellX(float x) const;
+        int cellZ(float z) const;
+
+        std::vector<uint16_t> vertices;   // x, y, z per vertex
+        Vector3 quantStep = { 1, 1, 1 };
+        std::vector<Triangle> triangles;
+        std::vector<uint32_t> cellStart;  // Prefix offsets into cellTriangles, one per cell + 1
+        std::vector<uint32_t> cellTriangles;
+
+        Heightfield field;
+
+        BoundingBox bounds = {};
+        float cellSize = 8.0f;
+        int cellsX = 0;
+        int cellsZ = 0;
+};
+
+// Collider for a static prop
+struct StaticCollider {
+    enum Shape { Box, Cylinder } shape;
+
+    // Box: oriented box
+    Vector3 center;
+    Vector3 axes[3];
+    Vector3 halfExtents;
+
+    // Cylinder: vertical, base at center.y
+    float radius;
+    float height;
+
+    BoundingBox bounds;     // World AABB for the broadphase
+};
+
+// Everything the ball and the player can bump into
+class CollisionWorld {
+    public:
+        void buildTerrain(const Mesh& mesh, const Matrix& transform);
+        void buildTerrain(Heightfield heightfield);
+
+        // A model's local bounding box placed with its world transform
+        void addBox(const BoundingBox& localBounds, const Matrix& transform);
+        void addCylinder(Vector3 base, float radius, float height);
+
+        // Rebuild the prop grid. Call once after adding colliders.
+        void buildBroadphase(float cellSize = 16.0f);
+
+        // Earliest hit of a moving sphere against terrain and props
+        bool sweepSphere(Vector3 start, Vector3 motion, float radius, SweepHit& hit) const;
+
+        const TerrainCollider& getTerrain() const { return terrain; }
+        const std::vector<StaticCollider>& getColliders() const { return colliders; }
+
+        // Calls fn(collider) for every prop whose AABB overlaps the box (once each)
+        template <typename Fn>
+        void forEachCollider(Vector3 min, Vector3 max, Fn fn) const;
+
+    private:
+        TerrainCollider terrain;
+        std::vector<StaticCollider> colliders;
+
+        // Broadphase grid over XZ, same layout as the terrain one
+        std::vector<uint32_t> cellStart;
+        std::vector<uint32_t> cellColliders;
+        Vector2 gridOrigin = { 0, 0 };
+        float gridCellSize = 16.0f;
+        int cellsX = 0;
+        int cellsZ = 0;
+};
+
+bool sweepSphereCollider(Vector3 start, Vector3 motion, float radius, const StaticCollider& c, SweepHit& hit);
+
+// --- Template implementations ---
+
+template <typename Fn>
+void TerrainCollider::forEachTriangle(float minX, float minZ, float maxX, float maxZ, Fn fn) const {
+    // Heightfield: the two triangles of every quad under the box
+    if (!field.heights.empty()) {
+        float lastX = (float)(field.samplesX - 2), lastZ = (float)(field.samplesZ - 2);
+        int x0 = (int)std::clamp(floorf((minX - field.origin.x) / field.spacing), 0.0f, lastX);
+        int x1 = (int)std::clamp(floorf((maxX - field.origin.x) / field.spacing), 0.0f, lastX);
+        int z0 = (int)std::clamp(floorf((minZ - field.origin.y) / field.spacing), 0.0f, lastZ);
+        int z1 = (int)std::clamp(floorf((maxZ - field.origin.y) / field.spacing), 0.0f, lastZ);
+
+        for (int z = z0; z <= z1; z++) {
+            for (int x = x0; x <= x1; x++) {
+                Vector3 p00 = field.vertex(x, z), p10 = field.vertex(x + 1, z);
+                Vector3 p01 = field.vertex(x, z + 1), p11 = field.vertex(x + 1, z + 1);
+                fn(p00, p01, p11);
+                fn(p00, p11, p10);
+            }
+        }
+        return;
+    }
+
+    if (triangles.empty()) return;
+
+    int x0 = cellX(minX), x1 = cellX(maxX);
+    int z0 = cellZ(minZ), z1 = cellZ(maxZ);
+
+    for (int cz = z0; cz <= z1; cz++) {
+        for (int cx = x0; cx <= x1; cx++) {
+            int cell = cz * cellsX + cx;
+            for (uint32_t i = cellStart[cell]; i < cellStart[cell + 1]; i++) {
+                const Triangle& tri = triangles[cellTriangles[i]];
+
+                // A triangle spanning several cells is only reported from the
+                // first cell both it and the query cover, no visited set needed
+                int firstX = tri.minCellX > x0 ? tri.minCellX : x0;
+                int firstZ = tri.minCellZ > z0 ? tri.minCellZ : z0;
+                if (cx != firstX || cz != firstZ) continue;
+
+                fn(vertex(tri.v[0]), vertex(tri.v[1]), vertex(tri.v[2]));
+            }
+        }
+    }
+}
+
+template <typename Fn>
+void CollisionWorld::forEachCollider(Vector3 min, Vector3 max, Fn fn) const {
+    if (colliders.empty() || cellsX == 0) return;
+
+    auto toCell = [this](float v, float origin, int count) {
+        int c = (int)((v - origin) / gridCellSize);
+        return c < 0 ? 0 : (c >= count ? count - 1 : c);
+    };
+
+    int x0 = toCell(min.x, gridOrigin.x, cellsX), x1 = toCell(max.x, gridOrigin.x, cellsX);
+    int z0 = toCell(min.z, gridOrigin.y, cellsZ), z1 = toCell(max.z, gridOrigin.y, cellsZ);
+
+    for (int cz = z0; cz <= z1; cz++) {
+        for (int cx = x0; cx <= x1; cx++) {
+            int cell = cz * cellsX + cx;
+            for (uint32_t i = cellStart[cell]; i < cellStart[cell + 1]; i++) {
+                const StaticCollider& c = colliders[cellColliders[i]];
+
+                // Same first-shared-cell trick as the terrain grid
+                int firstX = toCell(c.bounds.min.x, gridOrigin.x, cellsX);
+                int firstZ = toCell(c.bounds.min.z, gridOrigin.y, cellsZ);
+                if (firstX < x0) firstX = x0;
+                if (firstZ < z0) firstZ = z0;
+                if (cx != firstX || cz != firstZ) continue;
+
+                if (c.bounds.max.x < min.x || c.bounds.min.x > max.x) continue;
+                if (c.bounds.max.y < min.y || c.bounds.min.y > max.y) continue;
+                if (c.bounds.max.z < min.z || c.bounds.min.z > max.z) continue;
+
+                fn(c);
+            }
+        }
+    }
+}
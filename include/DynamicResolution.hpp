@@ -0,0 +1,60 @@
+#pragma once
+
+#include "raylib.h"
+#include "GpuTimer.hpp"
+
+// Renders the 3D pass into an off-screen target whose resolution follows the
+// measured GPU time, then stretches it over the backbuffer so the 2D UI can
+// still be drawn at native resolution on top.
+//
+// The target is allocated once at native size and we only render into the
+// bottom-left scale*width x scale*height corner of it, so changing the scale
+// never reallocates anything.
+class DynamicResolution {
+    public:
+        struct Settings {
+            float minScale = 0.5f;
+            float maxScale = 1.0f;
+            float targetMs = 14.0f;     // GPU budget for the 3D pass (leaves room under 16.6ms)
+            float step = 0.05f;         // Scale changes snap to this so the image doesn't shimmer
+            int adjustInterval = 15;    // Frames between adjustments
+        };
+
+        ~DynamicResolution();
+
+        void init(const Settings& settings);
+        void shutdown();
+
+        // Wraps the 3D pass. Call outside BeginDrawing/EndDrawing.
+        void beginScene();
+        void endScene();
+
+        // Upscale the last scene to the backbuffer. Call inside BeginDrawing.
+        void present();
+
+        // Read back GPU timings and pick the scale for next frame.
+        // Without timer queries the scale just stays at maxScale.
+        void update();
+
+        float getScale() const { return scale; }
+        float getGpuMs() const { return smoothedMs; }
+        float getLastGpuMs() const { return timer.getLastMs(); }
+        int getWidth() const { return viewWidth; }
+        int getHeight() const { return viewHeight; }
+
+    private:
+        void allocate(int width, int height);
+
+        Settings settings;
+        RenderTexture2D target = {};
+        GpuTimer timer;
+
+        int nativeWidth = 0;
+        int nativeHeight = 0;
+        int viewWidth = 0;
+        int viewHeight = 0;
+
+        float scale = 1.0f;
+        float smoothedMs = 0.0f;
+        int framesSinceAdjust = 0;
+};
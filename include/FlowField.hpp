@@ -0,0 +1,70 @@
+#pragma once
+
+#include "raylib.h"
+#include "NavMesh.hpp"
+#include "JobSystem.hpp"
+#include <cstdint>
+#include <vector>
+
+// Flow field toward one target (the player) over a coarse grid of the map.
+//
+// Every cell stores the direction of its cheapest neighbour on the way to the
+// target, so any number of agents can find their way with a single lookup.
+// Walkability and slopes come from the navmesh, i.e. the same 0.65 slope limit
+// as the player. The build is time sliced: when the target moves to another
+// cell a new field starts growing a budget of cells per update, and agents
+// keep using the previous field until the new one is complete.
+class FlowField {
+    public:
+        struct Settings {
+            float cellSize = 2.0f;
+            int budget = 65536;     // Cells settled per update()
+        };
+
+        Settings settings;
+
+        // Sets up the grid (passability, heights, slope links) from the navmesh
+        void init(const NavMesh& nav, JobSystem& jobs);
+
+        // Restarts the build if target moved to another cell, then advances it
+        void update(Vector3 target, JobSystem& jobs);
+
+        // Unit XZ direction to walk from here, zero if there's no route
+        Vector2 sample(float x, float z) const;
+
+        // Can an agent stand in the cell at x,z?
+        bool isPassable(float x, float z) const;
+
+        bool isReady() const { return ready; }
+        bool isBuilding() const { return building; }
+        Vector3 getTarget() const { return readyTarget; }
+
+    private:
+        enum { Unreached = 0xFFFFFFFFu };
+
+        int cellIndex(float x, float z) const;
+        void finishBuild(JobSystem& jobs);
+
+        Vector2 origin = { 0, 0 };
+        int cellsX = 0;
+        int cellsZ = 0;
+
+        std::vector<uint8_t> passable;
+        std::vector<uint8_t> neighbours;    // Bit n set: can step to neighbour n
+        std::vector<float> heights;
+
+        // Build in progress: integrated cost per cell and a Dial bucket queue
+        // (straight steps cost 10, diagonals 14, so 15 buckets wrap around)
+        std::vector<uint32_t> cost;
+        std::vector<int32_t> buckets[15];
+        uint32_t currentCost = 0;
+        int pendingCells = 0;
+        int targetCell = -1;
+        Vector3 buildTarget = { 0, 0, 0 };
+        bool building = false;
+
+        // Finished field, what sample() reads
+        std::vector<float> dirX, dirZ;
+        Vector3 readyTarget = { 0, 0, 0 };
+        bool ready = false;
+};
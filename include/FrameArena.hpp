@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+// Bump allocator for data that lives exactly one frame.
+//
+// allocate() just moves an offset forward and reset() moves it back, so a
+// frame's worth of lists costs no heap traffic at all. Nothing is destructed,
+// hence the trivially destructible types only. A frame that outgrows the
+// block still works: the excess comes from the heap, and the next reset()
+// replaces the block with one big enough for that frame.
+class FrameArena {
+    public:
+        FrameArena() = default;
+        ~FrameArena();
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        void init(size_t capacity);
+        void shutdown();
+
+        void* allocate(size_t size, size_t align = alignof(std::max_align_t));
+
+        // Uninitialised room for count objects
+        template <typename T>
+        T* allocate(size_t count);
+
+        // Everything allocated since the last reset is gone
+        void reset();
+
+        size_t getUsed() const { return used + overflowBytes; }
+        size_t getPeak() const { return peak; }
+        size_t getCapacity() const { return capacity; }
+
+    private:
+        // Heap blocks for whatever didn't fit, chained through their headers
+        struct Overflow {
+            Overflow* next;
+        };
+
+        bool releaseOverflow();
+
+        unsigned char* block = nullptr;
+        size_t capacity = 0;
+        size_t used = 0;
+
+        Overflow* overflow = nullptr;
+        size_t overflowBytes = 0;
+        size_t peak = 0;
+};
+
+// Fixed-capacity list in arena memory, for per-frame results with a known
+// upper bound (visible objects, agents in view and so on)
+template <typename T>
+class FrameList {
+    public:
+        static_assert(std::is_trivially_destructible<T>::value, "FrameList never runs destructors");
+
+        FrameList() = default;
+        FrameList(FrameArena& arena, size_t maxCount)
+            : items(arena.allocate<T>(maxCount)), count(0), maxCount(maxCount) {}
+
+        void push_back(const T& item) {
+            assert(count < maxCount && "FrameList is full");
+            items[count++] = item;
+        }
+
+        void clear() { count = 0; }
+
+        T* begin() { return items; }
+        T* end() { return items + count; }
+        const T* begin() const { return items; }
+        const T* end() const { return items + count; }
+
+        T& operator[](size_t i) { return items[i]; }
+        const T& operator[](size_t i) const { return items[i]; }
+
+        size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+
+    private:
+        T* items = nullptr;
+        size_t count = 0;
+        size_t maxCount = 0;
+};
+
+// --- Template implementations ---
+
+template <typename T>
+T* FrameArena::allocate(size_t count) {
+    static_assert(std::is_trivially_destructible<T>::value, "FrameArena never runs destructors");
+    return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+}
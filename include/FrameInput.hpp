@@ -0,0 +1,36 @@
+#pragma once
+
+#include "raylib.h"
+#include <cstdint>
+
+// Keys the simulation cares about, packed into a bitmask so a whole frame of
+// input is a few bytes that can be handed to another thread (or saved to disk).
+enum InputKey : uint16_t {
+    INPUT_FORWARD   = 1 << 0,   // W
+    INPUT_BACK      = 1 << 1,   // S
+    INPUT_LEFT      = 1 << 2,   // A
+    INPUT_RIGHT     = 1 << 3,   // D
+    INPUT_JUMP      = 1 << 4,   // Space
+    INPUT_DESCEND   = 1 << 5,   // Left Control (creative mode)
+    INPUT_CROUCH    = 1 << 6,   // C
+    INPUT_SPRINT    = 1 << 7,   // Left Shift
+    INPUT_CREATIVE  = 1 << 8    // G
+};
+
+// Everything processEvents() reads for one simulated frame.
+// Sampled on the main thread since raylib's input functions aren't thread safe.
+struct FrameInput {
+    float deltaTime = 0.0f;
+    Vector2 mouseDelta = { 0, 0 };
+    uint16_t keysDown = 0;      // Held this frame
+    uint16_t keysPressed = 0;   // Went down this frame
+
+    bool playing = false;       // False while the pause menu is open
+    float sensitivity = 0.0f;   // Copied so the sim never reads menu state
+
+    bool isDown(InputKey key) const { return (keysDown & key) != 0; }
+    bool isPressed(InputKey key) const { return (keysPressed & key) != 0; }
+};
+
+// Poll raylib for the current frame's input
+FrameInput sampleFrameInput(float deltaTime);
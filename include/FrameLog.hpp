@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Every frame's timings during a benchmark run, written out as CSV and
+// summarised as percentiles at the end. Averages hide stutters, the tail
+// of the distribution is what this is for.
+class FrameLog {
+    public:
+        struct Frame {
+            float frameMs;      // Wall time, loop top to loop top
+            float mainMs;       // Main thread: scene submission and drawing
+            float simMs;        // Simulation thread
+            float gpuMs;        // 3D + 2D timer queries (a few frames late)
+            int drawCalls;      // 3D pass
+            int triangles;
+        };
+
+        // Room for the whole run, so logging doesn't allocate mid-run
+        void reserve(size_t frameCount) { frames.reserve(frameCount); }
+        void add(const Frame& frame) { frames.push_back(frame); }
+        size_t size() const { return frames.size(); }
+
+        bool writeCsv(const char* path) const;
+
+        // p50/p95/p99/max of every timing, hitch counts, draw call and triangle ranges
+        void logSummary(const char* label) const;
+
+    private:
+        std::vector<Frame> frames;
+};
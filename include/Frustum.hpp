@@ -0,0 +1,13 @@
+#pragma once
+
+#include "raylib.h"
+
+// View frustum as 6 planes (xyz = normal pointing inwards, w = distance)
+struct Frustum {
+    Vector4 planes[6];
+
+    // Matches the projection BeginMode3D sets up for a perspective camera
+    static Frustum fromCamera(const Camera3D& camera, float aspect, float nearPlane = 0.01f, float farPlane = 1000.0f);
+
+    bool containsSphere(Vector3 center, float radius) const;
+};
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+
+// The few OpenGL entry points raylib doesn't wrap for us. They're resolved at
+// runtime through rlGetProcAddress() after InitWindow, so nothing here needs
+// its own GL loader. Every pointer may be null on drivers that lack the feature.
+namespace GLExt {
+    const unsigned int TIME_ELAPSED = 0x88BF;
+    const unsigned int QUERY_RESULT = 0x8866;
+    const unsigned int QUERY_RESULT_AVAILABLE = 0x8867;
+
+    const unsigned int SHORT = 0x1402;
+    const unsigned int UNSIGNED_SHORT = 0x1403;
+    const unsigned int HALF_FLOAT = 0x140B;
+
+    const unsigned int VENDOR = 0x1F00;
+    const unsigned int RENDERER = 0x1F01;
+    const unsigned int VERSION = 0x1F02;
+    const unsigned int EXTENSIONS = 0x1F03;
+    const unsigned int NUM_EXTENSIONS = 0x821D;
+
+    const unsigned int FRAGMENT_SHADER = 0x8B30;
+    const unsigned int VERTEX_SHADER = 0x8B31;
+    const unsigned int COMPILE_STATUS = 0x8B81;
+    const unsigned int LINK_STATUS = 0x8B82;
+    const unsigned int PROGRAM_BINARY_RETRIEVABLE_HINT = 0x8257;
+    const unsigned int PROGRAM_BINARY_LENGTH = 0x8741;
+    const unsigned int NUM_PROGRAM_BINARY_FORMATS = 0x87FE;
+
+    typedef void (*GenQueriesProc)(int n, unsigned int* ids);
+    typedef void (*DeleteQueriesProc)(int n, const unsigned int* ids);
+    typedef void (*BeginQueryProc)(unsigned int target, unsigned int id);
+    typedef void (*EndQueryProc)(unsigned int target);
+    typedef void (*GetQueryObjectivProc)(unsigned int id, unsigned int pname, int* params);
+    typedef void (*GetQueryObjectui64vProc)(unsigned int id, unsigned int pname, uint64_t* params);
+
+    // rlSetVertexAttribute() wraps this, but its last argument changed from a
+    // pointer to an int offset between raylib versions
+    typedef void (*VertexAttribPointerProc)(unsigned int index, int size, unsigned int type, unsigned char normalized,
+                                            int stride, const void* pointer);
+
+    // Shader building without rlgl's per-step status checks, so a batch of
+    // programs can be handed to the driver before waiting on any of them
+    typedef const unsigned char* (*GetStringProc)(unsigned int name);
+    typedef const unsigned char* (*GetStringiProc)(unsigned int name, unsigned int index);
+    typedef void (*GetIntegervProc)(unsigned int pname, int* data);
+    typedef unsigned int (*CreateShaderProc)(unsigned int type);
+    typedef void (*ShaderSourceProc)(unsigned int shader, int count, const char* const* strings, const int* lengths);
+    typedef void (*CompileShaderProc)(unsigned int shader);
+    typedef void (*GetShaderivProc)(unsigned int shader, unsigned int pname, int* params);
+    typedef void (*GetInfoLogProc)(unsigned int object, int bufSize, int* length, char* infoLog);
+    typedef void (*DeleteShaderProc)(unsigned int shader);
+    typedef unsigned int (*CreateProgramProc)(void);
+    typedef void (*AttachShaderProc)(unsigned int program, unsigned int shader);
+    typedef void (*DetachShaderProc)(unsigned int program, unsigned int shader);
+    typedef void (*BindAttribLocationProc)(unsigned int program, unsigned int index, const char* name);
+    typedef void (*LinkProgramProc)(unsigned int program);
+    typedef void (*GetProgramivProc)(unsigned int program, unsigned int pname, int* params);
+    typedef void (*DeleteProgramProc)(unsigned int program);
+    typedef void (*ProgramParameteriProc)(unsigned int program, unsigned int pname, int value);
+    typedef void (*GetProgramBinaryProc)(unsigned int program, int bufSize, int* length, unsigned int* binaryFormat, void* binary);
+    typedef void (*ProgramBinaryProc)(unsigned int program, unsigned int binaryFormat, const void* binary, int length);
+    typedef void (*MaxShaderCompilerThreadsProc)(unsigned int count);
+
+    extern GenQueriesProc genQueries;
+    extern DeleteQueriesProc deleteQueries;
+    extern BeginQueryProc beginQuery;
+    extern EndQueryProc endQuery;
+    extern GetQueryObjectivProc getQueryObjectiv;
+    extern GetQueryObjectui64vProc getQueryObjectui64v;
+    extern VertexAttribPointerProc vertexAttribPointer;
+
+    extern GetStringProc getString;
+    extern GetStringiProc getStringi;
+    extern GetIntegervProc getIntegerv;
+    extern CreateShaderProc createShader;
+    extern ShaderSourceProc shaderSource;
+    extern CompileShaderProc compileShader;
+    extern GetShaderivProc getShaderiv;
+    extern GetInfoLogProc getShaderInfoLog;
+    extern DeleteShaderProc deleteShader;
+    extern CreateProgramProc createProgram;
+    extern AttachShaderProc attachShader;
+    extern DetachShaderProc detachShader;
+    extern BindAttribLocationProc bindAttribLocation;
+    extern LinkProgramProc linkProgram;
+    extern GetProgramivProc getProgramiv;
+    extern GetInfoLogProc getProgramInfoLog;
+    extern DeleteProgramProc deleteProgram;
+    extern ProgramParameteriProc programParameteri;
+    extern GetProgramBinaryProc getProgramBinary;
+    extern ProgramBinaryProc programBinary;
+    extern MaxShaderCompilerThreadsProc maxShaderCompilerThreads;   // Only set if KHR/ARB_parallel_shader_compile is listed
+
+    // Safe to call more than once. Needs a current GL context.
+    void load();
+
+    // Whether the driver advertises an extension, by its full name
+    // ("GL_KHR_parallel_shader_compile"). A resolved pointer alone proves
+    // nothing: loaders hand back stubs for functions the driver doesn't have.
+    bool hasExtension(const char* name);
+
+    bool hasTimerQueries();
+    bool hasShaderPrograms();
+
+    // GL 4.1 / ARB_get_program_binary, with at least one format the driver
+    // will hand back
+    bool hasProgramBinaries();
+}
@@ -1,8 +1,37 @@
 #pragma once
 
 #include "raylib.h"
+#include "GameConfig.hpp"
+#include "InputRecording.hpp"
+#include "Ball.hpp"
+#include "CameraPath.hpp"
+#include "RenderQueue.hpp"
+#include "FrameInput.hpp"
+#include "DynamicResolution.hpp"
+#include "TextRenderer.hpp"
+#include "UI.hpp"
+#include "Collision.hpp"
+#include "CharacterController.hpp"
+#include "ShaderCache.hpp"
+#include "JobSystem.hpp"
+#include "AssetCache.hpp"
+#include "NavMesh.hpp"
+#include "PackArchive.hpp"
+#include "FlowField.hpp"
+#include "Crowd.hpp"
+#include "FrameArena.hpp"
+#include "FrameLog.hpp"
+#include "ObjectPool.hpp"
+#include "MeshMemory.hpp"
+#include "VertexPacking.hpp"
+#include <chrono>
+#include <cstdint>
 #include <vector>
 #include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <random>
 
 enum class GameState {
     Playing,
@@ -11,7 +40,7 @@ enum class GameState {
 
 class Game {
     public:
-        Game();
+        Game(const GameConfig& config = GameConfig());
         ~Game(); 
         void run();
 
@@ -26,13 +55,46 @@ class Game {
             
             bool isTree = false;
 
-            // Note: Raylib handles matrix math internally during DrawModelEx,
-            // so we don't need a complex getModelMatrix() anymore!
+            // World matrix handed to the render queue. Objects are static,
+            // so this is built once by updateTransform() instead of every frame.
+            Matrix transform;
+            void updateTransform();
+
+            // World space bounding sphere, used for frustum culling
+            Vector3 boundsCenter;
+            float boundsRadius = 0.0f;
+            void updateBounds(const BoundingBox& localBounds);
+        };
+
+        // One object that survived culling, ready to be queued for drawing
+        struct RenderInstance {
+            const Model* model;
+            Matrix transform;
+        };
+
+        // Everything the main thread needs to draw one frame. The simulation
+        // thread fills one of these while the main thread renders the other,
+        // so neither side ever touches the other's data mid-frame.
+        // The lists live in the snapshot's own arena, which is reset before
+        // the snapshot is filled again.
+        struct RenderSnapshot {
+            Camera3D camera;
+            float yaw, pitch;                       // The look angles camera was built from
+            Vector3 ballPosition;
+            float ballRadius;
+            FrameArena arena;
+            FrameList<int> visibleMapChunks;        // Indices into mapModel.meshes
+            FrameList<RenderInstance> visibleObjects;
+            FrameList<Vector3> visibleAgents;       // Feet positions
+            FrameList<Vector3> visibleHorde;
+            FrameList<Vector3> visibleBalls;        // --stress balls, all radius 1
         };
 
         bool isCreativeMode = false;
 
     private:   
+        GameConfig config;
+
         // Physics variables (the ones you just fixed)
         bool isCrouching = false;
         bool isSprinting = false;
@@ -41,17 +103,25 @@ class Game {
         float speedMultiplier = 1.0f;
         float currentEyeHeight = 1.5f;
 
+        // Player capsule: feet to just above the eyes. Fences, tree trunks and
+        // steep terrain block it, same 0.65 slope limit as before.
+        CharacterController controller;
+        const float headroom = 0.2f;
+
         // View variables
         float cameraYaw = -90.0f;
         float cameraPitch = 0.0f;
 
         float sliderValue = 0.25f; // Visual 0.0 to 1.0
         float sensitivity = 0.0575f; // Math value (mapped from 0.25)
-        bool draggingSlider = false;
 
-        void processEvents(float deltaTime);
+        void processEvents(const FrameInput& input);
+        void processMenuEvents();
         void setupResources();
         void setupUI();
+        void loadMap();
+        void loadShaders();
+        void scatterVegetation(bool packVertices);
         
         // Logic Helpers
         void loadObject(GameObject& obj, const std::string& path, const std::string& texPath);
@@ -62,31 +132,160 @@ class Game {
         Camera3D camera;        // Replaces your custom Camera class
         GameState currentState;
 
-        Rectangle pauseMenuRect, resumeBtnRect, exitBtnRect, sliderTrackRect, sliderHandleRect;
-
-        // Raylib doesn't need "Shape" objects stored as variables for UI.
-        // We usually define UI sizes and draw them immediately in run().
-        // However, we can keep some variables for slider logic:
-        
+        // Retained UI, laid out in screen fractions so it survives resolution changes
+        TextRenderer text;      // SDF font for all UI text
+        UIScreen pauseMenu;
+        UIScreen hud;
+        int resumeButton, exitButton, sensitivitySlider, sensitivityLabel;
+        int crosshair;
 
         // Assets
-        Model mapModel;         // The main terrain
+        Model mapModel;         // The main terrain, one mesh per chunk if generated
+        std::vector<BoundingBox> mapChunkBounds;    // Per mesh, for culling
+        float mapHalfSize = 500.0f;     // Maps are square and centred on the origin
         Texture2D grassTexture;
         Texture2D rockTexture;
         
         std::vector<GameObject> sceneObjects;
+
+        // Every loaded mesh, so their CPU copies can be dropped after upload
+        MeshMemory meshMemory;
+        void releaseMeshData();
+
+        // --vertex-format=packed: the shader for pack models drawn from
+        // packed buffers, and how much that saved
+        Shader packedModelShader = {};
+        VertexPacking::Stats vertexStats;
         
         // For Custom Terrain Shading (Slope Blending)
         Shader terrainShader;
 
-        // Inside Game.hpp, under private:
-        struct Ball {
+        // Every shader variant, built up front and cached as program binaries
+        ShaderCache shaders;
+        struct {
+            int terrain, terrainPacked;
+            int modelPacked;        // Pack models on --vertex-format=packed
+            int text;
+        } shaderIds;
+
+        // Terrain triangles and prop colliders for swept (CCD) queries
+        CollisionWorld collision;
+
+        // Worker threads for baking and AI queries, and where bakes are kept
+        JobSystem jobs;
+        AssetCache assetCache;
+
+        // assets.pack, mounted over raylib's file loading for the whole run
+        PackArchive assetPack;
+
+        // Walkable space for AI, same slope limit and radius as the player
+        NavMesh navMesh;
+
+        // A few agents wandering between random spots on the navmesh. Their
+        // paths are requested together and solved on the workers.
+        struct Wanderer {
             Vector3 position;
-            Vector3 velocity;
-            float radius;
-            float restitution; // Bounciness (0.0 to 1.0)
-        } gameBall;
+            std::vector<Vector3> path;
+            int nextPoint = 0;
+            bool waiting = false;   // Path request in flight
+        };
+        ObjectPool<Wanderer> wanderers;
+        std::vector<NavMesh::PathRequest> pathRequests;
+        std::vector<NavMesh::Path> pathResults;
+        std::vector<Wanderer*> pathOwners;  // Who asked, per request
+        JobSystem::Counter pathJobs;
+        std::mt19937 wanderRng{ 1234 };
+        void updateWanderers(float deltaTime);
+
+        // The horde: thousands of agents converging on the player through a
+        // flow field that's rebuilt whenever the player changes cell
+        FlowField hordeField;
+        Crowd horde;
+        void updateHorde(float deltaTime);
+
+        Ball gameBall;
 
         // Add this helper method
         void updateBall(float deltaTime);
+        void keepBallOnMap(Ball& ball);
+
+        // Rendering
+        RenderQueue renderQueue;
+        Mesh ballMesh;
+        Material ballMaterial;
+        Material agentMaterial;
+        DynamicResolution dynamicRes;   // Off-screen 3D target, scaled by GPU time
+        GpuTimer uiTimer;               // 2D pass, for the profiler overlay
+        bool showProfiler = false;      // F3
+        void submitScene(const RenderSnapshot& snapshot);
+        void renderFrame(const RenderSnapshot& snapshot, const FrameInput& input);
+
+        // Late-latched mouse look: the snapshot being drawn was simulated with
+        // last frame's input, so the view is turned by this frame's mouse delta
+        // (the one the simulation thread is applying right now) just before the
+        // 3D pass. Culling leaves a margin for it, and the latched turn is
+        // clamped to that margin.
+        const float latchMarginDeg = 10.0f;      // A fast flick, at 60 fps
+        bool isLatching(const FrameInput& input) const;
+        Camera3D latchCamera(const RenderSnapshot& snapshot, const FrameInput& input) const;
+        std::chrono::steady_clock::time_point inputTime;        // When this frame's input was sampled
+        std::chrono::steady_clock::time_point lastInputTime;    // and last frame's
+
+        // Sizes the snapshot arenas and the render queue for the busiest
+        // possible frame, once everything is loaded
+        void reserveFrameMemory();
+
+        // Frame pipeline: the simulation thread works on frame N+1 while the
+        // main thread submits frame N to the GPU.
+        RenderSnapshot snapshots[2];
+        int renderIndex = 0;            // Snapshot the main thread is drawing
+        float viewAspect = 16.0f / 9.0f;
+        bool quitRequested = false;
+
+        std::thread simThread;
+        std::mutex simMutex;
+        std::condition_variable simWake;
+        std::condition_variable simFinished;
+        FrameInput simInput;
+        bool simPending = false;
+        bool simQuit = false;
+
+        void simulate(const FrameInput& input, RenderSnapshot& out);
+        void buildSnapshot(RenderSnapshot& out);
+        void simulationLoop();
+        void kickSimulation(const FrameInput& input);
+        void waitForSimulation();
+
+        // Debug builds: heap allocations in the last frame, per thread. A
+        // frame of play after the warm-up should have none.
+        uint64_t simAllocations = 0;
+        int steadyFrames = 0;           // Frames in a row spent playing
+        void checkFrameAllocations(uint64_t allocations);
+
+        // --flythrough benchmark: the camera follows the path at a fixed 60 Hz
+        // step instead of input, so every run draws the same frames
+        CameraPath cameraPath;
+        FrameLog frameLog;
+        const char* frameLogPath = nullptr;     // Set when this run is a benchmark
+        float flythroughTime = 0.0f;
+        bool flythroughDone = false;    // Set by the simulation thread
+        float simMs = 0.0f;             // Last simulation step, for the log
+        void startFlythrough();
+        void updateFlythrough(float deltaTime);
+        void recordPathKey();           // F6: the drawn camera's pose onto the path file
+
+        // --record / --replay. Both make the simulation deterministic: the
+        // wanderers' path batches land on the frame after they were asked for,
+        // not whenever the workers happen to finish.
+        InputRecorder inputRecorder;
+        InputReplay inputReplay;
+        bool deterministic = false;
+        void startReplay();
+
+        // --stress: counted fences, trees, props and balls in place of the
+        // authored layout, run for a fixed number of frames, then reported
+        std::vector<Ball> stressBalls;
+        int stressFramesLeft = 0;
+        void buildStressScene(bool packVertices);
+        void startStress();
 };
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Startup options, from the command line:
+//   --terrain=towers|procedural   Authored map (default) or a generated one
+//   --seed=N                      Seed for the generated map
+//   --map-size=N                  Side of the generated map in metres
+//   --mesh-data=release|keep      Free CPU copies of meshes once uploaded (default)
+//   --vertex-format=float|packed  raylib's float vertices (default) or 16-byte packed ones
+//   --pack=file|none              Asset archive to load from (assets.pack when it exists,
+//                                 start.sh passes the build's), none for the loose files only
+//   --mouse-look=latched|simulated
+//                                 Turn the drawn view by the newest mouse input just before
+//                                 the 3D pass (default), or draw what the simulation produced
+//   --flythrough[=file]           Benchmark: fly a recorded camera path (assets/benchmarks/towers.path),
+//                                 log frame times to flythrough.csv and quit
+//   --record=file                 Save every frame's input for --replay
+//   --replay=file                 Play a recording back (on its map), log frame times to replay.csv and quit
+//   --replay-step=recorded|fixed  Replay with the recorded frame times (default) or a fixed 60 Hz step
+//   --stress=file                 Stress scene from a file of key=value lines (keys below)
+//   --stress-<key>=value          Same, one setting at a time: fences, trees, species,
+//                                 balls, props, frames, seed
+//   --trace=N                     Record loading and the first N frames to trace.json
+//                                 (also the length of an F4 capture, 300 by default)
+struct GameConfig {
+    enum class Terrain { Towers, Procedural };
+    enum class VertexFormat { Float, Packed };
+
+    Terrain terrain = Terrain::Towers;
+    uint32_t seed = 1;
+    float mapSize = 1000.0f;
+    bool keepMeshData = false;
+    VertexFormat vertexFormat = VertexFormat::Float;
+    const char* packPath = "assets.pack";
+    bool lateLatch = true;
+    int traceFrames = 0;
+    bool flythrough = false;
+    const char* flythroughPath = "assets/benchmarks/towers.path";     // Also where F6 records to
+    const char* recordPath = nullptr;
+    const char* replayPath = nullptr;
+    bool replayFixedStep = false;
+
+    // Content counts for scaling tests. They replace the authored fences and
+    // the vegetation scatter; anything not given is 0.
+    struct Stress {
+        bool enabled = false;
+        int fences = 0;                 // Evenly around the map edge
+        int trees = 0;                  // Spread at random over the map
+        std::string species = "CommonTree_1,BirchTree_2,PineTree_3";    // Nature Pack OBJs for the trees
+        int balls = 0;                  // Bouncing alongside the player's one
+        int props = 0;                  // Farm buildings and Gun Pack models
+        int frames = 600;               // Frames to run before reporting and quitting, 0 to keep playing
+        uint32_t seed = 7;
+    } stress;
+
+    // Unknown or malformed options are reported and skipped
+    static GameConfig fromArgs(int argc, char** argv);
+};
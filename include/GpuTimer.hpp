@@ -0,0 +1,36 @@
+#pragma once
+
+// Measures how long the GPU spends on a block of work using GL_TIME_ELAPSED
+// queries. Results come back a few frames late, so a small ring of queries is
+// used and we only ever read ones the driver says are ready (never stalls).
+class GpuTimer {
+    public:
+        ~GpuTimer();
+
+        // Returns false if the driver has no timer queries
+        bool init();
+        void shutdown();
+
+        // Flushes raylib's batch so the queued geometry lands inside the query
+        void begin();
+        void end();
+
+        // Collect any finished results. Call once per frame.
+        void poll();
+
+        bool isAvailable() const { return available; }
+
+        // Last GPU time we got back, in milliseconds (0 until the first result)
+        float getLastMs() const { return lastMs; }
+
+    private:
+        static const int ringSize = 4;
+
+        unsigned int queries[ringSize] = {};
+        bool inFlight[ringSize] = {};
+        int writeIndex = 0;
+        int readIndex = 0;
+        bool available = false;
+        bool active = false;
+        float lastMs = 0.0f;
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "FrameInput.hpp"
+#include "GameConfig.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// Every frame's FrameInput saved to disk and fed back later, so a session
+// (and whatever made it slow) can be rerun exactly, in any build.
+//
+// File layout, little-endian:
+//   header   "DJOI", version (u16), terrain (u8), 0 (u8), seed (u32),
+//            map size (f32), frame count (u32)                      20 bytes
+//   frame    deltaTime, mouseDelta.x, mouseDelta.y, sensitivity (f32),
+//            keysDown, keysPressed (u16)                             20 bytes
+// The top bit of keysDown carries FrameInput::playing.
+//
+// The header holds the map settings, so a replay loads the map the session
+// was recorded on whatever the command line says.
+class InputRecorder {
+    public:
+        ~InputRecorder() { stop(); }
+
+        bool start(const char* path, const GameConfig& config);
+        void record(const FrameInput& input);
+
+        // Writes the frame count into the header and closes the file
+        void stop();
+
+        bool isRecording() const { return file != nullptr; }
+
+    private:
+        FILE* file = nullptr;
+        uint32_t frameCount = 0;
+};
+
+class InputReplay {
+    public:
+        // Reads the whole recording and points config at its map
+        bool load(const char* path, GameConfig& config);
+
+        // The next recorded frame, false once they've all been played
+        bool next(FrameInput& out);
+
+        bool isLoaded() const { return !frames.empty(); }
+        int getFrameCount() const { return (int)frames.size(); }
+
+    private:
+        std::vector<FrameInput> frames;
+        size_t position = 0;
+};
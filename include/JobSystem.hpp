@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Small fixed pool of worker threads for fire-and-forget jobs (path queries,
+// baking, generation). The main and simulation threads already have a core
+// each, so by default it uses whatever is left.
+//
+// Submitting doesn't touch the heap: a job's lambda is copied into a fixed
+// slot (so it may only capture a few pointers and indices) and queued in a
+// ring buffer that only grows past its busiest moment so far.
+class JobSystem {
+    public:
+        // Tracks a group of jobs. wait() on it, or poll isDone() from a frame loop.
+        struct Counter {
+            std::atomic<int> pending{0};
+        };
+
+        ~JobSystem();
+
+        // workers <= 0 means hardware threads minus the two we already use
+        void init(int workers = 0);
+        void shutdown();
+
+        // Copies fn into the job, it has to fit in kJobStorage bytes and be
+        // trivially copyable (capture pointers, references and numbers)
+        template <typename Fn>
+        void submit(Counter& counter, Fn fn);
+
+        // Blocks until every job on the counter finished, running queued jobs
+        // on the calling thread meanwhile instead of just sleeping
+        void wait(Counter& counter);
+        static bool isDone(const Counter& counter) { return counter.pending.load(std::memory_order_acquire) == 0; }
+
+        // Splits [0, count) into chunks of grain and runs fn(begin, end) on the
+        // workers plus the calling thread. Returns when all chunks are done.
+        template <typename Fn>
+        void parallelFor(int count, int grain, Fn fn);
+
+        int getWorkerCount() const { return (int)workers.size(); }
+
+        static const size_t kJobStorage = 48;
+
+    private:
+        struct Job {
+            alignas(std::max_align_t) unsigned char storage[kJobStorage];
+            void (*invoke)(const void* storage);
+            Counter* counter;
+        };
+
+        void push(const Job& job);
+        bool pop(Job& job);
+        static void execute(const Job& job);
+
+        bool runOne();
+        void workerLoop();
+
+        std::vector<std::thread> workers;
+
+        // Ring buffer of queued jobs, doubled when full
+        std::vector<Job> jobs;
+        size_t head = 0;
+        size_t queued = 0;
+
+        std::mutex mutex;
+        std::condition_variable wake;
+        bool quit = false;
+};
+
+// --- Template implementations ---
+
+template <typename Fn>
+void JobSystem::submit(Counter& counter, Fn fn) {
+    static_assert(sizeof(Fn) <= kJobStorage, "Job captures too much, pass a pointer to the data instead");
+    static_assert(alignof(Fn) <= alignof(std::max_align_t), "Job captures an over-aligned type");
+    static_assert(std::is_trivially_copyable<Fn>::value, "Jobs are copied bytewise, capture pointers not containers");
+
+    Job job;
+    new (job.storage) Fn(fn);
+    job.invoke = [](const void* storage) { (*static_cast<const Fn*>(storage))(); };
+    job.counter = &counter;
+    push(job);
+}
+
+template <typename Fn>
+void JobSystem::parallelFor(int count, int grain, Fn fn) {
+    if (count <= 0) return;
+    if (grain < 1) grain = 1;
+
+    // Nothing to spread the work over, just do it here
+    if (workers.empty() || count <= grain) {
+        fn(0, count);
+        return;
+    }
+
+    Counter counter;
+    for (int begin = 0; begin < count; begin += grain) {
+        int end = (begin + grain < count) ? begin + grain : count;
+        submit(counter, [&fn, begin, end] { fn(begin, end); });
+    }
+    wait(counter);
+}
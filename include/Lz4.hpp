@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// LZ4 block format (github.com/lz4/lz4, doc/lz4_Block_format.md), enough of
+// it for the asset pack: a greedy single-pass compressor and a bounds-checked
+// decompressor. Blocks are interchangeable with the reference library's
+// LZ4_compress_default / LZ4_decompress_safe, so a pack can be inspected
+// with standard tools.
+namespace lz4 {
+    // Largest block compress() can produce for size bytes of input
+    inline size_t compressBound(size_t size) { return size + size / 255 + 16; }
+
+    // dst needs compressBound(size) bytes. Returns the block size.
+    size_t compress(const uint8_t* src, size_t size, uint8_t* dst);
+
+    // False if the block is malformed or doesn't expand to exactly dstSize bytes
+    bool decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+
+// Heap accounting for debug builds. Memory.cpp replaces the global operator
+// new with one that counts calls per thread, so a loop can check that it
+// stays off the heap. Release builds keep the stock allocator and the count
+// always reads 0.
+//
+// Only C++ allocations are seen: raylib, GLFW and the GL driver call malloc
+// directly.
+#if !defined(NDEBUG)
+    #define MEMORY_TRACKING 1
+#endif
+
+namespace memory {
+    // operator new calls made by the calling thread so far, outside jobs
+    uint64_t getAllocationCount();
+
+    // operator new calls made inside jobs so far, on every thread together
+    // (a thread helping out while it waits counts here, not in its own)
+    uint64_t getJobAllocationCount();
+
+    // Physical memory the process holds right now, driver and GPU staging
+    // included. Any build; 0 where the OS doesn't tell us (Linux only for now).
+    uint64_t getResidentBytes();
+
+    // Allocations made while one of these is alive aren't counted. Only for
+    // the few places that are allowed to allocate mid-game (a thread's first
+    // trace buffer).
+    class UntrackedScope {
+        public:
+            UntrackedScope();
+            ~UntrackedScope();
+
+            UntrackedScope(const UntrackedScope&) = delete;
+            UntrackedScope& operator=(const UntrackedScope&) = delete;
+    };
+
+    // The job system runs every job inside one of these, which sends the
+    // job's allocations to getJobAllocationCount()
+    class JobScope {
+        public:
+            JobScope();
+            ~JobScope();
+
+            JobScope(const JobScope&) = delete;
+            JobScope& operator=(const JobScope&) = delete;
+    };
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "raylib.h"
+#include <cstddef>
+#include <vector>
+
+// What raylib keeps in RAM for loaded meshes, and letting go of it.
+//
+// LoadModel() and UploadMesh() leave every vertex array on the CPU after the
+// GPU has its own copy. Drawing only needs the GPU buffers, so once the
+// collision copies are built the CPU side can go. Index arrays stay: DrawMesh()
+// checks mesh.indices to choose indexed drawing, and they're the small part.
+class MeshMemory {
+    public:
+        // Meshes are grouped for the report (the map, each asset pack, ...).
+        // Copies of a Model share its meshes, tracking one of them is enough.
+        void track(const char* group, const Model& model);
+        void track(const char* group, Mesh& mesh);
+
+        // CPU bytes still held by one group's meshes, or by all of them
+        size_t getCpuBytes(const char* group = nullptr) const;
+        static size_t getCpuBytes(const Mesh& mesh);
+
+        // Frees the vertex arrays of every tracked mesh that's on the GPU and
+        // logs each group before and after
+        void release();
+
+        // Logs what each group holds right now
+        void report() const;
+
+    private:
+        struct Entry {
+            const char* group;
+            Mesh* meshes;
+            int count;
+        };
+
+        std::vector<const char*> groups() const;
+
+        std::vector<Entry> entries;
+};
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "raylib.h"
+#include "Collision.hpp"
+#include "JobSystem.hpp"
+#include "AssetCache.hpp"
+#include <cstdint>
+#include <vector>
+
+// Walkable space over the terrain, for AI agents.
+//
+// The terrain is rasterised into a grid of cells (top surface only). A cell is
+// walkable if its slope passes the same slopeLimit the player uses, it's at
+// least an agent radius away from anything too steep, and no tree trunk or
+// fence stands on it. Walkable cells are then merged into rectangles: those
+// are the navmesh polygons, joined by portals along their shared edges.
+// Paths are A* over the polygons, straightened with a funnel pass.
+class NavMesh {
+    public:
+        struct Settings {
+            float cellSize = 1.0f;
+            float slopeLimit = 0.65f;   // Same as the character controller
+            float agentRadius = 0.4f;
+            float maxClimb = 0.5f;      // Height step allowed between neighbouring cells
+            int maxPolySize = 32;       // Longest polygon side, in cells
+        };
+
+        struct PathRequest {
+            Vector3 start;
+            Vector3 end;
+        };
+
+        struct Path {
+            bool found = false;
+            std::vector<Vector3> points;    // Start to end, straightened
+        };
+
+        Settings settings;
+
+        void build(const CollisionWorld& world, JobSystem& jobs);
+
+        // Loads the navmesh from the cache if it was baked from the same terrain,
+        // props and settings. Otherwise builds it and stores it. Returns true on a cache hit.
+        bool buildCached(const CollisionWorld& world, JobSystem& jobs, const AssetCache& cache);
+
+        // Single query on the calling thread
+        bool findPath(Vector3 start, Vector3 end, Path& out) const;
+
+        // Batched queries on the workers, batchSize requests per job. results is
+        // grown to fit here but never shrunk, so its paths keep their buffers
+        // from batch to batch; keep both vectors alive until done reaches zero.
+        void findPaths(JobSystem& jobs, const std::vector<PathRequest>& requests,
+                       std::vector<Path>& results, JobSystem::Counter& done, int batchSize = 8) const;
+
+        bool isWalkable(float x, float z) const;
+        float getHeightAt(float x, float z) const;
+
+        // Nearest walkable cell centre within radius (in world units)
+        bool findNearestWalkable(Vector3 position, float radius, Vector3& out) const;
+
+        bool isBuilt() const { return !polys.empty(); }
+        int getPolyCount() const { return (int)polys.size(); }
+
+        // Raw surface grid (cell centred), for systems that sample heights in bulk
+        const std::vector<float>& getHeights() const { return heights; }
+        Vector2 getOrigin() const { return origin; }
+        int getCellsX() const { return cellsX; }
+        int getCellsZ() const { return cellsZ; }
+
+    private:
+        // Rectangle of cells [x0, x1) x [z0, z1)
+        struct Poly {
+            int32_t x0, z0, x1, z1;
+        };
+
+        // Portal to a neighbouring polygon: the shared stretch of edge
+        struct Link {
+            int32_t poly;
+            float ax, az, bx, bz;
+        };
+
+        static uint64_t computeKey(const CollisionWorld& world, const Settings& settings);
+        void serialize(CacheWriter& out) const;
+        bool deserialize(CacheReader& in);
+
+        bool cellAt(float x, float z, int& cx, int& cz) const;
+        bool connected(int a, int b) const;
+        int locate(Vector3 position, Vector3& snapped) const;
+        void stringPull(const std::vector<Vector2>& lefts, const std::vector<Vector2>& rights,
+                        std::vector<Vector3>& points) const;
+
+        Vector2 origin = { 0, 0 };
+        int cellsX = 0;
+        int cellsZ = 0;
+
+        std::vector<float> heights;     // Top surface per cell
+        std::vector<int32_t> cellPoly;  // Polygon per cell, -1 if not walkable
+
+        std::vector<Poly> polys;
+        std::vector<uint32_t> linkStart;    // Prefix offsets into links, one per poly + 1
+        std::vector<Link> links;
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "raylib.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class JobSystem;
+
+// OBJ/MTL loading in place of raylib's LoadModel, which parses the whole
+// file on one thread through tinyobj.
+//
+// The file is cut into chunks at line breaks and the chunks are parsed on
+// the workers: numbers straight out of the text, faces fanned into
+// triangles. The chunks are then stitched back together (relative indices
+// and usemtl carry over from the chunks before them) and each one writes
+// its triangles straight into the right material's mesh.
+//
+// The result is laid out the way raylib 5's LoadOBJ lays it out, so nothing
+// downstream can tell the difference: one mesh per material (mesh i uses
+// material i), three unindexed vertices per triangle, V flipped for raylib's
+// textures, zeros where the file has no texcoords or normals, textures from
+// the MTL relative to the OBJ's folder.
+namespace ObjLoader {
+    struct MaterialData {
+        std::string name;
+        Color diffuse = { 0, 0, 0, 255 };       // Kd, tinyobj's default is black
+        Color specular = { 0, 0, 0, 255 };      // Ks
+        Color emission = { 0, 0, 0, 255 };      // Ke
+        float shininess = 1.0f;                 // Ns
+        std::string diffuseMap;                 // Full paths, empty if unset
+        std::string specularMap;
+        std::string normalMap;
+        std::string heightMap;
+    };
+
+    struct MeshData {
+        std::vector<float> vertices;    // 9 per triangle
+        std::vector<float> texcoords;   // 6 per triangle
+        std::vector<float> normals;     // 9 per triangle
+    };
+
+    // Everything in an OBJ, ready to upload. Mesh i goes with material i, or
+    // there is one mesh and no materials.
+    struct Data {
+        std::vector<MeshData> meshes;
+        std::vector<MaterialData> materials;
+        int triangles = 0;
+    };
+
+    // The CPU half: reads path (through the mounted PackArchive) and its MTL
+    // files. Safe off the GL thread. False if the file can't be read.
+    bool parse(const char* path, JobSystem& jobs, Data& out);
+
+    // The GL half: builds the Model, uploads its meshes and loads its
+    // textures. Takes the arrays over from data.
+    Model upload(Data& data);
+
+    // parse() then upload(), a drop-in for LoadModel on .obj files
+    Model load(const char* path, JobSystem& jobs);
+
+    // Exposed for obj_bench, which checks it against strtof. Parses a decimal
+    // float to the same bits strtof gives (no nan, inf or hex), returns where
+    // it stopped (begin if there was no number).
+    const char* parseFloat(const char* begin, const char* end, float& value);
+}
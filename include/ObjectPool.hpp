@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Free-list pool for long-lived entities that come and go.
+//
+// Slots are allocated a block at a time and never move, so pointers to live
+// objects stay valid, and a destroyed object's slot is reused by the next
+// create() instead of going back to the heap. reserve() up front and
+// spawning/despawning costs no allocations at all.
+template <typename T, size_t BlockSize = 64>
+class ObjectPool {
+    public:
+        ObjectPool() = default;
+        ~ObjectPool();
+
+        ObjectPool(const ObjectPool&) = delete;
+        ObjectPool& operator=(const ObjectPool&) = delete;
+
+        // Room for count live objects without growing
+        void reserve(size_t count);
+
+        template <typename... Args>
+        T* create(Args&&... args);
+        void destroy(T* object);
+
+        // Destroys everything, keeps the blocks
+        void clear();
+
+        // fn(T&) for every live object, in slot order
+        template <typename Fn>
+        void forEach(Fn fn);
+        template <typename Fn>
+        void forEach(Fn fn) const;
+
+        size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+        size_t capacity() const { return blocks.size() * BlockSize; }
+
+    private:
+        // storage first, so a T* is also its Slot*
+        struct Slot {
+            alignas(T) unsigned char storage[sizeof(T)];
+            Slot* nextFree;
+            bool live;
+
+            T* object() { return std::launder(reinterpret_cast<T*>(storage)); }
+        };
+
+        void addBlock();
+
+        std::vector<Slot*> blocks;
+        Slot* freeList = nullptr;
+        size_t count = 0;
+};
+
+// --- Template implementations ---
+
+template <typename T, size_t BlockSize>
+ObjectPool<T, BlockSize>::~ObjectPool() {
+    clear();
+    for (Slot* block : blocks) delete[] block;
+}
+
+template <typename T, size_t BlockSize>
+void ObjectPool<T, BlockSize>::reserve(size_t wanted) {
+    while (capacity() < wanted) addBlock();
+}
+
+template <typename T, size_t BlockSize>
+void ObjectPool<T, BlockSize>::addBlock() {
+    Slot* block = new Slot[BlockSize];
+    blocks.push_back(block);
+
+    // Thread the new slots onto the free list back to front, so a fresh
+    // block is handed out front to back
+    for (size_t i = BlockSize; i-- > 0;) {
+        block[i].live = false;
+        block[i].nextFree = freeList;
+        freeList = &block[i];
+    }
+}
+
+template <typename T, size_t BlockSize>
+template <typename... Args>
+T* ObjectPool<T, BlockSize>::create(Args&&... args) {
+    if (!freeList) addBlock();
+
+    Slot* slot = freeList;
+    T* object = new (slot->storage) T(std::forward<Args>(args)...);
+    freeList = slot->nextFree;
+    slot->live = true;
+    count++;
+    return object;
+}
+
+template <typename T, size_t BlockSize>
+void ObjectPool<T, BlockSize>::destroy(T* object) {
+    if (!object) return;
+
+    Slot* slot = reinterpret_cast<Slot*>(object);
+    assert(slot->live && "Destroying an object twice");
+    object->~T();
+    slot->live = false;
+    slot->nextFree = freeList;
+    freeList = slot;
+    count--;
+}
+
+template <typename T, size_t BlockSize>
+void ObjectPool<T, BlockSize>::clear() {
+    for (Slot* block : blocks) {
+        for (size_t i = 0; i < BlockSize; i++) {
+            if (block[i].live) destroy(block[i].object());
+        }
+    }
+}
+
+template <typename T, size_t BlockSize>
+template <typename Fn>
+void ObjectPool<T, BlockSize>::forEach(Fn fn) {
+    for (Slot* block : blocks) {
+        for (size_t i = 0; i < BlockSize; i++) {
+            if (block[i].live) fn(*block[i].object());
+        }
+    }
+}
+
+template <typename T, size_t BlockSize>
+template <typename Fn>
+void ObjectPool<T, BlockSize>::forEach(Fn fn) const {
+    for (Slot* block : blocks) {
+        for (size_t i = 0; i < BlockSize; i++) {
+            if (block[i].live) fn(static_cast<const T&>(*block[i].object()));
+        }
+    }
+}
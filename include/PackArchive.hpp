@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// assets/ as one file, so a cold start is a handful of big sequential reads
+// instead of hundreds of small ones scattered over the pack folders.
+//
+//   header | table of contents (sorted by path hash) | path names | entries
+//
+// Entries start on 64 byte boundaries. Ones that LZ4 doesn't shrink by at
+// least an eighth (textures are already compressed) are stored as they are,
+// and view() hands those out straight from the mapping. Entries are laid
+// out in path order, so a pack's OBJ, MTL and texture sit next to each other.
+//
+// The game mounts it over raylib's file loading: LoadTexture, LoadFileData
+// and friends find archived files first and anything else on disk, under the
+// same paths as always ("assets/textures/grass.jpg"). OBJs go through
+// ObjLoader, since raylib's LoadModel changes directory to read the MTL and
+// archive lookups never look at the working directory.
+// djo_pack (tools/) builds it.
+class PackArchive {
+    public:
+        struct Entry {
+            uint64_t pathHash;
+            uint64_t offset;            // From the start of the file
+            uint64_t storedSize;
+            uint64_t size;              // Once decompressed
+            uint32_t nameOffset;        // Into the name table
+            uint16_t nameLength;
+            uint16_t flags;
+        };
+
+        static const uint16_t kCompressed = 1;
+        static const size_t kAlignment = 64;
+
+        PackArchive() = default;
+        ~PackArchive();
+
+        PackArchive(const PackArchive&) = delete;
+        PackArchive& operator=(const PackArchive&) = delete;
+
+        // Maps the file where the OS can (POSIX), reads it in one go elsewhere
+        bool open(const char* path);
+        void close();
+        bool isOpen() const { return base != nullptr; }
+
+        int getEntryCount() const { return (int)entryCount; }
+        size_t getSize() const { return size; }
+
+        // Paths as the game spells them, relative to the directory it was
+        // started in (whatever the working directory is now). Lookups are
+        // safe from any thread.
+        const Entry* find(const char* path) const;
+
+        // The whole entry, decompressed if it has to be
+        bool read(const Entry& entry, std::vector<uint8_t>& out) const;
+        bool read(const Entry& entry, uint8_t* out) const;     // entry.size bytes
+
+        // No copy, no decompression: null for compressed entries
+        const uint8_t* view(const Entry& entry) const;
+
+        // Send raylib's file loading through this archive until unmount()
+        // (or it closes). One archive at a time.
+        void mount();
+        void unmount();
+
+        // For our own loaders: the mounted archive, then the disk
+        static bool readFile(const char* path, std::vector<uint8_t>& out);
+        static bool fileExists(const char* path);
+
+        // Packs files (named the way they'll be looked up) into path
+        struct BuildStats {
+            int files = 0;
+            int compressed = 0;
+            uint64_t inputBytes = 0;
+            uint64_t outputBytes = 0;
+        };
+        static bool build(const char* path, const std::vector<std::string>& files, BuildStats& stats);
+
+    private:
+        size_t resolve(const char* path, char* out, size_t capacity) const;
+
+        const uint8_t* base = nullptr;
+        size_t size = 0;
+        bool mapped = false;
+        std::vector<uint8_t> contents;      // When not mapped
+
+        const Entry* entries = nullptr;
+        uint32_t entryCount = 0;
+        const char* names = nullptr;
+        std::string root;                   // Working directory when opened
+};
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "raylib.h"
+
+// World matrix of a prop standing on the ground, built in the order
+// DrawModelEx uses: scale, then rotate, then translate. Upright props only
+// turn by yaw; aligned ones (fences) tilt to the ground normal first and
+// then turn about it.
+Matrix placementTransform(Vector3 position, float yawDegrees, Vector3 scale, Vector3 groundNormal, bool alignToGround);
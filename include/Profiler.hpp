@@ -0,0 +1,98 @@
+#pragma once
+
+#include "Trace.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+class TextRenderer;
+
+// Scoped CPU timers and a frame history overlay.
+//
+//     void Game::updateBall(float deltaTime) {
+//         PROFILE_SCOPE("updateBall");
+//         ...
+//
+// Every scope with the same name adds into one slot, from any thread, and
+// endFrame() moves the slots into a ring of recent frames. While a trace is
+// recording, scopes also go to the timeline (Trace.hpp). With both off a
+// scope costs two relaxed loads and a branch: no clock reads, no writes.
+// GPU times come in from outside (GpuTimer queries), since GL only allows
+// one timer query at a time and the passes already own theirs.
+namespace profiler {
+    const int kMaxMarkers = 32;
+    const int kHistory = 240;       // Frames kept for the graph and averages
+
+    // A named slot, registered once per call site (the macro keeps it static)
+    class Marker {
+        public:
+            explicit Marker(const char* name);
+            int getSlot() const { return slot; }
+            const char* getName() const { return name; }
+
+        private:
+            const char* name;
+            int slot;
+    };
+
+    namespace detail {
+        extern std::atomic<bool> enabled;
+    }
+
+    inline bool isEnabled() { return detail::enabled.load(std::memory_order_relaxed); }
+
+    // Turning it on starts a fresh history
+    void setEnabled(bool enabled);
+
+    class Scope {
+        public:
+            explicit Scope(const Marker& marker) : marker(nullptr) {
+                if (!isEnabled() && !trace::isRecording()) return;
+                this->marker = &marker;
+                start = std::chrono::steady_clock::now();
+            }
+            ~Scope() {
+                if (marker) finish();
+            }
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            void finish();
+
+            const Marker* marker;
+            std::chrono::steady_clock::time_point start;
+    };
+
+    // Time that doesn't sit inside one block, like input latency: from start
+    // (taken earlier, possibly a frame ago) until now goes into marker's slot.
+    // Profiler only, such spans overlap frames and wouldn't nest in a trace.
+    void addSince(const Marker& marker, std::chrono::steady_clock::time_point start);
+
+    // Main thread, once every thread is done with the frame. GPU times are
+    // whatever the queries last returned (they lag a few frames).
+    void endFrame(float frameMs, float gpuSceneMs, float gpuUiMs);
+
+    // Frame graph plus one bar per scope, averaged over the last second.
+    // Queues into text's batch, call before its flush().
+    void drawOverlay(TextRenderer& text, float x, float y);
+
+    // The same averages over the whole history, one log line per scope
+    void logSummary(const char* label);
+}
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#if defined(PROFILER_DISABLED)
+    #define PROFILE_SCOPE(name) ((void)0)
+    #define PROFILE_SINCE(name, start) ((void)0)
+#else
+    #define PROFILE_SCOPE(name) \
+        static const profiler::Marker PROFILE_CONCAT(profileMarker, __LINE__)(name); \
+        profiler::Scope PROFILE_CONCAT(profileScope, __LINE__)(PROFILE_CONCAT(profileMarker, __LINE__))
+    #define PROFILE_SINCE(name, start) \
+        static const profiler::Marker PROFILE_CONCAT(profileMarker, __LINE__)(name); \
+        profiler::addSince(PROFILE_CONCAT(profileMarker, __LINE__), start)
+#endif
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "raylib.h"
+#include <cstddef>
+#include <vector>
+
+// A mesh's triangles baked to world space in SoA form, for ray queries that
+// give exactly the same answer as GetRayCollisionMesh, just a lot faster.
+//
+// The Möller–Trumbore test runs 4/8/16 triangles at a time (SSE, AVX2 or
+// AVX-512, picked at runtime) with a scalar fallback. Every lane does the same
+// float operations in the same order as raylib, and the closest hit wins with
+// ties going to the lowest triangle index, so results are bit-identical.
+class RayMesh {
+    public:
+        enum class Isa { Scalar, SSE, AVX2, AVX512 };
+
+        void build(const Mesh& mesh, const Matrix& transform);
+        void clear();
+
+        // Drop-in for GetRayCollisionMesh(ray, mesh, transform)
+        RayCollision cast(Ray ray) const;
+
+        // Many rays at once: each block of triangles is loaded once and tested
+        // against the whole packet, which pays off for batches of queries
+        void castPacket(const Ray* rays, int count, RayCollision* results) const;
+
+        int getTriangleCount() const { return triangleCount; }
+        bool isBuilt() const { return triangleCount > 0; }
+        size_t getMemoryBytes() const { return 9 * p1x.capacity() * sizeof(float); }
+
+        // Force a narrower path (benchmarks/debugging). Clamped to what the CPU has.
+        void setIsa(Isa isa);
+        Isa getIsa() const { return isa; }
+        static Isa detectIsa();
+        static const char* isaName(Isa isa);
+
+        // Largest packet the kernels handle in one pass; castPacket splits bigger ones
+        static const int maxPacket = 8;
+
+        // Per-ray winner, reduced from the lanes
+        struct Best {
+            bool hit;
+            float t;
+            int index;
+        };
+
+    private:
+        RayCollision finish(const Ray& ray, const Best& best) const;
+
+        // Vertex 1 and both edges, one array per component, padded to a
+        // multiple of 16 with degenerate triangles (zero edges never hit)
+        std::vector<float> p1x, p1y, p1z;
+        std::vector<float> e1x, e1y, e1z;
+        std::vector<float> e2x, e2y, e2z;
+
+        int triangleCount = 0;
+        int paddedCount = 0;
+        Isa isa = detectIsa();
+};
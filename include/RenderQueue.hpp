@@ -0,0 +1,104 @@
+#pragma once
+
+#include "raylib.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Where a packet lands in the frame. Layers are the top bits of the sort key,
+// so everything in a lower layer is drawn before anything in a higher one.
+enum class RenderLayer : uint8_t {
+    Opaque = 0,
+    Debug  = 1   // Wireframes and other immediate-mode helpers
+};
+
+enum class PacketType : uint8_t {
+    Mesh,
+    SphereWires,
+    Cube
+};
+
+// One draw call waiting to be executed. Gameplay code fills these in through
+// RenderQueue::submit*() and never talks to the GPU directly.
+struct DrawPacket {
+    uint64_t sortKey;
+    PacketType type;
+
+    const Mesh* mesh;           // Points into a Model that outlives the frame
+    const Material* material;
+    Matrix transform;
+
+    // Only used by immediate-mode packets (SphereWires, Cube)
+    Vector3 center;
+    float radius;
+    Vector3 size;
+    Color color;
+};
+
+// Counters for the last executed frame (handy for profiling and benchmarks).
+// The binds are the ones execute() really issued, after skipping the
+// redundant ones.
+struct RenderStats {
+    int drawCalls = 0;
+    int triangles = 0;
+    int shaderBinds = 0;
+    int textureBinds = 0;
+    int meshBinds = 0;          // VAOs
+};
+
+// State-sorted render queue.
+//
+// Sort key layout (most significant bit first):
+//   [63..62] layer       (2 bits)
+//   [61..54] shader      (8 bits)
+//   [53..46] material    (8 bits)
+//   [45..34] texture     (12 bits)
+//   [33..22] mesh        (12 bits)
+//   [21..0]  depth       (22 bits, front-to-back)
+//
+// Sorting on that key groups packets that share GL state together, and
+// execute() draws through rlgl rather than DrawMesh so it can keep that state
+// between packets: the program, textures and VAO are only bound when the
+// next packet needs different ones, and each draw sets just its matrices.
+class RenderQueue {
+    public:
+        RenderQueue();
+
+        // Make room for the busiest frame up front, so submitting never
+        // grows the queue mid-frame
+        void reserve(size_t packetCount);
+
+        // Call once per frame before submitting anything
+        void begin(Vector3 cameraPosition);
+
+        // Queue every mesh of a model with the given world matrix
+        void submitModel(const Model& model, const Matrix& world, RenderLayer layer = RenderLayer::Opaque);
+
+        // Queue a single mesh with its own material
+        void submitMesh(const Mesh& mesh, const Material& material, const Matrix& world, RenderLayer layer = RenderLayer::Opaque);
+
+        void submitSphereWires(Vector3 center, float radius, Color color);
+
+        // Flat shaded box through rlgl's batch. Consecutive cubes share one
+        // draw call, so this is the cheap way to draw thousands of small things.
+        void submitCube(Vector3 center, Vector3 size, Color color);
+
+        // Sort and draw everything. Must be called inside BeginMode3D/EndMode3D.
+        void execute();
+
+        const RenderStats& getStats() const { return stats; }
+        size_t size() const { return packets.size(); }
+
+        static uint64_t makeKey(RenderLayer layer, uint32_t shader, uint32_t material,
+                                uint32_t texture, uint32_t mesh, float depth);
+
+    private:
+        uint32_t getMaterialId(const Material* material);
+        float getDepth(const Matrix& world) const;
+
+        std::vector<DrawPacket> packets;
+        std::vector<const Material*> materialIds; // Index = small id used in the sort key
+
+        Vector3 viewPosition = { 0, 0, 0 };
+        RenderStats stats;
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "raylib.h"
+#include "Collision.hpp"
+#include "JobSystem.hpp"
+#include <cfloat>
+#include <cstdint>
+#include <vector>
+
+// Seeded Poisson-disk placement of vegetation and rocks over the terrain.
+//
+// Each species is scattered by dart throwing: random spots are tried and kept
+// only if they pass the species' rules (slope, height band, density) and are
+// far enough from everything already placed. The area is cut into tiles and
+// tiles are done in four checkerboard phases, so tiles running at the same
+// time never read or write each other's neighbourhood. Every tile has its own
+// random stream derived from the seed, which makes the result the same on any
+// platform and with any number of workers.
+class Scatter {
+    public:
+        struct Species {
+            float spacing = 8.0f;       // Minimum distance between two of this species
+            float footprint = 1.0f;     // Radius other species keep clear of
+            float density = 1.0f;       // Fraction of valid darts kept, 0..1
+            float patchSize = 0.0f;     // > 0: density follows noise of this wavelength, so plants clump
+            float slopeLimit = 0.75f;   // Lowest ground normal.y allowed
+            float minHeight = -FLT_MAX;
+            float maxHeight = FLT_MAX;
+            float minScale = 1.0f;
+            float maxScale = 1.0f;
+            float attempts = 3.0f;      // Darts per spacing-sized square
+        };
+
+        struct Instance {
+            Vector3 position;
+            Vector3 normal;             // Ground normal under the instance
+            float scale;
+            float yaw;                  // Degrees
+            int species;
+        };
+
+        struct Settings {
+            uint32_t seed = 1;
+            float tileSize = 32.0f;     // Smallest tile, grown to fit the spacing
+        };
+
+        Settings settings;
+
+        // Species are scattered in the order they were added, later ones
+        // keep clear of the footprints of earlier ones
+        int addSpecies(const Species& species);
+
+        // Nothing is placed inside this circle
+        void addExclusion(Vector2 center, float radius);
+
+        void clear();
+
+        // Scatter every species over area (x, z, width, height). out is replaced
+        // with the instances, grouped by species, in a stable order.
+        void run(const TerrainCollider& terrain, Rectangle area, JobSystem& jobs, std::vector<Instance>& out);
+
+    private:
+        // Accepted instances of one species, on a grid with at most one per cell
+        // (cells are spacing / sqrt(2) wide) and tiles a whole number of cells
+        struct Layer {
+            Species species;
+            float cellSize = 1.0f;
+            int cellsPerTile = 2;
+            int cellsX = 0;
+            int cellsZ = 0;
+            std::vector<int32_t> cells;             // Index into the tile's list, -1 if empty
+            std::vector<std::vector<Instance>> tiles;
+        };
+
+        struct Exclusion {
+            Vector2 center;
+            float radius;
+        };
+
+        void scatterTile(int layerIndex, int tileX, int tileZ, const TerrainCollider& terrain);
+        bool isClear(int layerIndex, float x, float z) const;
+        float patchNoise(int layerIndex, float x, float z) const;
+
+        std::vector<Layer> layers;
+        std::vector<Exclusion> exclusions;
+        Rectangle area = { 0, 0, 0, 0 };
+};
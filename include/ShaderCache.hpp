@@ -0,0 +1,73 @@
+#pragma once
+
+#include "raylib.h"
+#include "AssetCache.hpp"
+#include "JobSystem.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Every shader the game uses, as variants of a few GLSL files told apart by
+// #defines (PACKED_VERTICES, ...), built together at load time.
+//
+//     int terrain = shaders.add("assets/shaders/terrain.vs", "assets/shaders/terrain.fs");
+//     int packed = shaders.add("assets/shaders/terrain.vs", "assets/shaders/terrain.fs", { "PACKED_VERTICES" });
+//     shaders.build(jobs, assetCache);
+//     Shader s = shaders.get(terrain);
+//
+// Sources are read and hashed on the workers. Then every variant's compile
+// and link is handed to the driver before any status is asked for, so
+// drivers with parallel shader compilation work on them side by side. Linked
+// programs go into the asset cache keyed by the driver and the exact source,
+// and later launches load those instead of compiling at all.
+class ShaderCache {
+    public:
+        struct Stats {
+            int variants = 0;
+            int cached = 0;         // Loaded as program binaries
+            int compiled = 0;
+            int failed = 0;         // Fell back to raylib's default shader
+            float milliseconds = 0.0f;
+        };
+
+        // Queue a variant, returns its handle. A null path is the stage of
+        // raylib's default shader (model.vs / model.fs). Defines are whatever
+        // follows "#define ", so "QUALITY 2" works too.
+        int add(const char* vsPath, const char* fsPath, const std::vector<std::string>& defines = {});
+
+        // Builds everything added since the last call. GL thread only.
+        void build(JobSystem& jobs, const AssetCache& cache);
+
+        // The caller owns the result, just like a LoadShader() one
+        Shader get(int handle);
+
+        // Unloads the variants nobody asked for (a packed one on a float
+        // vertex run, say). Call once loading is done.
+        void releaseUnused();
+
+        const Stats& getStats() const { return stats; }
+
+    private:
+        struct Variant {
+            std::string vsPath, fsPath;
+            std::vector<std::string> defines;
+            std::string vsSource, fsSource;     // Defines inserted, dropped after the build
+            std::string entryName;              // In the asset cache
+            uint64_t key = 0;                   // Driver and source hash
+            uint32_t binaryFormat = 0;
+            std::vector<uint8_t> binary;        // Cached program, if there was one
+            unsigned int vs = 0, fs = 0, program = 0;
+            Shader shader = {};
+            bool built = false;
+            bool taken = false;
+        };
+
+        void prepare(Variant& v, uint64_t driverKey, const AssetCache& cache, bool useBinaries);
+        bool loadBinary(Variant& v);
+        void startCompile(Variant& v);
+        void startLink(Variant& v, bool useBinaries);
+        bool finishLink(Variant& v, const AssetCache& cache, bool useBinaries);
+
+        std::vector<Variant> variants;
+        Stats stats;
+};
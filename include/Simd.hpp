@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #define SIMD_SSE 1
+    #include <emmintrin.h>
+#endif
+
+namespace simd {
+    // Four floats at a time. SSE where we have it, plain loops otherwise, so
+    // kernels are written once. Masks are all-ones/all-zeros lanes. Both
+    // versions do the same IEEE operations in the same order, so they give
+    // bit-identical results (seeded generation relies on that).
+#if defined(SIMD_SSE)
+    struct F4 {
+        __m128 v;
+
+        static F4 load(const float* p) { return { _mm_loadu_ps(p) }; }
+        static F4 set1(float x) { return { _mm_set1_ps(x) }; }
+        static F4 set(float a, float b, float c, float d) { return { _mm_setr_ps(a, b, c, d) }; }
+        void store(float* p) const { _mm_storeu_ps(p, v); }
+
+        friend F4 operator+(F4 a, F4 b) { return { _mm_add_ps(a.v, b.v) }; }
+        friend F4 operator-(F4 a, F4 b) { return { _mm_sub_ps(a.v, b.v) }; }
+        friend F4 operator*(F4 a, F4 b) { return { _mm_mul_ps(a.v, b.v) }; }
+        friend F4 operator/(F4 a, F4 b) { return { _mm_div_ps(a.v, b.v) }; }
+
+        // On NaN or a tie (+0 against -0) these give b
+        friend F4 min(F4 a, F4 b) { return { _mm_min_ps(a.v, b.v) }; }
+        friend F4 max(F4 a, F4 b) { return { _mm_max_ps(a.v, b.v) }; }
+        friend F4 sqrt(F4 a) { return { _mm_sqrt_ps(a.v) }; }
+        friend F4 abs(F4 a) { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v) }; }
+
+        // Truncate, then step down where that rounded up (negative inputs).
+        // The int round trip loses the sign of -0.0 and of -0.x before the
+        // step, so it goes back on from the input: a negative input always
+        // floors to a negative (or -0) result. From 2^23 up every float is
+        // already whole and the round trip would overflow, so those (and
+        // inf/NaN) pass through. Same bits as floorf everywhere.
+        friend F4 floor(F4 a) {
+            __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(a.v));
+            __m128 r = _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, a.v), _mm_set1_ps(1.0f)));
+            r = _mm_or_ps(r, _mm_and_ps(a.v, _mm_set1_ps(-0.0f)));
+            __m128 small = _mm_cmplt_ps(_mm_andnot_ps(_mm_set1_ps(-0.0f), a.v), _mm_set1_ps(8388608.0f));
+            return { _mm_or_ps(_mm_and_ps(small, r), _mm_andnot_ps(small, a.v)) };
+        }
+
+        friend F4 lessThan(F4 a, F4 b) { return { _mm_cmplt_ps(a.v, b.v) }; }
+        friend F4 greaterThan(F4 a, F4 b) { return { _mm_cmpgt_ps(a.v, b.v) }; }
+        friend F4 operator&(F4 a, F4 b) { return { _mm_and_ps(a.v, b.v) }; }
+
+        // a where mask is set, 0 elsewhere (also clears NaN/inf in masked lanes)
+        friend F4 select(F4 mask, F4 a) { return { _mm_and_ps(mask.v, a.v) }; }
+
+        float sum() const {
+            __m128 s = _mm_add_ps(v, _mm_movehl_ps(v, v));
+            s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+            return _mm_cvtss_f32(s);
+        }
+    };
+#else
+    struct F4 {
+        float v[4];
+
+        static F4 load(const float* p) { F4 r; for (int i = 0; i < 4; i++) r.v[i] = p[i]; return r; }
+        static F4 set1(float x) { F4 r; for (int i = 0; i < 4; i++) r.v[i] = x; return r; }
+        static F4 set(float a, float b, float c, float d) { return { { a, b, c, d } }; }
+        void store(float* p) const { for (int i = 0; i < 4; i++) p[i] = v[i]; }
+
+        template <typename Op>
+        static F4 map(F4 a, F4 b, Op op) { F4 r; for (int i = 0; i < 4; i++) r.v[i] = op(a.v[i], b.v[i]); return r; }
+
+        friend F4 operator+(F4 a, F4 b) { return map(a, b, [](float x, float y) { return x + y; }); }
+        friend F4 operator-(F4 a, F4 b) { return map(a, b, [](float x, float y) { return x - y; }); }
+        friend F4 operator*(F4 a, F4 b) { return map(a, b, [](float x, float y) { return x * y; }); }
+        friend F4 operator/(F4 a, F4 b) { return map(a, b, [](float x, float y) { return x / y; }); }
+
+        // minps/maxps exactly, NaN and signed zero included
+        friend F4 min(F4 a, F4 b) { return map(a, b, [](float x, float y) { return x < y ? x : y; }); }
+        friend F4 max(F4 a, F4 b) { return map(a, b, [](float x, float y) { return x > y ? x : y; }); }
+        friend F4 sqrt(F4 a) { F4 r; for (int i = 0; i < 4; i++) r.v[i] = sqrtf(a.v[i]); return r; }
+        friend F4 abs(F4 a) { F4 r; for (int i = 0; i < 4; i++) r.v[i] = fabsf(a.v[i]); return r; }
+        friend F4 floor(F4 a) { F4 r; for (int i = 0; i < 4; i++) r.v[i] = floorf(a.v[i]); return r; }
+
+        friend F4 lessThan(F4 a, F4 b) { return map(a, b, [](float x, float y) { return x < y ? 1.0f : 0.0f; }); }
+        friend F4 greaterThan(F4 a, F4 b) { return map(a, b, [](float x, float y) { return x > y ? 1.0f : 0.0f; }); }
+        friend F4 operator&(F4 a, F4 b) { return map(a, b, [](float x, float y) { return (x != 0.0f && y != 0.0f) ? 1.0f : 0.0f; }); }
+
+        friend F4 select(F4 mask, F4 a) { return map(mask, a, [](float m, float x) { return m != 0.0f ? x : 0.0f; }); }
+
+        // Pairs the lanes the way the SSE shuffle does
+        float sum() const { return (v[0] + v[2]) + (v[1] + v[3]); }
+    };
+#endif
+}
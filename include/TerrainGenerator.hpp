@@ -0,0 +1,53 @@
+#pragma once
+
+#include "raylib.h"
+#include "Collision.hpp"
+#include "JobSystem.hpp"
+#include <cstdint>
+#include <vector>
+
+// Procedural maps, for testing on terrain nobody had to author.
+//
+// Heights are fractal gradient noise (plus a ridged share for mountain
+// crests), evaluated four samples at a time, then worn down by a few passes
+// of thermal erosion and smoothing. All of it runs in chunks on the job
+// system. The result is a Heightfield for collision and one render mesh per
+// chunk; the same seed gives the same map on every platform.
+class TerrainGenerator {
+    public:
+        struct Settings {
+            uint32_t seed = 1;
+            float size = 1000.0f;           // Side of the square map, centred on the origin
+            float spacing = 2.0f;           // Distance between height samples
+            int chunkQuads = 64;            // Quads per chunk side, one mesh each (65^2 vertices fits 16-bit indices)
+
+            int octaves = 6;
+            float wavelength = 600.0f;      // Of the first octave
+            float lacunarity = 2.0f;
+            float gain = 0.5f;
+            float amplitude = 400.0f;       // Heights stay within +-amplitude
+            float ridges = 0.35f;           // 0: rolling hills, 1: all ridged crests
+
+            int erosionPasses = 8;
+            float talus = 0.9f;             // Steepest slope that doesn't crumble (rise over run)
+            int smoothPasses = 1;
+        };
+
+        struct Chunk {
+            Mesh mesh;                      // CPU side only, UploadMesh() on the GL thread
+            BoundingBox bounds;
+        };
+
+        Settings settings;
+
+        void generate(JobSystem& jobs, Heightfield& out) const;
+
+        // One indexed mesh per chunk (positions and smooth normals), matching
+        // the heightfield's triangulation exactly
+        void buildChunks(const Heightfield& field, JobSystem& jobs, std::vector<Chunk>& out) const;
+
+    private:
+        void generateHeights(JobSystem& jobs, Heightfield& field) const;
+        void erode(JobSystem& jobs, Heightfield& field) const;
+        void smooth(JobSystem& jobs, Heightfield& field) const;
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "raylib.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// UI text drawn from a signed distance field atlas.
+//
+// The TTF is baked once at startup into an SDF glyph atlas, which stays sharp
+// at any size since the edge is rebuilt per pixel in sdf.fs. Layouts for
+// strings we draw every frame ("PAUSED", "RESUME", ...) are cached, and all
+// text queued between begin() and flush() goes out as one textured draw call.
+class TextRenderer {
+    public:
+        ~TextRenderer();
+
+        // bakeSize is the pixel height glyphs are rasterised at in the atlas.
+        // sdfShader is sdf.fs on raylib's default vertex stage, and is ours to unload.
+        bool init(const char* fontPath, Shader sdfShader, int bakeSize = 48);
+        void shutdown();
+
+        Vector2 measure(const char* text, float fontSize, bool cacheLayout = true);
+
+        // Queue text for this frame's batch. Top-left anchored.
+        void draw(const char* text, Vector2 position, float fontSize, Color color, bool cacheLayout = true);
+
+        // Queue text centred on a point
+        void drawCentered(const char* text, Vector2 center, float fontSize, Color color, bool cacheLayout = true);
+
+        // Draw every queued glyph in a single batch
+        void flush();
+
+        bool isReady() const { return ready; }
+
+    private:
+        struct GlyphQuad {
+            Rectangle dest;     // In bake-size units, relative to the text origin
+            Rectangle source;   // Pixels in the atlas
+        };
+
+        struct TextLayout {
+            std::vector<GlyphQuad> quads;
+            Vector2 size = { 0, 0 };
+        };
+
+        struct QueuedText {
+            size_t firstQuad;
+            size_t quadCount;
+            Vector2 position;
+            float scale;
+            Color color;
+        };
+
+        const TextLayout& getLayout(const char* text, bool cacheLayout);
+        void buildLayout(const char* text, TextLayout& out) const;
+        int getGlyphIndex(int codepoint) const;
+
+        Font font = {};
+        Shader sdfShader = {};
+        bool ready = false;
+
+        std::unordered_map<std::string, TextLayout> layoutCache;
+        std::string lookupKey;      // Reused, so a cache hit doesn't allocate a key
+        TextLayout scratchLayout;   // For strings that change every frame
+
+        // This frame's batch. Quads are copied in so cache entries can move freely.
+        std::vector<GlyphQuad> batchQuads;
+        std::vector<QueuedText> batch;
+};
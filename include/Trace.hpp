@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+// Session capture in Chrome's trace event format, which chrome://tracing and
+// Perfetto (ui.perfetto.dev) both open.
+//
+// Each thread appends its events to its own single-producer ring (no locks,
+// and no allocation after the thread's first event), and a background
+// thread drains the rings into the file every few milliseconds. Profiler
+// scopes feed it, so anything marked with PROFILE_SCOPE shows up on the
+// timeline under the thread that ran it.
+namespace trace {
+    namespace detail {
+        extern std::atomic<bool> recording;
+    }
+
+    inline bool isRecording() { return detail::recording.load(std::memory_order_relaxed); }
+
+    // Record into path until frameCount frames have ended (0: until stop()).
+    // Returns false if a session is already running or the file won't open.
+    bool start(const char* path, int frameCount);
+
+    // The writer finishes the file in the background
+    void stop();
+
+    // Stop, and wait until the file is complete. Call before exit.
+    void shutdown();
+
+    // Label for the calling thread's row. Must outlive the session.
+    void setThreadName(const char* name);
+
+    // A finished span on the calling thread. name must be a string literal
+    // (it's written later, from another thread, without escaping).
+    void record(const char* name, std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end);
+
+    // Main thread, once per frame: adds a "frame" span and counts down the limit
+    void endFrame();
+
+    // Back-to-back spans through a long function, without a block per step:
+    //
+    //     trace::Phases phases;
+    //     phases.begin("map");
+    //     ...
+    //     phases.begin("fences");     // ends "map"
+    //
+    // With log set, each finished phase is also written to the log with its
+    // time, traced or not.
+    class Phases {
+        public:
+            explicit Phases(bool log = false) : log(log) {}
+            ~Phases() { end(); }
+
+            void begin(const char* name);
+            void end();
+
+        private:
+            bool log;
+            const char* current = nullptr;
+            std::chrono::steady_clock::time_point started;
+    };
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "raylib.h"
+#include "TextRenderer.hpp"
+#include <string>
+#include <vector>
+
+enum class WidgetType {
+    Overlay,    // Full screen tint
+    Panel,      // Plain filled box
+    Button,
+    Label,
+    Slider,
+    Crosshair
+};
+
+// A widget is described in screen fractions and laid out to pixels whenever
+// the screen size changes, so menus survive resolution changes.
+struct UIWidget {
+    WidgetType type = WidgetType::Panel;
+
+    Vector2 anchor = { 0.5f, 0.5f };    // Centre, as a fraction of the screen
+    Vector2 size = { 0.0f, 0.0f };      // x = fraction of width, y = fraction of height
+    Vector2 handleSize = { 0.0f, 0.0f };// Sliders only
+
+    std::string text;
+    float textSize = 0.0f;              // Fraction of screen height
+    Color color = WHITE;
+    Color textColor = WHITE;
+
+    // Cached widgets are drawn into the screen's panel texture and only
+    // re-rendered when something about them changes
+    bool cached = true;
+    bool visible = true;
+
+    // Text that is rewritten at runtime (readouts, counters) skips the text
+    // renderer's layout cache, which would otherwise fill with one entry per
+    // value. setText() turns this on.
+    bool dynamicText = false;
+    float value = 0.0f;                 // Sliders, 0.0 to 1.0
+
+    // Pixels, rebuilt by layout()
+    Rectangle bounds = { 0, 0, 0, 0 };
+    Rectangle handle = { 0, 0, 0, 0 };
+};
+
+// A retained set of widgets (one menu, or the HUD).
+class UIScreen {
+    public:
+        ~UIScreen();
+
+        int add(const UIWidget& widget);
+        const UIWidget& get(int id) const { return widgets[id]; }
+
+        // Setters only invalidate the cache when the value really changes
+        void setText(int id, const std::string& text);
+        void setValue(int id, float value);
+        void setVisible(int id, bool visible);
+
+        // Mouse handling. Call once per frame while the screen is active.
+        void update();
+
+        bool wasClicked(int id) const { return clickedId == id; }
+        bool isDragging(int id) const { return draggingId == id; }
+
+        // Blit the cached panel (re-rendering it first if dirty), then draw the
+        // uncached widgets with all their text in one batch
+        void draw(TextRenderer& text);
+
+        void unload();
+
+    private:
+        void layout(int screenWidth, int screenHeight);
+        void drawWidget(const UIWidget& widget, TextRenderer& text) const;
+        void rebuildCache(TextRenderer& text);
+        void invalidate(const UIWidget& widget);
+
+        std::vector<UIWidget> widgets;
+
+        RenderTexture2D cache = {};
+        bool dirty = true;
+        int layoutWidth = 0;
+        int layoutHeight = 0;
+
+        int clickedId = -1;
+        int draggingId = -1;
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "raylib.h"
+#include <cstddef>
+#include <cstdint>
+
+// Compact vertex buffers: 16 bytes a vertex instead of raylib's 32.
+//
+//   position  3 x unorm16 (+ pad)  0..1 across the model's bounds
+//   normal    2 x snorm16          octahedral
+//   texcoord  2 x half float
+//
+// Positions need no shader work: the 0..1 -> bounds scale and offset is
+// folded into model.transform, so the usual mvp/matModel do the decode.
+// Normals are pre-scaled to match, which makes matNormal (not matModel)
+// the right matrix for them. Shaders drawing packed meshes are built with
+// PACKED_VERTICES defined (a ShaderCache variant) and decode the octahedral
+// normal themselves.
+namespace VertexPacking {
+    struct Vertex {
+        uint16_t position[4];
+        int16_t normal[2];
+        uint16_t texcoord[2];
+    };
+
+    struct Stats {
+        int meshes = 0;
+        size_t floatBytes = 0;      // What raylib had uploaded
+        size_t packedBytes = 0;
+    };
+
+    // Re-uploads every mesh of an uploaded model in the packed layout and
+    // folds the position decode into model.transform. Needs the CPU arrays,
+    // so bounds and collision copies should be taken first. Materials still
+    // on raylib's default shader are switched to defaultShader (if it has an
+    // id). Returns false and leaves the model alone if it can't be packed:
+    // vertex colours, skinning, or no VAO support.
+    bool packModel(Model& model, Shader defaultShader, Stats& stats);
+
+    // Exposed for tests and tools
+    void encodeOctahedral(Vector3 normal, int16_t out[2]);
+    uint16_t toHalf(float value);
+}
@@ -0,0 +1,89 @@
+#include "AssetCache.hpp"
+#include <cstdio>
+#include <filesystem>
+
+namespace {
+    struct EntryHeader {
+        char magic[4];      // "DJOC"
+        uint32_t version;
+        uint64_t key;
+        uint64_t size;
+    };
+
+    const uint32_t kCacheVersion = 1;
+}
+
+std::string AssetCache::pathFor(const std::string& name) const {
+    return directory + "/" + name + ".bin";
+}
+
+uint64_t AssetCache::hash(const void* data, size_t size, uint64_t seed) {
+    const uint8_t* p = (const uint8_t*)data;
+    uint64_t h = seed;
+    for (size_t i = 0; i < size; i++) {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+bool AssetCache::load(const std::string& name, uint64_t key, std::vector<uint8_t>& data) const {
+    std::string path = pathFor(name);
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) return false;
+
+    EntryHeader header;
+    bool ok = fread(&header, sizeof(header), 1, file) == 1 &&
+              memcmp(header.magic, "DJOC", 4) == 0 &&
+              header.version == kCacheVersion &&
+              header.key == key;
+
+    // The header's size has to account for exactly the rest of the file
+    // before anything is allocated for it. A crash mid-store or a damaged
+    // disk can leave any number there.
+    bool damaged = false;
+    if (ok) {
+        std::error_code error;
+        uint64_t fileSize = (uint64_t)std::filesystem::file_size(path, error);
+        damaged = error || fileSize < sizeof(header) || header.size != fileSize - sizeof(header);
+        ok = !damaged;
+    }
+
+    if (ok) {
+        data.resize((size_t)header.size);
+        ok = header.size == 0 || fread(data.data(), 1, data.size(), file) == data.size();
+    }
+
+    fclose(file);
+    if (!ok) data.clear();
+
+    // A miss, and one the next store shouldn't have to race
+    if (damaged) {
+        std::error_code error;
+        std::filesystem::remove(path, error);
+    }
+    return ok;
+}
+
+bool AssetCache::store(const std::string& name, uint64_t key, const std::vector<uint8_t>& data) const {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+
+    std::string path = pathFor(name);
+    std::string temp = path + ".tmp";
+
+    FILE* file = fopen(temp.c_str(), "wb");
+    if (!file) return false;
+
+    EntryHeader header = { { 'D', 'J', 'O', 'C' }, kCacheVersion, key, (uint64_t)data.size() };
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              (data.empty() || fwrite(data.data(), 1, data.size(), file) == data.size());
+    ok = (fclose(file) == 0) && ok;
+
+    if (ok) {
+        std::filesystem::rename(temp, path, error);
+        ok = !error;
+    }
+    if (!ok) std::filesystem::remove(temp, error);
+    return ok;
+}
@@ -0,0 +1,42 @@
+#include "Ball.hpp"
+#include "raymath.h"
+
+void Ball::integrate(float deltaTime, const CollisionWorld& world) {
+    // 1. Apply Gravity
+    velocity.y -= 15.0f * deltaTime;
+
+    // 2. Air Friction (Damping) - Slows it down over time
+    velocity = Vector3Scale(velocity, 0.995f);
+
+    // 3. Move with continuous collision: sweep the ball along this frame's
+    // motion, stop at the first contact, bounce, then spend what's left of the
+    // frame from there. A fast kick can't skip over a ridge or fence this way.
+    float remaining = 1.0f;
+    for (int i = 0; i < 4 && remaining > 0.0f; i++) {
+        Vector3 motion = Vector3Scale(velocity, deltaTime * remaining);
+
+        SweepHit hit;
+        if (!world.sweepSphere(position, motion, radius, hit)) {
+            position = Vector3Add(position, motion);
+            break;
+        }
+
+        // Stop at the time of impact, nudged off the surface so the next sweep starts clear
+        position = Vector3Add(position, Vector3Scale(motion, hit.t));
+        position = Vector3Add(position, Vector3Scale(hit.normal, 0.001f));
+
+        float intoSurface = Vector3DotProduct(velocity, hit.normal);
+        if (intoSurface < 0.0f) {
+            if (intoSurface > -1.0f) {
+                // Barely moving into it: settle and roll instead of micro-bouncing
+                velocity = Vector3Subtract(velocity, Vector3Scale(hit.normal, intoSurface));
+            } else {
+                // Reflect velocity based on the contact normal and apply bounciness
+                velocity = Vector3Reflect(velocity, hit.normal);
+                velocity = Vector3Scale(velocity, restitution);
+            }
+        }
+
+        remaining *= (1.0f - hit.t);
+    }
+}
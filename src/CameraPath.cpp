@@ -0,0 +1,86 @@
+#include "CameraPath.hpp"
+#include "raymath.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+    float catmullRom(float p0, float p1, float p2, float p3, float t) {
+        float t2 = t * t, t3 = t2 * t;
+        return 0.5f * ((2.0f * p1) + (p2 - p0) * t + (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t2 + (3.0f * p1 - p0 - 3.0f * p2 + p3) * t3);
+    }
+}
+
+bool CameraPath::load(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (!file) return false;
+
+    clear();
+    char line[256];
+    while (fgets(line, sizeof(line), file)) {
+        if (line[0] == '#') continue;
+
+        Key key;
+        if (sscanf(line, "%f %f %f %f %f", &key.position.x, &key.position.y, &key.position.z, &key.yaw, &key.pitch) == 5) add(key);
+    }
+    fclose(file);
+
+    return keys.size() >= 2;
+}
+
+bool CameraPath::save(const char* path) const {
+    FILE* file = fopen(path, "w");
+    if (!file) return false;
+
+    fprintf(file, "# Camera path: x y z yaw pitch (degrees), one key per line\n");
+    for (const Key& key : keys) {
+        fprintf(file, "%.2f %.2f %.2f %.2f %.2f\n", key.position.x, key.position.y, key.position.z, key.yaw, key.pitch);
+    }
+    fclose(file);
+    return true;
+}
+
+void CameraPath::add(Key key) {
+    if (keys.empty()) {
+        keys.push_back(key);
+        startTimes.push_back(0.0f);
+        return;
+    }
+
+    const Key& last = keys.back();
+    while (key.yaw - last.yaw > 180.0f) key.yaw -= 360.0f;
+    while (key.yaw - last.yaw < -180.0f) key.yaw += 360.0f;
+
+    // Segments with no length still get a moment, so a turn on the spot plays out
+    float length = Vector3Distance(last.position, key.position);
+    startTimes.push_back(startTimes.back() + fmaxf(length / speed, 0.5f));
+    keys.push_back(key);
+}
+
+void CameraPath::clear() {
+    keys.clear();
+    startTimes.clear();
+}
+
+CameraPath::Key CameraPath::sample(float time) const {
+    if (keys.empty()) return { { 0, 0, 0 }, 0.0f, 0.0f };
+    if (keys.size() == 1 || time <= 0.0f) return keys.front();
+    if (time >= getDuration()) return keys.back();
+
+    // 1. The segment we're in and how far along it
+    int i = (int)(std::upper_bound(startTimes.begin(), startTimes.end(), time) - startTimes.begin()) - 1;
+    float t = (time - startTimes[i]) / (startTimes[i + 1] - startTimes[i]);
+
+    // 2. Its neighbours shape the curve, the ends repeat themselves
+    const Key& k0 = keys[std::max(i - 1, 0)];
+    const Key& k1 = keys[i];
+    const Key& k2 = keys[i + 1];
+    const Key& k3 = keys[std::min(i + 2, (int)keys.size() - 1)];
+
+    Key out;
+    out.position.x = catmullRom(k0.position.x, k1.position.x, k2.position.x, k3.position.x, t);
+    out.position.y = catmullRom(k0.position.y, k1.position.y, k2.position.y, k3.position.y, t);
+    out.position.z = catmullRom(k0.position.z, k1.position.z, k2.position.z, k3.position.z, t);
+    out.yaw = catmullRom(k0.yaw, k1.yaw, k2.yaw, k3.yaw, t);
+    out.pitch = Clamp(catmullRom(k0.pitch, k1.pitch, k2.pitch, k3.pitch, t), -89.0f, 89.0f);
+    return out;
+}
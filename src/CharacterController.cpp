@@ -0,0 +1,115 @@
+#include "CharacterController.hpp"
+#include "raymath.h"
+#include <cmath>
+
+bool CharacterController::sweep(const CollisionWorld& world, Vector3 feet, float height, Vector3 motion, SweepHit& hit) const {
+    float r = settings.radius;
+    float bottom = r;
+    float top = fmaxf(bottom, height - r);
+
+    // Spheres closer than one radius apart leave no gap a thin edge could slip through
+    int count = (int)ceilf((top - bottom) / r) + 1;
+
+    bool found = false;
+    for (int i = 0; i < count; i++) {
+        float offset = (count == 1) ? bottom : bottom + (top - bottom) * (float)i / (float)(count - 1);
+        Vector3 center = { feet.x, feet.y + offset, feet.z };
+        if (world.sweepSphere(center, motion, r, hit)) found = true;
+    }
+    return found;
+}
+
+Vector3 CharacterController::slide(const CollisionWorld& world, Vector3 feet, float height, Vector3 motion) const {
+    for (int i = 0; i < settings.maxSlides; i++) {
+        float len = Vector3Length(motion);
+        if (len < 1e-5f) break;
+
+        SweepHit hit;
+        if (!sweep(world, feet, height, motion, hit)) {
+            feet = Vector3Add(feet, motion);
+            break;
+        }
+
+        // 1. Move up to the contact and step back off the surface a little
+        float travel = fmaxf(0.0f, hit.t * len - settings.skin);
+        feet = Vector3Add(feet, Vector3Scale(motion, travel / len));
+        feet = Vector3Add(feet, Vector3Scale(hit.normal, settings.skin));
+
+        // 2. Walls and too-steep slopes act as vertical planes, so sliding
+        // along them never lifts us (same slopeLimit as standing)
+        Vector3 n = hit.normal;
+        if (n.y < settings.slopeLimit) {
+            Vector3 flat = { n.x, 0.0f, n.z };
+            if (Vector3LengthSqr(flat) > 1e-8f) n = Vector3Normalize(flat);
+        }
+
+        // 3. Whatever motion is left, minus the part going into the surface
+        Vector3 rest = Vector3Scale(motion, 1.0f - hit.t);
+        float into = Vector3DotProduct(rest, n);
+        if (into < 0.0f) rest = Vector3Subtract(rest, Vector3Scale(n, into));
+        motion = rest;
+    }
+
+    return feet;
+}
+
+Vector3 CharacterController::moveHorizontal(const CollisionWorld& world, Vector3 feet, float height, Vector3 displacement, bool grounded) const {
+    displacement.y = 0.0f;
+    Vector3 plain = slide(world, feet, height, displacement);
+
+    float wanted = Vector2Length({ displacement.x, displacement.z });
+    float got = Vector2Length({ plain.x - feet.x, plain.z - feet.z });
+
+    // Only try stepping when we're on the ground and something stopped us
+    if (!grounded || wanted < 1e-4f || got >= wanted * 0.9f) return plain;
+
+    // Step up: lift, walk, then drop back down onto whatever we walked over
+    SweepHit upHit;
+    bool blocked = false;
+    Vector3 raised = moveVertical(world, feet, height, settings.stepHeight, upHit, blocked);
+    Vector3 stepped = slide(world, raised, height, displacement);
+
+    SweepHit downHit;
+    float lifted = raised.y - feet.y;
+    Vector3 landed = moveVertical(world, stepped, height, -(lifted + settings.snapDistance), downHit, blocked);
+
+    // Nothing to land on, or it's too steep to stand on
+    if (!blocked || downHit.normal.y < settings.slopeLimit) return plain;
+
+    float steppedDist = Vector2Length({ landed.x - feet.x, landed.z - feet.z });
+    return (steppedDist > got + 0.001f) ? landed : plain;
+}
+
+Vector3 CharacterController::moveVertical(const CollisionWorld& world, Vector3 feet, float height, float dy, SweepHit& hit, bool& blocked) const {
+    hit = SweepHit{};
+    Vector3 motion = { 0.0f, dy, 0.0f };
+
+    blocked = sweep(world, feet, height, motion, hit);
+    if (!blocked) return Vector3Add(feet, motion);
+
+    float len = fabsf(dy);
+    float travel = fmaxf(0.0f, hit.t * len - settings.skin);
+    feet.y += (dy > 0.0f) ? travel : -travel;
+    return feet;
+}
+
+CharacterController::GroundInfo CharacterController::probeGround(const CollisionWorld& world, Vector3 feet, float height) const {
+    GroundInfo ground;
+
+    float probe = settings.snapDistance + settings.skin;
+    SweepHit hit;
+    if (!sweep(world, feet, height, { 0.0f, -probe, 0.0f }, hit)) return ground;
+
+    ground.hit = true;
+    ground.distance = hit.t * probe;
+    ground.normal = hit.normal;
+    ground.walkable = (hit.normal.y >= settings.slopeLimit);
+    return ground;
+}
+
+bool CharacterController::canGrow(const CollisionWorld& world, Vector3 feet, float height, float newHeight) const {
+    if (newHeight <= height) return true;
+
+    SweepHit hit;
+    return !sweep(world, feet, height, { 0.0f, newHeight - height, 0.0f }, hit);
+}
@@ -0,0 +1,492 @@
+#include "Collision.hpp"
+#include "raymath.h"
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+namespace {
+    // Smallest root of a*t^2 + b*t + c = 0 in (0, maxR)
+    bool getLowestRoot(float a, float b, float c, float maxR, float& root) {
+        if (fabsf(a) < 1e-12f) return false;
+
+        float det = b*b - 4.0f*a*c;
+        if (det < 0.0f) return false;
+
+        float sqrtD = sqrtf(det);
+        float r1 = (-b - sqrtD) / (2.0f*a);
+        float r2 = (-b + sqrtD) / (2.0f*a);
+        if (r1 > r2) std::swap(r1, r2);
+
+        if (r1 > 0.0f && r1 < maxR) { root = r1; return true; }
+        if (r2 > 0.0f && r2 < maxR) { root = r2; return true; }
+        return false;
+    }
+
+    bool pointInTriangle(Vector3 p, Vector3 a, Vector3 b, Vector3 c) {
+        Vector3 v0 = Vector3Subtract(c, a);
+        Vector3 v1 = Vector3Subtract(b, a);
+        Vector3 v2 = Vector3Subtract(p, a);
+
+        float d00 = Vector3DotProduct(v0, v0);
+        float d01 = Vector3DotProduct(v0, v1);
+        float d02 = Vector3DotProduct(v0, v2);
+        float d11 = Vector3DotProduct(v1, v1);
+        float d12 = Vector3DotProduct(v1, v2);
+
+        float denom = d00*d11 - d01*d01;
+        if (fabsf(denom) < 1e-12f) return false;
+
+        float u = (d11*d02 - d01*d12) / denom;
+        float v = (d00*d12 - d01*d02) / denom;
+        return (u >= 0.0f) && (v >= 0.0f) && (u + v <= 1.0f);
+    }
+}
+
+bool sweepSphereTriangle(Vector3 start, Vector3 motion, float radius,
+                         Vector3 a, Vector3 b, Vector3 c, SweepHit& hit) {
+    // 1. Work in "unit sphere space" so the maths below can assume radius 1
+    float inv = 1.0f / radius;
+    Vector3 base = Vector3Scale(start, inv);
+    Vector3 vel = Vector3Scale(motion, inv);
+    Vector3 p1 = Vector3Scale(a, inv);
+    Vector3 p2 = Vector3Scale(b, inv);
+    Vector3 p3 = Vector3Scale(c, inv);
+
+    Vector3 n = Vector3CrossProduct(Vector3Subtract(p2, p1), Vector3Subtract(p3, p1));
+    float len = Vector3Length(n);
+    if (len < 1e-12f) return false; // Degenerate triangle
+    n = Vector3Scale(n, 1.0f / len);
+
+    // Only the front face counts, we can't hit a triangle we're moving away from
+    float nDotV = Vector3DotProduct(n, vel);
+    if (nDotV > 0.0f) return false;
+
+    // 2. When does the sphere touch the triangle's plane?
+    float signedDist = Vector3DotProduct(n, base) - Vector3DotProduct(n, p1);
+    float t0, t1;
+    bool embedded = false;
+
+    if (fabsf(nDotV) < 1e-6f) {
+        // Moving parallel to the plane, either always touching it or never
+        if (fabsf(signedDist) >= 1.0f) return false;
+        embedded = true;
+        t0 = 0.0f;
+        t1 = 1.0f;
+    } else {
+        t0 = (-1.0f - signedDist) / nDotV;
+        t1 = ( 1.0f - signedDist) / nDotV;
+        if (t0 > t1) std::swap(t0, t1);
+        if (t0 > 1.0f || t1 < 0.0f) return false;
+        t0 = Clamp(t0, 0.0f, 1.0f);
+        t1 = Clamp(t1, 0.0f, 1.0f);
+    }
+
+    float bestT = hit.t;
+    bool found = false;
+    Vector3 contact = { 0, 0, 0 };
+
+    // 3. Inside the face? That's always the earliest possible contact
+    if (!embedded) {
+        Vector3 planePoint = Vector3Add(Vector3Subtract(base, n), Vector3Scale(vel, t0));
+        if (pointInTriangle(planePoint, p1, p2, p3) && t0 < bestT) {
+            bestT = t0;
+            contact = planePoint;
+            found = true;
+        }
+    }
+
+    // 4. Otherwise sweep against the vertices and edges
+    if (!found) {
+        float velSq = Vector3LengthSqr(vel);
+        const Vector3 verts[3] = { p1, p2, p3 };
+
+        for (const Vector3& p : verts) {
+            float B = 2.0f * Vector3DotProduct(vel, Vector3Subtract(base, p));
+            float C = Vector3LengthSqr(Vector3Subtract(p, base)) - 1.0f;
+            float newT;
+            if (getLowestRoot(velSq, B, C, bestT, newT)) {
+                bestT = newT;
+                contact = p;
+                found = true;
+            }
+        }
+
+        for (int i = 0; i < 3; i++) {
+            Vector3 e0 = verts[i];
+            Vector3 edge = Vector3Subtract(verts[(i + 1) % 3], e0);
+            Vector3 baseToVertex = Vector3Subtract(e0, base);
+
+            float edgeSq = Vector3LengthSqr(edge);
+            float edgeDotVel = Vector3DotProduct(edge, vel);
+            float edgeDotBaseToVertex = Vector3DotProduct(edge, baseToVertex);
+
+            float A = edgeSq * -velSq + edgeDotVel*edgeDotVel;
+            float B = edgeSq * (2.0f * Vector3DotProduct(vel, baseToVertex)) - 2.0f*edgeDotVel*edgeDotBaseToVertex;
+            float C = edgeSq * (1.0f - Vector3LengthSqr(baseToVertex)) + edgeDotBaseToVertex*edgeDotBaseToVertex;
+
+            float newT;
+            if (getLowestRoot(A, B, C, bestT, newT)) {
+                // Make sure the contact is on the segment, not the infinite line
+                float f = (edgeDotVel*newT - edgeDotBaseToVertex) / edgeSq;
+                if (f >= 0.0f && f <= 1.0f) {
+                    bestT = newT;
+                    contact = Vector3Add(e0, Vector3Scale(edge, f));
+                    found = true;
+                }
+            }
+        }
+    }
+
+    if (!found) return false;
+
+    // 5. Back to world space. The normal points from the contact to the centre.
+    Vector3 centerAtHit = Vector3Scale(Vector3Add(base, Vector3Scale(vel, bestT)), radius);
+    hit.t = bestT;
+    hit.point = Vector3Scale(contact, radius);
+    hit.normal = Vector3Normalize(Vector3Subtract(centerAtHit, hit.point));
+    return true;
+}
+
+// --- TerrainCollider ---
+
+int TerrainCollider::cellX(float x) const {
+    int c = (int)((x - bounds.min.x) / cellSize);
+    return c < 0 ? 0 : (c >= cellsX ? cellsX - 1 : c);
+}
+
+int TerrainCollider::cellZ(float z) const {
+    int c = (int)((z - bounds.min.z) / cellSize);
+    return c < 0 ? 0 : (c >= cellsZ ? cellsZ - 1 : c);
+}
+
+void TerrainCollider::build(const Mesh& mesh, const Matrix& transform, float newCellSize) {
+    cellSize = newCellSize;
+    field = Heightfield();
+    vertices.clear();
+    triangles.clear();
+
+    // 1. Triangle corners in world space (indexed or not), and their bounds
+    const Vector3* verts = (const Vector3*)mesh.vertices;
+    std::vector<Vector3> corners((size_t)mesh.triangleCount * 3);
+    bounds = { { INFINITY, INFINITY, INFINITY }, { -INFINITY, -INFINITY, -INFINITY } };
+
+    for (size_t i = 0; i < corners.size(); i++) {
+        int index = mesh.indices ? mesh.indices[i] : (int)i;
+        corners[i] = Vector3Transform(verts[index], transform);
+        bounds.min = Vector3Min(bounds.min, corners[i]);
+        bounds.max = Vector3Max(bounds.max, corners[i]);
+    }
+
+    if (corners.empty()) return;
+
+    // 2. Quantise over the bounds and weld corners that land on the same
+    // step, so shared vertices are stored once whatever the source layout
+    Vector3 extent = Vector3Subtract(bounds.max, bounds.min);
+    quantStep = { fmaxf(extent.x, 1e-6f) / 65535.0f, fmaxf(extent.y, 1e-6f) / 65535.0f, fmaxf(extent.z, 1e-6f) / 65535.0f };
+
+    std::unordered_map<uint64_t, uint32_t> welded;
+    welded.reserve(corners.size() / 2);
+    auto weld = [&](Vector3 p) {
+        uint64_t qx = (uint64_t)lroundf(Clamp((p.x - bounds.min.x) / quantStep.x, 0.0f, 65535.0f));
+        uint64_t qy = (uint64_t)lroundf(Clamp((p.y - bounds.min.y) / quantStep.y, 0.0f, 65535.0f));
+        uint64_t qz = (uint64_t)lroundf(Clamp((p.z - bounds.min.z) / quantStep.z, 0.0f, 65535.0f));
+
+        auto inserted = welded.emplace(qx | (qy << 16) | (qz << 32), (uint32_t)(vertices.size() / 3));
+        if (inserted.second) {
+            vertices.push_back((uint16_t)qx);
+            vertices.push_back((uint16_t)qy);
+            vertices.push_back((uint16_t)qz);
+        }
+        return inserted.first->second;
+    };
+
+    triangles.reserve(mesh.triangleCount);
+    for (size_t i = 0; i < corners.size(); i += 3) {
+        Triangle tri;
+        tri.v[0] = weld(corners[i]);
+        tri.v[1] = weld(corners[i + 1]);
+        tri.v[2] = weld(corners[i + 2]);
+
+        // Slivers thinner than a step collapse, they couldn't be hit anyway
+        if (tri.v[0] == tri.v[1] || tri.v[1] == tri.v[2] || tri.v[0] == tri.v[2]) continue;
+        triangles.push_back(tri);
+    }
+    vertices.shrink_to_fit();
+    triangles.shrink_to_fit();
+
+    if (triangles.empty()) return;
+
+    cellsX = std::max(1, (int)ceilf((bounds.max.x - bounds.min.x) / cellSize));
+    cellsZ = std::max(1, (int)ceilf((bounds.max.z - bounds.min.z) / cellSize));
+
+    // 3. Count how many triangles touch each cell, then bucket them (CSR
+    // layout). Cells come from the quantised corners, what queries will see.
+    cellStart.assign((size_t)cellsX * cellsZ + 1, 0);
+
+    auto forEachCell = [this](const Triangle& tri, auto fn) {
+        Vector3 a = vertex(tri.v[0]), b = vertex(tri.v[1]), c = vertex(tri.v[2]);
+        int x0 = cellX(fminf(a.x, fminf(b.x, c.x)));
+        int x1 = cellX(fmaxf(a.x, fmaxf(b.x, c.x)));
+        int z0 = cellZ(fminf(a.z, fminf(b.z, c.z)));
+        int z1 = cellZ(fmaxf(a.z, fmaxf(b.z, c.z)));
+        for (int z = z0; z <= z1; z++)
+            for (int x = x0; x <= x1; x++) fn(z * cellsX + x);
+    };
+
+    for (Triangle& tri : triangles) {
+        Vector3 a = vertex(tri.v[0]), b = vertex(tri.v[1]), c = vertex(tri.v[2]);
+        tri.minCellX = (int16_t)cellX(fminf(a.x, fminf(b.x, c.x)));
+        tri.minCellZ = (int16_t)cellZ(fminf(a.z, fminf(b.z, c.z)));
+        forEachCell(tri, [this](int cell) { cellStart[cell + 1]++; });
+    }
+
+    for (size_t i = 1; i < cellStart.size(); i++) cellStart[i] += cellStart[i - 1];
+
+    cellTriangles.resize(cellStart.back());
+    std::vector<uint32_t> fill(cellStart.begin(), cellStart.end() - 1);
+    for (uint32_t t = 0; t < (uint32_t)triangles.size(); t++) {
+        forEachCell(triangles[t], [&](int cell) { cellTriangles[fill[cell]++] = t; });
+    }
+}
+
+void TerrainCollider::build(Heightfield heightfield) {
+    vertices.clear();
+    triangles.clear();
+    cellStart.clear();
+    cellTriangles.clear();
+    cellsX = cellsZ = 0;
+
+    field = std::move(heightfield);
+    if (field.samplesX < 2 || field.samplesZ < 2) {
+        field.heights.clear();
+        return;
+    }
+
+    auto range = std::minmax_element(field.heights.begin(), field.heights.end());
+    bounds.min = { field.origin.x, *range.first, field.origin.y };
+    bounds.max = { field.origin.x + (field.samplesX - 1) * field.spacing, *range.second,
+                   field.origin.y + (field.samplesZ - 1) * field.spacing };
+}
+
+size_t TerrainCollider::getMemoryBytes() const {
+    return vertices.capacity() * sizeof(uint16_t)
+         + triangles.capacity() * sizeof(Triangle)
+         + (cellStart.capacity() + cellTriangles.capacity()) * sizeof(uint32_t)
+         + field.heights.capacity() * sizeof(float);
+}
+
+bool TerrainCollider::sweepSphere(Vector3 start, Vector3 motion, float radius, SweepHit& hit) const {
+    Vector3 end = Vector3Add(start, motion);
+    float minX = fminf(start.x, end.x) - radius, maxX = fmaxf(start.x, end.x) + radius;
+    float minZ = fminf(start.z, end.z) - radius, maxZ = fmaxf(start.z, end.z) + radius;
+
+    bool found = false;
+    forEachTriangle(minX, minZ, maxX, maxZ, [&](Vector3 a, Vector3 b, Vector3 c) {
+        if (sweepSphereTriangle(start, motion, radius, a, b, c, hit)) found = true;
+    });
+    return found;
+}
+
+bool TerrainCollider::sampleSurface(float x, float z, float& height, Vector3& normal) const {
+    bool found = false;
+    forEachTriangle(x, z, x, z, [&](Vector3 a, Vector3 b, Vector3 c) {
+        // Barycentric coordinates in XZ, vertical triangles cover no point
+        float e0x = b.x - a.x, e0z = b.z - a.z;
+        float e1x = c.x - a.x, e1z = c.z - a.z;
+        float area = e0x * e1z - e1x * e0z;
+        if (fabsf(area) < 1e-12f) return;
+
+        float wx = x - a.x, wz = z - a.z;
+        float s = (wx * e1z - e1x * wz) / area;
+        float t = (e0x * wz - wx * e0z) / area;
+        if (s < -1e-5f || t < -1e-5f || s + t > 1.0f + 1e-5f) return;
+
+        float y = a.y + s * (b.y - a.y) + t * (c.y - a.y);
+        if (found && y <= height) return;
+
+        Vector3 n = Vector3Normalize(Vector3CrossProduct(Vector3Subtract(b, a), Vector3Subtract(c, a)));
+        normal = (n.y < 0.0f) ? Vector3Negate(n) : n;
+        height = y;
+        found = true;
+    });
+    return found;
+}
+
+// --- Static props ---
+
+bool sweepSphereCollider(Vector3 start, Vector3 motion, float radius, const StaticCollider& c, SweepHit& hit) {
+    if (c.shape == StaticCollider::Box) {
+        // Slab test in the box's frame against the box grown by the radius.
+        // Corners are treated as sharp, which errs on the side of colliding.
+        Vector3 d = Vector3Subtract(start, c.center);
+        const float half[3] = { c.halfExtents.x, c.halfExtents.y, c.halfExtents.z };
+
+        float tEnter = -INFINITY, tExit = INFINITY;
+        int enterAxis = -1;
+        float enterSign = 0.0f;
+
+        for (int i = 0; i < 3; i++) {
+            float s = Vector3DotProduct(d, c.axes[i]);
+            float m = Vector3DotProduct(motion, c.axes[i]);
+            float ext = half[i] + radius;
+
+            if (fabsf(m) < 1e-8f) {
+                if (fabsf(s) > ext) return false;
+                continue;
+            }
+
+            float t1 = (-ext - s) / m;
+            float t2 = ( ext - s) / m;
+            if (t1 > t2) std::swap(t1, t2);
+
+            if (t1 > tEnter) {
+                tEnter = t1;
+                enterAxis = i;
+                enterSign = (m > 0.0f) ? -1.0f : 1.0f; // Face normal opposes the motion
+            }
+            tExit = fminf(tExit, t2);
+            if (tEnter > tExit) return false;
+        }
+
+        // Starting inside (or never entering) isn't a new impact
+        if (enterAxis < 0 || tEnter < 0.0f || tEnter >= hit.t) return false;
+
+        hit.t = tEnter;
+        hit.normal = Vector3Scale(c.axes[enterAxis], enterSign);
+        hit.point = Vector3Subtract(Vector3Add(start, Vector3Scale(motion, tEnter)), Vector3Scale(hit.normal, radius));
+        return true;
+    }
+
+    // Vertical cylinder: a 2D circle test, then check the height range
+    float px = start.x - c.center.x;
+    float pz = start.z - c.center.z;
+    float R = radius + c.radius;
+
+    float A = motion.x*motion.x + motion.z*motion.z;
+    float B = 2.0f * (px*motion.x + pz*motion.z);
+    float C = px*px + pz*pz - R*R;
+
+    if (C < 0.0f || A < 1e-12f) return false; // Already inside, or not moving sideways
+
+    float disc = B*B - 4.0f*A*C;
+    if (disc < 0.0f) return false;
+
+    float t = (-B - sqrtf(disc)) / (2.0f*A);
+    if (t < 0.0f || t >= hit.t) return false;
+
+    float y = start.y + motion.y*t;
+    if (y + radius < c.center.y || y - radius > c.center.y + c.height) return false;
+
+    hit.t = t;
+    hit.normal = Vector3Normalize({ px + motion.x*t, 0.0f, pz + motion.z*t });
+    hit.point = Vector3Subtract(Vector3Add(start, Vector3Scale(motion, t)), Vector3Scale(hit.normal, radius));
+    return true;
+}
+
+// --- CollisionWorld ---
+
+void CollisionWorld::buildTerrain(const Mesh& mesh, const Matrix& transform) {
+    terrain.build(mesh, transform);
+}
+
+void CollisionWorld::buildTerrain(Heightfield heightfield) {
+    terrain.build(std::move(heightfield));
+}
+
+void CollisionWorld::addBox(const BoundingBox& localBounds, const Matrix& transform) {
+    StaticCollider c = {};
+    c.shape = StaticCollider::Box;
+
+    Vector3 localCenter = Vector3Scale(Vector3Add(localBounds.min, localBounds.max), 0.5f);
+    Vector3 localHalf = Vector3Scale(Vector3Subtract(localBounds.max, localBounds.min), 0.5f);
+    c.center = Vector3Transform(localCenter, transform);
+
+    // Columns of the upper 3x3 are the box axes, their lengths are the scale
+    Vector3 cols[3] = {
+        { transform.m0, transform.m1, transform.m2 },
+        { transform.m4, transform.m5, transform.m6 },
+        { transform.m8, transform.m9, transform.m10 }
+    };
+    float localHalfArr[3] = { localHalf.x, localHalf.y, localHalf.z };
+    float half[3];
+    for (int i = 0; i < 3; i++) {
+        float len = Vector3Length(cols[i]);
+        c.axes[i] = Vector3Scale(cols[i], 1.0f / len);
+        half[i] = localHalfArr[i] * len;
+    }
+    c.halfExtents = { half[0], half[1], half[2] };
+
+    // World AABB of the oriented box
+    Vector3 extent = { 0, 0, 0 };
+    for (int i = 0; i < 3; i++) {
+        extent.x += fabsf(c.axes[i].x) * half[i];
+        extent.y += fabsf(c.axes[i].y) * half[i];
+        extent.z += fabsf(c.axes[i].z) * half[i];
+    }
+    c.bounds = { Vector3Subtract(c.center, extent), Vector3Add(c.center, extent) };
+
+    colliders.push_back(c);
+}
+
+void CollisionWorld::addCylinder(Vector3 base, float radius, float height) {
+    StaticCollider c = {};
+    c.shape = StaticCollider::Cylinder;
+    c.center = base;
+    c.radius = radius;
+    c.height = height;
+    c.bounds = { { base.x - radius, base.y, base.z - radius }, { base.x + radius, base.y + height, base.z + radius } };
+    colliders.push_back(c);
+}
+
+void CollisionWorld::buildBroadphase(float cellSize) {
+    gridCellSize = cellSize;
+    cellsX = cellsZ = 0;
+    if (colliders.empty()) return;
+
+    BoundingBox all = colliders[0].bounds;
+    for (const StaticCollider& c : colliders) {
+        all.min = Vector3Min(all.min, c.bounds.min);
+        all.max = Vector3Max(all.max, c.bounds.max);
+    }
+
+    gridOrigin = { all.min.x, all.min.z };
+    cellsX = std::max(1, (int)ceilf((all.max.x - all.min.x) / cellSize));
+    cellsZ = std::max(1, (int)ceilf((all.max.z - all.min.z) / cellSize));
+
+    auto toCell = [this](float v, float origin, int count) {
+        int c = (int)((v - origin) / gridCellSize);
+        return c < 0 ? 0 : (c >= count ? count - 1 : c);
+    };
+
+    auto forEachCell = [&](const StaticCollider& c, auto fn) {
+        int x0 = toCell(c.bounds.min.x, gridOrigin.x, cellsX), x1 = toCell(c.bounds.max.x, gridOrigin.x, cellsX);
+        int z0 = toCell(c.bounds.min.z, gridOrigin.y, cellsZ), z1 = toCell(c.bounds.max.z, gridOrigin.y, cellsZ);
+        for (int z = z0; z <= z1; z++)
+            for (int x = x0; x <= x1; x++) fn(z * cellsX + x);
+    };
+
+    cellStart.assign((size_t)cellsX * cellsZ + 1, 0);
+    for (const StaticCollider& c : colliders) forEachCell(c, [this](int cell) { cellStart[cell + 1]++; });
+    for (size_t i = 1; i < cellStart.size(); i++) cellStart[i] += cellStart[i - 1];
+
+    cellColliders.resize(cellStart.back());
+    std::vector<uint32_t> fill(cellStart.begin(), cellStart.end() - 1);
+    for (uint32_t i = 0; i < (uint32_t)colliders.size(); i++) {
+        forEachCell(colliders[i], [&](int cell) { cellColliders[fill[cell]++] = i; });
+    }
+}
+
+bool CollisionWorld::sweepSphere(Vector3 start, Vector3 motion, float radius, SweepHit& hit) const {
+    bool found = terrain.sweepSphere(start, motion, radius, hit);
+
+    Vector3 end = Vector3Add(start, motion);
+    Vector3 grow = { radius, radius, radius };
+    Vector3 min = Vector3Subtract(Vector3Min(start, end), grow);
+    Vector3 max = Vector3Add(Vector3Max(start, end), grow);
+
+    forEachCollider(min, max, [&](const StaticCollider& c) {
+        if (sweepSphereCollider(start, motion, radius, c, hit)) found = true;
+    });
+
+    return found;
+}
@@ -0,0 +1,297 @@
+#include "Crowd.hpp"
+#include "Simd.hpp"
+#include "raymath.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <random>
+
+static const int kBuckets = 8192;   // Power of two, about 4x the usual horde size
+
+using simd::F4;
+
+void Crowd::clear() {
+    count = 0;
+    padded = 0;
+}
+
+void Crowd::spawn(const NavMesh& nav, int wanted, Vector3 center, float radius, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::uniform_real_distribution<float> jitter(-0.45f, 0.45f);
+
+    std::vector<Vector3> spots;
+    spots.reserve(wanted);
+
+    // Tries a few times per agent, then gives up on that one
+    for (int attempt = 0; attempt < wanted * 4 && (int)spots.size() < wanted; attempt++) {
+        float angle = unit(rng) * 2.0f * PI;
+        float dist = sqrtf(unit(rng)) * radius;
+        Vector3 p = { center.x + cosf(angle) * dist, 0.0f, center.z + sinf(angle) * dist };
+
+        Vector3 ground;
+        if (!nav.findNearestWalkable(p, 8.0f, ground)) continue;
+
+        // Spread agents over the cell so none start exactly on top of another
+        ground.x += jitter(rng) * nav.settings.cellSize;
+        ground.z += jitter(rng) * nav.settings.cellSize;
+        if (!nav.isWalkable(ground.x, ground.z)) continue;
+
+        ground.y = nav.getHeightAt(ground.x, ground.z);
+        spots.push_back(ground);
+    }
+
+    count = (int)spots.size();
+    padded = (count + 3) & ~3;
+
+    std::vector<float>* arrays[] = { &posX, &posY, &posZ, &velX, &velZ, &desiredX, &desiredZ, &sepX, &sepZ,
+                                     &nextX, &nextZ, &h00, &h10, &h01, &h11, &fracX, &fracZ };
+    for (std::vector<float>* a : arrays) a->assign(padded, 0.0f);
+
+    for (int i = 0; i < count; i++) {
+        posX[i] = spots[i].x;
+        posY[i] = spots[i].y;
+        posZ[i] = spots[i].z;
+    }
+
+    agentCellX.assign(count, 0);
+    agentCellZ.assign(count, 0);
+    sortedX.assign(count, 0.0f);
+    sortedZ.assign(count, 0.0f);
+    bucketStart.assign(kBuckets + 1, 0);
+    bucketCursor.assign(kBuckets, 0);
+}
+
+uint32_t Crowd::bucketOf(int cx, int cz) const {
+    return (((uint32_t)cx * 73856093u) ^ ((uint32_t)cz * 19349663u)) & (kBuckets - 1);
+}
+
+void Crowd::update(float deltaTime, const FlowField& field, const NavMesh& nav, Vector3 target) {
+    if (count == 0 || deltaTime <= 0.0f) return;
+
+    // 1. Who's near whom
+    buildGrid();
+    computeSeparation();
+
+    // 2. Where everyone wants to go, then move
+    computeDesired(field, target);
+    integrate(deltaTime);
+
+    // 3. Same ground rules as the player: no stepping onto blocked or too
+    // steep cells, and feet stay on the terrain
+    resolveBlocked(field);
+    snapToTerrain(nav);
+}
+
+void Crowd::buildGrid() {
+    // Counting sort by bucket, cells are one separation radius wide
+    float invCell = 1.0f / settings.separation;
+    std::fill(bucketStart.begin(), bucketStart.end(), 0u);
+
+    for (int i = 0; i < count; i++) {
+        agentCellX[i] = (int)floorf(posX[i] * invCell);
+        agentCellZ[i] = (int)floorf(posZ[i] * invCell);
+        bucketStart[bucketOf(agentCellX[i], agentCellZ[i]) + 1]++;
+    }
+
+    for (int b = 0; b < kBuckets; b++) {
+        bucketStart[b + 1] += bucketStart[b];
+        bucketCursor[b] = bucketStart[b];
+    }
+
+    for (int i = 0; i < count; i++) {
+        uint32_t slot = bucketCursor[bucketOf(agentCellX[i], agentCellZ[i])]++;
+        sortedX[slot] = posX[i];
+        sortedZ[slot] = posZ[i];
+    }
+}
+
+void Crowd::computeSeparation() {
+    const float sep = settings.separation;
+    const F4 sep4 = F4::set1(sep);
+    const F4 sepSqr4 = F4::set1(sep * sep);
+    const F4 tiny4 = F4::set1(1e-8f);
+
+    for (int i = 0; i < count; i++) {
+        const float px = posX[i], pz = posZ[i];
+        const F4 px4 = F4::set1(px), pz4 = F4::set1(pz);
+        F4 accX4 = F4::set1(0.0f), accZ4 = F4::set1(0.0f);
+        float accX = 0.0f, accZ = 0.0f;
+
+        // The 3x3 block of cells around us. Different cells can hash to the
+        // same bucket, so skip buckets we've already been through.
+        uint32_t seen[9];
+        int seenCount = 0;
+
+        for (int dz = -1; dz <= 1; dz++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                uint32_t b = bucketOf(agentCellX[i] + dx, agentCellZ[i] + dz);
+                bool duplicate = false;
+                for (int k = 0; k < seenCount; k++) duplicate |= (seen[k] == b);
+                if (duplicate) continue;
+                seen[seenCount++] = b;
+
+                uint32_t j = bucketStart[b];
+                const uint32_t end = bucketStart[b + 1];
+
+                // Push away from every neighbour inside the radius, harder the
+                // closer they are. Ourselves (distance 0) drop out via the mask.
+                for (; j + 4 <= end; j += 4) {
+                    F4 ox = px4 - F4::load(&sortedX[j]);
+                    F4 oz = pz4 - F4::load(&sortedZ[j]);
+                    F4 distSqr = ox * ox + oz * oz;
+                    F4 inside = lessThan(distSqr, sepSqr4) & greaterThan(distSqr, tiny4);
+
+                    F4 dist = sqrt(distSqr);
+                    F4 weight = select(inside, (sep4 - dist) / (dist * sep4));
+                    accX4 = accX4 + ox * weight;
+                    accZ4 = accZ4 + oz * weight;
+                }
+
+                for (; j < end; j++) {
+                    float ox = px - sortedX[j];
+                    float oz = pz - sortedZ[j];
+                    float distSqr = ox * ox + oz * oz;
+                    if (distSqr >= sep * sep || distSqr <= 1e-8f) continue;
+
+                    float dist = sqrtf(distSqr);
+                    float weight = (sep - dist) / (dist * sep);
+                    accX += ox * weight;
+                    accZ += oz * weight;
+                }
+            }
+        }
+
+        sepX[i] = accX + accX4.sum();
+        sepZ[i] = accZ + accZ4.sum();
+    }
+}
+
+void Crowd::computeDesired(const FlowField& field, Vector3 target) {
+    const float speed = settings.speed;
+
+    for (int i = 0; i < count; i++) {
+        float tx = target.x - posX[i];
+        float tz = target.z - posZ[i];
+        float dist = sqrtf(tx * tx + tz * tz);
+
+        if (dist < settings.arriveDistance) {
+            // Close enough, just mill around
+            desiredX[i] = 0.0f;
+            desiredZ[i] = 0.0f;
+        } else if (dist < settings.seekDistance) {
+            desiredX[i] = tx / dist * speed;
+            desiredZ[i] = tz / dist * speed;
+        } else {
+            Vector2 dir = field.sample(posX[i], posZ[i]);
+            desiredX[i] = dir.x * speed;
+            desiredZ[i] = dir.y * speed;
+        }
+    }
+}
+
+void Crowd::integrate(float deltaTime) {
+    const F4 dt4 = F4::set1(deltaTime);
+    const F4 blend4 = F4::set1(fminf(1.0f, settings.acceleration * deltaTime));
+    const F4 sepWeight4 = F4::set1(settings.separationWeight * settings.speed);
+    const F4 maxSpeed4 = F4::set1(settings.speed * 1.25f);
+    const F4 one4 = F4::set1(1.0f);
+    const F4 tiny4 = F4::set1(1e-8f);
+
+    for (int i = 0; i < padded; i += 4) {
+        F4 vx = F4::load(&velX[i]);
+        F4 vz = F4::load(&velZ[i]);
+
+        // Steer toward flow + separation
+        F4 wantX = F4::load(&desiredX[i]) + F4::load(&sepX[i]) * sepWeight4;
+        F4 wantZ = F4::load(&desiredZ[i]) + F4::load(&sepZ[i]) * sepWeight4;
+        vx = vx + (wantX - vx) * blend4;
+        vz = vz + (wantZ - vz) * blend4;
+
+        // Cap the speed so a tight crowd can't shove anyone through a wall
+        F4 speed = sqrt(max(vx * vx + vz * vz, tiny4));
+        F4 scale = min(one4, maxSpeed4 / speed);
+        vx = vx * scale;
+        vz = vz * scale;
+
+        vx.store(&velX[i]);
+        vz.store(&velZ[i]);
+        (F4::load(&posX[i]) + vx * dt4).store(&nextX[i]);
+        (F4::load(&posZ[i]) + vz * dt4).store(&nextZ[i]);
+    }
+}
+
+void Crowd::resolveBlocked(const FlowField& field) {
+    for (int i = 0; i < count; i++) {
+        float nx = nextX[i], nz = nextZ[i];
+
+        if (field.isPassable(nx, nz)) {
+            posX[i] = nx;
+            posZ[i] = nz;
+        } else if (field.isPassable(nx, posZ[i])) {
+            // Slide along whichever axis is still open
+            posX[i] = nx;
+            velZ[i] = 0.0f;
+        } else if (field.isPassable(posX[i], nz)) {
+            posZ[i] = nz;
+            velX[i] = 0.0f;
+        } else {
+            velX[i] = 0.0f;
+            velZ[i] = 0.0f;
+        }
+    }
+}
+
+void Crowd::snapToTerrain(const NavMesh& nav) {
+    const std::vector<float>& heights = nav.getHeights();
+    const int cellsX = nav.getCellsX();
+    const int cellsZ = nav.getCellsZ();
+    if (heights.empty() || cellsX < 2 || cellsZ < 2) return;
+
+    // 1. Continuous cell coordinates (heights are cell centred), clamped so
+    // the 2x2 block we blend is always inside the grid
+    const Vector2 origin = nav.getOrigin();
+    const F4 originX4 = F4::set1(origin.x), originZ4 = F4::set1(origin.y);
+    const F4 inv4 = F4::set1(1.0f / nav.settings.cellSize);
+    const F4 half4 = F4::set1(0.5f);
+    const F4 zero4 = F4::set1(0.0f);
+    const F4 maxX4 = F4::set1((float)cellsX - 1.001f);
+    const F4 maxZ4 = F4::set1((float)cellsZ - 1.001f);
+
+    for (int i = 0; i < padded; i += 4) {
+        F4 fx = min(max((F4::load(&posX[i]) - originX4) * inv4 - half4, zero4), maxX4);
+        F4 fz = min(max((F4::load(&posZ[i]) - originZ4) * inv4 - half4, zero4), maxZ4);
+        fx.store(&fracX[i]);
+        fz.store(&fracZ[i]);
+    }
+
+    // 2. Gather the four surrounding heights (no gathers in SSE2, so scalar)
+    for (int i = 0; i < padded; i++) {
+        int ix = std::min((int)fracX[i], cellsX - 2);
+        int iz = std::min((int)fracZ[i], cellsZ - 2);
+        fracX[i] -= (float)ix;
+        fracZ[i] -= (float)iz;
+
+        int cell = iz * cellsX + ix;
+        float fallback = posY[i];
+        auto height = [&](int c) { return heights[c] == -FLT_MAX ? fallback : heights[c]; };
+        h00[i] = height(cell);
+        h10[i] = height(cell + 1);
+        h01[i] = height(cell + cellsX);
+        h11[i] = height(cell + cellsX + 1);
+    }
+
+    // 3. Bilinear blend
+    for (int i = 0; i < padded; i += 4) {
+        F4 tx = F4::load(&fracX[i]);
+        F4 tz = F4::load(&fracZ[i]);
+        F4 a = F4::load(&h00[i]);
+        F4 b = F4::load(&h10[i]);
+        F4 c = F4::load(&h01[i]);
+        F4 d = F4::load(&h11[i]);
+
+        F4 near = a + (b - a) * tx;
+        F4 far = c + (d - c) * tx;
+        (near + (far - near) * tz).store(&posY[i]);
+    }
+}
@@ -0,0 +1,95 @@
+#include "DynamicResolution.hpp"
+#include "raymath.h"
+#include "rlgl.h"
+
+DynamicResolution::~DynamicResolution() {
+    shutdown();
+}
+
+void DynamicResolution::init(const Settings& newSettings) {
+    settings = newSettings;
+    scale = settings.maxScale;
+
+    if (!timer.init()) {
+        TraceLog(LOG_WARNING, "DYNRES: GPU timer queries unavailable, rendering at fixed scale %.2f", scale);
+    }
+
+    allocate(GetScreenWidth(), GetScreenHeight());
+}
+
+void DynamicResolution::shutdown() {
+    timer.shutdown();
+    if (target.id != 0) {
+        UnloadRenderTexture(target);
+        target = {};
+    }
+}
+
+void DynamicResolution::allocate(int width, int height) {
+    if (target.id != 0) UnloadRenderTexture(target);
+
+    nativeWidth = width;
+    nativeHeight = height;
+    target = LoadRenderTexture(width, height);
+
+    // Bilinear so the upscale isn't blocky
+    SetTextureFilter(target.texture, TEXTURE_FILTER_BILINEAR);
+}
+
+void DynamicResolution::beginScene() {
+    // Window size changed (or fullscreen toggled), match the new backbuffer
+    if (GetScreenWidth() != nativeWidth || GetScreenHeight() != nativeHeight) {
+        allocate(GetScreenWidth(), GetScreenHeight());
+    }
+
+    viewWidth = (int)fmaxf(1.0f, nativeWidth * scale);
+    viewHeight = (int)fmaxf(1.0f, nativeHeight * scale);
+
+    BeginTextureMode(target);
+
+    // BeginMode3D takes its aspect ratio from the full target, which has the
+    // same shape as our corner of it, so only the viewport has to shrink
+    rlViewport(0, 0, viewWidth, viewHeight);
+
+    timer.begin();
+}
+
+void DynamicResolution::endScene() {
+    timer.end();
+    EndTextureMode();
+}
+
+void DynamicResolution::present() {
+    // Render textures are stored bottom-up, hence the negative height
+    Rectangle source = { 0.0f, 0.0f, (float)viewWidth, -(float)viewHeight };
+    Rectangle dest = { 0.0f, 0.0f, (float)GetScreenWidth(), (float)GetScreenHeight() };
+    DrawTexturePro(target.texture, source, dest, { 0, 0 }, 0.0f, WHITE);
+}
+
+void DynamicResolution::update() {
+    timer.poll();
+    if (!timer.isAvailable() || timer.getLastMs() <= 0.0f) return;
+
+    // Smooth out single slow frames so we don't bounce between sizes
+    smoothedMs = (smoothedMs <= 0.0f) ? timer.getLastMs() : Lerp(smoothedMs, timer.getLastMs(), 0.1f);
+
+    if (++framesSinceAdjust < settings.adjustInterval) return;
+    framesSinceAdjust = 0;
+
+    // Work in whole steps. scale always sits on one, rounding just undoes
+    // the float error from multiplying it back out.
+    float current = roundf(scale / settings.step);
+    float steps = current;
+    if (smoothedMs > settings.targetMs) {
+        // GPU cost scales with pixel count, i.e. scale squared. Round down,
+        // and by at least one step: rounding to nearest would keep the scale
+        // for anything up to ~5% over budget, more at lower scales.
+        float desired = scale * sqrtf(settings.targetMs / smoothedMs);
+        steps = fminf(floorf(desired / settings.step), current - 1.0f);
+    } else if (smoothedMs < settings.targetMs * 0.75f) {
+        // Plenty of headroom, creep back up one step at a time
+        steps = current + 1.0f;
+    }
+
+    scale = Clamp(steps * settings.step, settings.minScale, settings.maxScale);
+}
@@ -0,0 +1,191 @@
+#include "FlowField.hpp"
+#include "raymath.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // Neighbour order: 4 straight, then 4 diagonals
+    const int kDX[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+    const int kDZ[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+    const uint32_t kStepCost[8] = { 10, 10, 10, 10, 14, 14, 14, 14 };
+}
+
+void FlowField::init(const NavMesh& nav, JobSystem& jobs) {
+    ready = false;
+    building = false;
+    targetCell = -1;
+    if (!nav.isBuilt()) return;
+
+    // Same footprint as the navmesh, just coarser
+    const float cs = settings.cellSize;
+    const float navCs = nav.settings.cellSize;
+    origin = nav.getOrigin();
+    cellsX = (int)ceilf(nav.getCellsX() * navCs / cs);
+    cellsZ = (int)ceilf(nav.getCellsZ() * navCs / cs);
+
+    const int cellCount = cellsX * cellsZ;
+    passable.assign(cellCount, 0);
+    neighbours.assign(cellCount, 0);
+    heights.assign(cellCount, 0.0f);
+    cost.assign(cellCount, Unreached);
+    dirX.assign(cellCount, 0.0f);
+    dirZ.assign(cellCount, 0.0f);
+
+    // The queue only ever holds the wavefront, a ring a few cells wide
+    // around the target. Room for a generous one up front keeps the
+    // per-frame integration off the heap.
+    for (std::vector<int32_t>& b : buckets) b.reserve((size_t)4 * (cellsX + cellsZ));
+
+    // 1. Sample the navmesh at every cell centre
+    jobs.parallelFor(cellsZ, 32, [&](int rowBegin, int rowEnd) {
+        for (int cz = rowBegin; cz < rowEnd; cz++) {
+            for (int cx = 0; cx < cellsX; cx++) {
+                float x = origin.x + (cx + 0.5f) * cs;
+                float z = origin.y + (cz + 0.5f) * cs;
+                passable[cz * cellsX + cx] = nav.isWalkable(x, z) ? 1 : 0;
+                heights[cz * cellsX + cx] = nav.getHeightAt(x, z);
+            }
+        }
+    });
+
+    // 2. Which steps are allowed. A step may rise as much as the slope limit
+    // allows over its length, and diagonals can't cut blocked corners.
+    float slope = nav.settings.slopeLimit;
+    float maxRise = sqrtf(fmaxf(0.0f, 1.0f - slope * slope)) / slope;
+
+    jobs.parallelFor(cellsZ, 32, [&](int rowBegin, int rowEnd) {
+        for (int cz = rowBegin; cz < rowEnd; cz++) {
+            for (int cx = 0; cx < cellsX; cx++) {
+                int cell = cz * cellsX + cx;
+                if (!passable[cell]) continue;
+
+                uint8_t bits = 0;
+                for (int n = 0; n < 8; n++) {
+                    int nx = cx + kDX[n], nz = cz + kDZ[n];
+                    if (nx < 0 || nz < 0 || nx >= cellsX || nz >= cellsZ) continue;
+
+                    int other = nz * cellsX + nx;
+                    if (!passable[other]) continue;
+                    if (n >= 4 && (!passable[cz * cellsX + nx] || !passable[nz * cellsX + cx])) continue;
+
+                    float run = (n >= 4) ? cs * 1.41421356f : cs;
+                    if (fabsf(heights[other] - heights[cell]) > run * maxRise) continue;
+
+                    bits |= (uint8_t)(1 << n);
+                }
+                neighbours[cell] = bits;
+            }
+        }
+    });
+}
+
+int FlowField::cellIndex(float x, float z) const {
+    if (cellsX == 0) return -1;
+    int cx = (int)floorf((x - origin.x) / settings.cellSize);
+    int cz = (int)floorf((z - origin.y) / settings.cellSize);
+    if (cx < 0 || cz < 0 || cx >= cellsX || cz >= cellsZ) return -1;
+    return cz * cellsX + cx;
+}
+
+bool FlowField::isPassable(float x, float z) const {
+    int cell = cellIndex(x, z);
+    return cell >= 0 && passable[cell];
+}
+
+Vector2 FlowField::sample(float x, float z) const {
+    int cell = cellIndex(x, z);
+    if (cell < 0 || !ready) return { 0.0f, 0.0f };
+    return { dirX[cell], dirZ[cell] };
+}
+
+void FlowField::update(Vector3 target, JobSystem& jobs) {
+    // Standing somewhere agents can't (against a trunk, mid jump over a
+    // ledge): keep heading for the last good spot
+    int cell = cellIndex(target.x, target.z);
+
+    // 1. New target cell: start a fresh integration from it
+    if (cell >= 0 && passable[cell] && cell != targetCell) {
+        std::fill(cost.begin(), cost.end(), (uint32_t)Unreached);
+        for (std::vector<int32_t>& b : buckets) b.clear();
+
+        cost[cell] = 0;
+        buckets[0].push_back(cell);
+        currentCost = 0;
+        pendingCells = 1;
+        targetCell = cell;
+        buildTarget = target;
+        building = true;
+    }
+
+    if (!building) return;
+
+    // 2. Dial's algorithm: pop cells in cost order out of the bucket ring.
+    // Entries that got cheaper after being queued are skipped when popped.
+    int settled = 0;
+    while (pendingCells > 0 && settled < settings.budget) {
+        std::vector<int32_t>& bucket = buckets[currentCost % 15];
+        if (bucket.empty()) {
+            currentCost++;
+            continue;
+        }
+
+        int here = bucket.back();
+        bucket.pop_back();
+        pendingCells--;
+        if (cost[here] != currentCost) continue;
+        settled++;
+
+        uint8_t bits = neighbours[here];
+        for (int n = 0; n < 8; n++) {
+            if (!(bits & (1 << n))) continue;
+
+            int next = here + kDZ[n] * cellsX + kDX[n];
+            uint32_t nextCost = currentCost + kStepCost[n];
+            if (nextCost < cost[next]) {
+                cost[next] = nextCost;
+                buckets[nextCost % 15].push_back(next);
+                pendingCells++;
+            }
+        }
+    }
+
+    // 3. Everything reachable is settled, turn costs into directions
+    if (pendingCells == 0) finishBuild(jobs);
+}
+
+void FlowField::finishBuild(JobSystem& jobs) {
+    jobs.parallelFor(cellsZ, 32, [&](int rowBegin, int rowEnd) {
+        for (int cz = rowBegin; cz < rowEnd; cz++) {
+            for (int cx = 0; cx < cellsX; cx++) {
+                int cell = cz * cellsX + cx;
+                float dx = 0.0f, dz = 0.0f;
+
+                // Point at the cheapest neighbour (the target cell itself stays zero)
+                if (cost[cell] != Unreached && cost[cell] > 0) {
+                    uint32_t best = cost[cell];
+                    uint8_t bits = neighbours[cell];
+                    for (int n = 0; n < 8; n++) {
+                        if (!(bits & (1 << n))) continue;
+                        uint32_t c = cost[cell + kDZ[n] * cellsX + kDX[n]];
+                        if (c < best) {
+                            best = c;
+                            dx = (float)kDX[n];
+                            dz = (float)kDZ[n];
+                        }
+                    }
+                    if (dx != 0.0f && dz != 0.0f) {
+                        dx *= 0.70710678f;
+                        dz *= 0.70710678f;
+                    }
+                }
+
+                dirX[cell] = dx;
+                dirZ[cell] = dz;
+            }
+        }
+    });
+
+    readyTarget = buildTarget;
+    ready = true;
+    building = false;
+}
@@ -0,0 +1,83 @@
+#include "FrameArena.hpp"
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    size_t alignUp(size_t value, size_t align) {
+        return (value + align - 1) & ~(align - 1);
+    }
+}
+
+FrameArena::~FrameArena() {
+    shutdown();
+}
+
+void FrameArena::init(size_t newCapacity) {
+    shutdown();
+    block = static_cast<unsigned char*>(std::malloc(newCapacity));
+    if (!block) throw std::bad_alloc();
+    capacity = newCapacity;
+}
+
+void FrameArena::shutdown() {
+    releaseOverflow();
+    used = 0;
+    std::free(block);
+    block = nullptr;
+    capacity = 0;
+    peak = 0;
+}
+
+void* FrameArena::allocate(size_t size, size_t align) {
+    // 1. Fits in the block: bump the offset (aligned against the real
+    // address, malloc only promises max_align_t)
+    if (block) {
+        uintptr_t start = alignUp((uintptr_t)(block + used), align);
+        size_t end = (size_t)(start - (uintptr_t)block) + size;
+        if (end <= capacity) {
+            used = end;
+            if (getUsed() > peak) peak = getUsed();
+            return reinterpret_cast<void*>(start);
+        }
+    }
+
+    // 2. Doesn't: a heap block of its own, freed on reset
+    size_t header = alignUp(sizeof(Overflow), alignof(std::max_align_t));
+    size_t total = header + size + align;
+    unsigned char* raw = static_cast<unsigned char*>(std::malloc(total));
+    if (!raw) throw std::bad_alloc();
+
+    Overflow* node = reinterpret_cast<Overflow*>(raw);
+    node->next = overflow;
+    overflow = node;
+    overflowBytes += size + align;
+    if (getUsed() > peak) peak = getUsed();
+
+    return reinterpret_cast<void*>(alignUp((uintptr_t)(raw + header), align));
+}
+
+void FrameArena::reset() {
+    bool overflowed = releaseOverflow();
+    used = 0;
+
+    // Last frame didn't fit, grow so the next one does (with some headroom)
+    if (overflowed) {
+        size_t grown = alignUp(peak + peak / 4, 4096);
+        std::free(block);
+        block = static_cast<unsigned char*>(std::malloc(grown));
+        if (!block) throw std::bad_alloc();
+        capacity = grown;
+    }
+}
+
+bool FrameArena::releaseOverflow() {
+    bool any = (overflow != nullptr);
+    while (overflow) {
+        Overflow* next = overflow->next;
+        std::free(overflow);
+        overflow = next;
+    }
+    overflowBytes = 0;
+    return any;
+}
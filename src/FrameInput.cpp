@@ -0,0 +1,33 @@
+#include "FrameInput.hpp"
+
+namespace {
+    struct KeyBinding {
+        int raylibKey;
+        InputKey key;
+    };
+
+    const KeyBinding bindings[] = {
+        { KEY_W, INPUT_FORWARD },
+        { KEY_S, INPUT_BACK },
+        { KEY_A, INPUT_LEFT },
+        { KEY_D, INPUT_RIGHT },
+        { KEY_SPACE, INPUT_JUMP },
+        { KEY_LEFT_CONTROL, INPUT_DESCEND },
+        { KEY_C, INPUT_CROUCH },
+        { KEY_LEFT_SHIFT, INPUT_SPRINT },
+        { KEY_G, INPUT_CREATIVE },
+    };
+}
+
+FrameInput sampleFrameInput(float deltaTime) {
+    FrameInput input;
+    input.deltaTime = deltaTime;
+    input.mouseDelta = GetMouseDelta();
+
+    for (const KeyBinding& b : bindings) {
+        if (IsKeyDown(b.raylibKey)) input.keysDown |= b.key;
+        if (IsKeyPressed(b.raylibKey)) input.keysPressed |= b.key;
+    }
+
+    return input;
+}
@@ -0,0 +1,74 @@
+#include "FrameLog.hpp"
+#include "raylib.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+    struct Percentiles {
+        float p50, p95, p99, max;
+    };
+
+    // Nearest rank on a sorted copy
+    template <typename Get>
+    Percentiles percentiles(const std::vector<FrameLog::Frame>& frames, Get get) {
+        std::vector<float> values;
+        values.reserve(frames.size());
+        for (const FrameLog::Frame& f : frames) values.push_back(get(f));
+        std::sort(values.begin(), values.end());
+
+        auto rank = [&values](float p) {
+            size_t i = (size_t)(p * (float)values.size());
+            return values[std::min(i, values.size() - 1)];
+        };
+        return { rank(0.50f), rank(0.95f), rank(0.99f), values.back() };
+    }
+
+    void logRow(const char* name, const Percentiles& p) {
+        TraceLog(LOG_INFO, "    %-8s p50 %7.2f   p95 %7.2f   p99 %7.2f   max %7.2f ms", name, p.p50, p.p95, p.p99, p.max);
+    }
+}
+
+bool FrameLog::writeCsv(const char* path) const {
+    FILE* file = fopen(path, "w");
+    if (!file) return false;
+
+    fprintf(file, "frame,frame_ms,main_ms,sim_ms,gpu_ms,draw_calls,triangles\n");
+    for (size_t i = 0; i < frames.size(); i++) {
+        const Frame& f = frames[i];
+        fprintf(file, "%zu,%.3f,%.3f,%.3f,%.3f,%d,%d\n", i, f.frameMs, f.mainMs, f.simMs, f.gpuMs, f.drawCalls, f.triangles);
+    }
+    fclose(file);
+    return true;
+}
+
+void FrameLog::logSummary(const char* label) const {
+    if (frames.empty()) {
+        TraceLog(LOG_WARNING, "%s: No frames recorded", label);
+        return;
+    }
+
+    Percentiles frame = percentiles(frames, [](const Frame& f) { return f.frameMs; });
+    double total = 0.0;
+    for (const Frame& f : frames) total += f.frameMs;
+
+    TraceLog(LOG_INFO, "%s: %zu frames in %.2f s, %.1f fps average", label, frames.size(), total / 1000.0, 1000.0 * frames.size() / total);
+    logRow("frame", frame);
+    logRow("main", percentiles(frames, [](const Frame& f) { return f.mainMs; }));
+    logRow("sim", percentiles(frames, [](const Frame& f) { return f.simMs; }));
+    logRow("gpu", percentiles(frames, [](const Frame& f) { return f.gpuMs; }));
+
+    // A hitch is a frame over twice the median of the whole run (not of its
+    // neighbours, so a slow stretch counts as many hitches). Long frames are
+    // the ones that would have missed two 60 Hz vblanks.
+    int hitches = 0, longFrames = 0;
+    for (const Frame& f : frames) {
+        hitches += (f.frameMs > 2.0f * frame.p50);
+        longFrames += (f.frameMs > 2000.0f / 60.0f);
+    }
+    TraceLog(LOG_INFO, "    hitches  %d over 2x median (%.2f ms), %d over 33.3 ms", hitches, 2.0f * frame.p50, longFrames);
+
+    Percentiles draws = percentiles(frames, [](const Frame& f) { return (float)f.drawCalls; });
+    Percentiles triangles = percentiles(frames, [](const Frame& f) { return (float)f.triangles; });
+    TraceLog(LOG_INFO, "    draws    p50 %.0f   max %.0f", draws.p50, draws.max);
+    TraceLog(LOG_INFO, "    tris     p50 %.0f   max %.0f", triangles.p50, triangles.max);
+}
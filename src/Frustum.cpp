@@ -0,0 +1,41 @@
+#include "Frustum.hpp"
+#include "raymath.h"
+
+namespace {
+    Vector4 normalizePlane(Vector4 p) {
+        float len = sqrtf(p.x*p.x + p.y*p.y + p.z*p.z);
+        if (len > 0.0f) {
+            p.x /= len; p.y /= len; p.z /= len; p.w /= len;
+        }
+        return p;
+    }
+}
+
+Frustum Frustum::fromCamera(const Camera3D& camera, float aspect, float nearPlane, float farPlane) {
+    Matrix view = MatrixLookAt(camera.position, camera.target, camera.up);
+    Matrix proj = MatrixPerspective(camera.fovy * DEG2RAD, aspect, nearPlane, farPlane);
+    Matrix m = MatrixMultiply(view, proj);
+
+    // Gribb/Hartmann plane extraction. raylib transforms a point as
+    // clip.x = m0*x + m4*y + m8*z + m12, so each "row" is every 4th element.
+    Vector4 r0 = { m.m0, m.m4, m.m8,  m.m12 };
+    Vector4 r1 = { m.m1, m.m5, m.m9,  m.m13 };
+    Vector4 r2 = { m.m2, m.m6, m.m10, m.m14 };
+    Vector4 r3 = { m.m3, m.m7, m.m11, m.m15 };
+
+    Frustum f;
+    f.planes[0] = normalizePlane({ r3.x + r0.x, r3.y + r0.y, r3.z + r0.z, r3.w + r0.w }); // Left
+    f.planes[1] = normalizePlane({ r3.x - r0.x, r3.y - r0.y, r3.z - r0.z, r3.w - r0.w }); // Right
+    f.planes[2] = normalizePlane({ r3.x + r1.x, r3.y + r1.y, r3.z + r1.z, r3.w + r1.w }); // Bottom
+    f.planes[3] = normalizePlane({ r3.x - r1.x, r3.y - r1.y, r3.z - r1.z, r3.w - r1.w }); // Top
+    f.planes[4] = normalizePlane({ r3.x + r2.x, r3.y + r2.y, r3.z + r2.z, r3.w + r2.w }); // Near
+    f.planes[5] = normalizePlane({ r3.x - r2.x, r3.y - r2.y, r3.z - r2.z, r3.w - r2.w }); // Far
+    return f;
+}
+
+bool Frustum::containsSphere(Vector3 center, float radius) const {
+    for (const Vector4& p : planes) {
+        if (p.x*center.x + p.y*center.y + p.z*center.z + p.w < -radius) return false;
+    }
+    return true;
+}
@@ -0,0 +1,122 @@
+#include "GLExt.hpp"
+#include "rlgl.h"
+#include <cstring>
+
+namespace GLExt {
+    GenQueriesProc genQueries = nullptr;
+    DeleteQueriesProc deleteQueries = nullptr;
+    BeginQueryProc beginQuery = nullptr;
+    EndQueryProc endQuery = nullptr;
+    GetQueryObjectivProc getQueryObjectiv = nullptr;
+    GetQueryObjectui64vProc getQueryObjectui64v = nullptr;
+    VertexAttribPointerProc vertexAttribPointer = nullptr;
+
+    GetStringProc getString = nullptr;
+    GetStringiProc getStringi = nullptr;
+    GetIntegervProc getIntegerv = nullptr;
+    CreateShaderProc createShader = nullptr;
+    ShaderSourceProc shaderSource = nullptr;
+    CompileShaderProc compileShader = nullptr;
+    GetShaderivProc getShaderiv = nullptr;
+    GetInfoLogProc getShaderInfoLog = nullptr;
+    DeleteShaderProc deleteShader = nullptr;
+    CreateProgramProc createProgram = nullptr;
+    AttachShaderProc attachShader = nullptr;
+    DetachShaderProc detachShader = nullptr;
+    BindAttribLocationProc bindAttribLocation = nullptr;
+    LinkProgramProc linkProgram = nullptr;
+    GetProgramivProc getProgramiv = nullptr;
+    GetInfoLogProc getProgramInfoLog = nullptr;
+    DeleteProgramProc deleteProgram = nullptr;
+    ProgramParameteriProc programParameteri = nullptr;
+    GetProgramBinaryProc getProgramBinary = nullptr;
+    ProgramBinaryProc programBinary = nullptr;
+    MaxShaderCompilerThreadsProc maxShaderCompilerThreads = nullptr;
+
+    namespace {
+        bool loaded = false;
+    }
+
+    void load() {
+        if (loaded) return;
+        loaded = true;
+
+        genQueries = (GenQueriesProc)rlGetProcAddress("glGenQueries");
+        deleteQueries = (DeleteQueriesProc)rlGetProcAddress("glDeleteQueries");
+        beginQuery = (BeginQueryProc)rlGetProcAddress("glBeginQuery");
+        endQuery = (EndQueryProc)rlGetProcAddress("glEndQuery");
+        getQueryObjectiv = (GetQueryObjectivProc)rlGetProcAddress("glGetQueryObjectiv");
+        getQueryObjectui64v = (GetQueryObjectui64vProc)rlGetProcAddress("glGetQueryObjectui64v");
+        vertexAttribPointer = (VertexAttribPointerProc)rlGetProcAddress("glVertexAttribPointer");
+
+        getString = (GetStringProc)rlGetProcAddress("glGetString");
+        getStringi = (GetStringiProc)rlGetProcAddress("glGetStringi");
+        getIntegerv = (GetIntegervProc)rlGetProcAddress("glGetIntegerv");
+        createShader = (CreateShaderProc)rlGetProcAddress("glCreateShader");
+        shaderSource = (ShaderSourceProc)rlGetProcAddress("glShaderSource");
+        compileShader = (CompileShaderProc)rlGetProcAddress("glCompileShader");
+        getShaderiv = (GetShaderivProc)rlGetProcAddress("glGetShaderiv");
+        getShaderInfoLog = (GetInfoLogProc)rlGetProcAddress("glGetShaderInfoLog");
+        deleteShader = (DeleteShaderProc)rlGetProcAddress("glDeleteShader");
+        createProgram = (CreateProgramProc)rlGetProcAddress("glCreateProgram");
+        attachShader = (AttachShaderProc)rlGetProcAddress("glAttachShader");
+        detachShader = (DetachShaderProc)rlGetProcAddress("glDetachShader");
+        bindAttribLocation = (BindAttribLocationProc)rlGetProcAddress("glBindAttribLocation");
+        linkProgram = (LinkProgramProc)rlGetProcAddress("glLinkProgram");
+        getProgramiv = (GetProgramivProc)rlGetProcAddress("glGetProgramiv");
+        getProgramInfoLog = (GetInfoLogProc)rlGetProcAddress("glGetProgramInfoLog");
+        deleteProgram = (DeleteProgramProc)rlGetProcAddress("glDeleteProgram");
+        programParameteri = (ProgramParameteriProc)rlGetProcAddress("glProgramParameteri");
+        getProgramBinary = (GetProgramBinaryProc)rlGetProcAddress("glGetProgramBinary");
+        programBinary = (ProgramBinaryProc)rlGetProcAddress("glProgramBinary");
+
+        // Only from the extension the driver actually advertises
+        if (hasExtension("GL_KHR_parallel_shader_compile")) {
+            maxShaderCompilerThreads = (MaxShaderCompilerThreadsProc)rlGetProcAddress("glMaxShaderCompilerThreadsKHR");
+        } else if (hasExtension("GL_ARB_parallel_shader_compile")) {
+            maxShaderCompilerThreads = (MaxShaderCompilerThreadsProc)rlGetProcAddress("glMaxShaderCompilerThreadsARB");
+        }
+    }
+
+    bool hasExtension(const char* name) {
+        // 1. Core profiles list extensions one at a time
+        if (getStringi && getIntegerv) {
+            int count = 0;
+            getIntegerv(NUM_EXTENSIONS, &count);
+            for (int i = 0; i < count; i++) {
+                const char* extension = (const char*)getStringi(EXTENSIONS, (unsigned int)i);
+                if (extension && strcmp(extension, name) == 0) return true;
+            }
+            if (count > 0) return false;
+        }
+
+        // 2. Compatibility and ES contexts have one space-separated string.
+        // Match whole names only, GL_ARB_foo must not match GL_ARB_foo_bar.
+        const char* list = getString ? (const char*)getString(EXTENSIONS) : nullptr;
+        if (!list) return false;
+        size_t length = strlen(name);
+        for (const char* at = strstr(list, name); at; at = strstr(at + length, name)) {
+            bool startsWord = (at == list) || (at[-1] == ' ');
+            bool endsWord = (at[length] == ' ') || (at[length] == '\0');
+            if (startsWord && endsWord) return true;
+        }
+        return false;
+    }
+
+    bool hasTimerQueries() {
+        return genQueries && deleteQueries && beginQuery && endQuery && getQueryObjectiv && getQueryObjectui64v;
+    }
+
+    bool hasShaderPrograms() {
+        return getString && createShader && shaderSource && compileShader && getShaderiv && getShaderInfoLog &&
+               deleteShader && createProgram && attachShader && detachShader && bindAttribLocation && linkProgram &&
+               getProgramiv && getProgramInfoLog && deleteProgram;
+    }
+
+    bool hasProgramBinaries() {
+        if (!hasShaderPrograms() || !getIntegerv || !programParameteri || !getProgramBinary || !programBinary) return false;
+        int formats = 0;
+        getIntegerv(NUM_PROGRAM_BINARY_FORMATS, &formats);
+        return formats > 0;
+    }
+}
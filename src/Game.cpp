@@ -1,16 +1,55 @@
 #include "Game.hpp"
+#include "Frustum.hpp"
+#include "Memory.hpp"
+#include "ObjLoader.hpp"
+#include "Placement.hpp"
+#include "Profiler.hpp"
+#include "Scatter.hpp"
+#include "TerrainGenerator.hpp"
 #include "raylib.h"
 #include "raymath.h"
 #include <vector>
 #include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <ctime>
+
+namespace {
+    // Yaw and pitch in degrees to a unit look vector, standard 3D Cartesian conversion
+    Vector3 lookDirection(float yaw, float pitch) {
+        return { cosf(DEG2RAD * yaw) * cosf(DEG2RAD * pitch), sinf(DEG2RAD * pitch), sinf(DEG2RAD * yaw) * cosf(DEG2RAD * pitch) };
+    }
+}
 
-Game::Game() {
-    // 1. Set the configuration flags BEFORE InitWindow
-    SetConfigFlags(FLAG_FULLSCREEN_MODE | FLAG_VSYNC_HINT | FLAG_MSAA_4X_HINT);
-    
-    // 2. Initialize with 0, 0 to use the current monitor resolution
-    InitWindow(0, 0, "Real 3D - Raylib Version");
-    SetTargetFPS(60);
+Game::Game(const GameConfig& startup) : config(startup) {
+    // Assets come from the archive when there is one, the loose files otherwise
+    if (config.packPath && assetPack.open(config.packPath)) {
+        assetPack.mount();
+        TraceLog(LOG_INFO, "PACK: Mounted %s, %d files, %.1f MB", config.packPath, assetPack.getEntryCount(),
+                 assetPack.getSize() / (1024.0f * 1024.0f));
+    }
+
+    // --trace: loading is part of the capture
+    trace::setThreadName("main");
+    if (config.traceFrames > 0) trace::start("trace.json", config.traceFrames);
+
+    // --replay: the recording picks the map, so it's read before anything loads
+    if (config.replayPath) startReplay();
+
+    // 1. Set the configuration flags BEFORE InitWindow. The benchmark runs
+    // uncapped in a fixed-size window, so results compare across machines.
+    const bool benchmark = config.flythrough || config.stress.enabled;
+    if (benchmark) {
+        SetConfigFlags(FLAG_MSAA_4X_HINT);
+        InitWindow(1280, 720, config.flythrough ? "Real 3D - Flythrough" : "Real 3D - Stress");
+        SetTargetFPS(0);
+    } else {
+        SetConfigFlags(FLAG_FULLSCREEN_MODE | FLAG_VSYNC_HINT | FLAG_MSAA_4X_HINT);
+
+        // 2. Initialize with 0, 0 to use the current monitor resolution
+        InitWindow(0, 0, "Real 3D - Raylib Version");
+        SetTargetFPS(60);
+    }
     DisableCursor();
     SetExitKey(KEY_NULL);
 
@@ -25,106 +64,262 @@ Game::Game() {
     cameraYaw = -135.0f; 
     cameraPitch = -15.0f;
 
+    // Workers first, loading already hands them work
+    jobs.init();
+
     setupUI(); 
     setupResources();
+
+    // 3D pass goes through an off-screen target that shrinks when the GPU
+    // can't keep up, the UI is still drawn at native resolution on top.
+    // Benchmarks keep full resolution so every run renders the same pixels.
+    DynamicResolution::Settings resolution;
+    if (benchmark) resolution.minScale = resolution.maxScale;
+    dynamicRes.init(resolution);
+
+    // The 3D pass is timed by dynamicRes, the UI gets its own query for the profiler
+    uiTimer.init();
+
+    // Bake the UI font once, every label after that is a cached layout
+    text.init("assets/fonts/BBH_Bogle/BBHBogle-Regular.ttf", shaders.get(shaderIds.text));
+
+    // Everyone has taken their shaders, drop the variants this run didn't need
+    shaders.releaseUnused();
     currentState = GameState::Playing;
+    viewAspect = (float)GetScreenWidth() / (float)GetScreenHeight();
+
+    if (config.flythrough) startFlythrough();
+    if (config.stress.enabled) startStress();
+    if (config.recordPath && inputRecorder.start(config.recordPath, config)) deterministic = true;
 }
 
 // Helper functions
+void Game::GameObject::updateTransform() {
+    // Fences follow the ground normal, trees usually grow straight up regardless of slope
+    transform = placementTransform(position, rotation.y, scale, groundNormal, !isTree);
+}
+
+void Game::GameObject::updateBounds(const BoundingBox& localBounds) {
+    Vector3 localCenter = Vector3Scale(Vector3Add(localBounds.min, localBounds.max), 0.5f);
+    float localRadius = Vector3Distance(localBounds.min, localBounds.max) * 0.5f;
+
+    boundsCenter = Vector3Transform(localCenter, transform);
+    boundsRadius = localRadius * fmaxf(scale.x, fmaxf(scale.y, scale.z));
+}
+
+// Both come straight from the terrain collider: the quad under x,z for a
+// generated heightfield, the highest (quantised) triangle under it for the
+// authored map. That's the same surface a ray cast straight down would hit,
+// without keeping a float copy of the map's triangles around for it.
 float Game::getMapHeightAt(float x, float z) {
-    Ray ray = { { x, 1000.0f, z }, { 0, -1, 0 } }; 
-    
-    // We access the first mesh of the model directly
-    // This function is guaranteed to exist based on your error log
-    RayCollision hit = GetRayCollisionMesh(ray, mapModel.meshes[0], mapModel.transform);
-    
-    return (hit.hit) ? hit.point.y : 0.0f;
+    PROFILE_SCOPE("terrain queries");
+
+    float height;
+    Vector3 normal;
+    return collision.getTerrain().sampleSurface(x, z, height, normal) ? height : 0.0f;
 }
 
 Vector3 Game::getMapNormalAt(float x, float z) {
-    Ray ray = { { x, 1000.0f, z }, { 0, -1, 0 } };
-    
-    RayCollision hit = GetRayCollisionMesh(ray, mapModel.meshes[0], mapModel.transform);
-    
-    return (hit.hit) ? hit.normal : (Vector3){ 0, 1, 0 };
+    PROFILE_SCOPE("terrain queries");
+
+    float height;
+    Vector3 normal;
+    return collision.getTerrain().sampleSurface(x, z, height, normal) ? normal : (Vector3){ 0, 1, 0 };
 }
 
 void Game::updateBall(float deltaTime) {
-    // 1. Apply Gravity
-    gameBall.velocity.y -= 15.0f * deltaTime;
+    PROFILE_SCOPE("updateBall");
 
-    // 2. Air Friction (Damping) - Slows it down over time
-    gameBall.velocity = Vector3Scale(gameBall.velocity, 0.995f);
+    // 1-3. Gravity, drag and the swept bounce
+    gameBall.integrate(deltaTime, collision);
+    keepBallOnMap(gameBall);
 
-    // 3. Update Position
-    gameBall.position = Vector3Add(gameBall.position, Vector3Scale(gameBall.velocity, deltaTime));
+    // --stress: every ball only reads the world, so they split over the workers
+    jobs.parallelFor((int)stressBalls.size(), 64, [this, deltaTime](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            stressBalls[i].integrate(deltaTime, collision);
+            keepBallOnMap(stressBalls[i]);
+        }
+    });
+}
 
-    // 4. Ground Collision
-    float terrainHeight = getMapHeightAt(gameBall.position.x, gameBall.position.z);
-    if (gameBall.position.y - gameBall.radius < terrainHeight) {
-        gameBall.position.y = terrainHeight + gameBall.radius;
-        
-        // Reflect velocity based on ground normal for realistic bounces
-        Vector3 normal = getMapNormalAt(gameBall.position.x, gameBall.position.z);
-        gameBall.velocity = Vector3Reflect(gameBall.velocity, normal);
-        
-        // Apply bounciness
-        gameBall.velocity = Vector3Scale(gameBall.velocity, gameBall.restitution);
+void Game::keepBallOnMap(Ball& ball) {
+    // 4. Safety net: never end a frame under the terrain
+    float terrainHeight = getMapHeightAt(ball.position.x, ball.position.z);
+    if (ball.position.y - ball.radius < terrainHeight) {
+        ball.position.y = terrainHeight + ball.radius;
     }
 
-    // 5. Wall Collisions (Boundary 500x500)
-    const float limit = 495.0f;
-    if (fabs(gameBall.position.x) > limit) {
-        gameBall.velocity.x *= -gameBall.restitution;
-        gameBall.position.x = (gameBall.position.x > 0) ? limit : -limit;
+    // 5. Wall Collisions (just inside the map edge)
+    const float limit = mapHalfSize - 5.0f;
+    if (fabs(ball.position.x) > limit) {
+        ball.velocity.x *= -ball.restitution;
+        ball.position.x = (ball.position.x > 0) ? limit : -limit;
     }
-    if (fabs(gameBall.position.z) > limit) {
-        gameBall.velocity.z *= -gameBall.restitution;
-        gameBall.position.z = (gameBall.position.z > 0) ? limit : -limit;
+    if (fabs(ball.position.z) > limit) {
+        ball.velocity.z *= -ball.restitution;
+        ball.position.z = (ball.position.z > 0) ? limit : -limit;
     }
 }
 
-// Pause Menu setup
+// Build the pause menu and HUD widgets. Sizes are fractions of the screen,
+// UIScreen turns them into pixels whenever the resolution changes.
 void Game::setupUI() {
-    float sw = (float)GetScreenWidth();
-    float sh = (float)GetScreenHeight();
-    float centerX = sw * 0.5f;
-    float centerY = sh * 0.5f;
-
-    // 1. Pause Menu Box (25% width, 60% height)
-    Vector2 menuSize = { sw * 0.25f, sh * 0.6f };
-    pauseMenuRect = { centerX - menuSize.x/2, centerY - menuSize.y/2, menuSize.x, menuSize.y };
-
-    // 2. Buttons (15% width, 6% height)
-    Vector2 btnSize = { sw * 0.15f, sh * 0.06f };
-    resumeBtnRect = { centerX - btnSize.x/2, centerY - (menuSize.y * 0.05f) - btnSize.y/2, btnSize.x, btnSize.y };
-    exitBtnRect = { centerX - btnSize.x/2, centerY + (menuSize.y * 0.1f) - btnSize.y/2, btnSize.x, btnSize.y };
-
-    // 3. Slider Track
-    Vector2 trackSize = { sw * 0.15f, sh * 0.005f };
-    sliderTrackRect = { centerX - trackSize.x/2, centerY + (menuSize.y * 0.3f), trackSize.x, trackSize.y };
-
-    // 4. Slider Handle
-    Vector2 handleSize = { sw * 0.01f, sh * 0.03f };
-    
-    // Use the CENTER of the track Y for the handle Y
-    sliderHandleRect = { 
-        sliderTrackRect.x + (sliderValue * sliderTrackRect.width) - handleSize.x/2, 
-        sliderTrackRect.y + (sliderTrackRect.height / 2.0f) - (handleSize.y / 2.0f), 
-        handleSize.x, 
-        handleSize.y 
-    };
+    // 1. Dark Overlay and Pause Menu Box (25% width, 60% height)
+    UIWidget overlay;
+    overlay.type = WidgetType::Overlay;
+    overlay.color = Fade(BLACK, 0.7f);
+    pauseMenu.add(overlay);
+
+    UIWidget menuBox;
+    menuBox.type = WidgetType::Panel;
+    menuBox.size = { 0.25f, 0.6f };
+    menuBox.color = Color{ 40, 40, 40, 220 };
+    pauseMenu.add(menuBox);
+
+    UIWidget title;
+    title.type = WidgetType::Label;
+    title.anchor = { 0.5f, 0.255f };
+    title.text = "PAUSED";
+    title.textSize = 0.05f;
+    pauseMenu.add(title);
+
+    // 2. Buttons (15% width, 6% height, labels at 60% of button height)
+    UIWidget button;
+    button.type = WidgetType::Button;
+    button.size = { 0.15f, 0.06f };
+    button.color = Color{ 0, 0, 0, 180 };
+    button.textSize = 0.036f;
+
+    button.anchor = { 0.5f, 0.47f };
+    button.text = "RESUME";
+    resumeButton = pauseMenu.add(button);
+
+    button.anchor = { 0.5f, 0.56f };
+    button.text = "EXIT";
+    exitButton = pauseMenu.add(button);
+
+    // 3. Sensitivity Slider, header above and value below
+    UIWidget header;
+    header.type = WidgetType::Label;
+    header.anchor = { 0.5f, 0.659f };
+    header.text = "MOUSE SENSITIVITY";
+    header.textSize = 0.0185f;
+    pauseMenu.add(header);
+
+    UIWidget slider;
+    slider.type = WidgetType::Slider;
+    slider.anchor = { 0.5f, 0.6825f };
+    slider.size = { 0.15f, 0.005f };
+    slider.handleSize = { 0.01f, 0.03f };
+    slider.color = GRAY;
+    slider.textColor = WHITE; // Handle
+    slider.value = sliderValue;
+    sensitivitySlider = pauseMenu.add(slider);
+
+    UIWidget value = header;
+    value.anchor = { 0.5f, 0.713f };
+    value.text = TextFormat("Value: %.2f", sliderValue);
+    value.dynamicText = true;   // Rewritten as the slider moves
+    sensitivityLabel = pauseMenu.add(value);
+
+    // 4. HUD
+    UIWidget dot;
+    dot.type = WidgetType::Crosshair;
+    dot.cached = false;   // Toggles with the right mouse button, not worth caching
+    dot.visible = false;
+    crosshair = hud.add(dot);
+}
+
+// The authored map, or a generated one when asked for on the command line.
+// Either way this fills mapModel, its chunk bounds and the collision copies.
+void Game::loadMap() {
+    PROFILE_SCOPE("loadMap");
+    mapChunkBounds.clear();
+
+    if (config.terrain == GameConfig::Terrain::Procedural) {
+        TerrainGenerator generator;
+        generator.settings.seed = config.seed;
+        generator.settings.size = config.mapSize;
+
+        // Heights and chunk meshes are built on the workers...
+        Heightfield field;
+        std::vector<TerrainGenerator::Chunk> chunks;
+        generator.generate(jobs, field);
+        generator.buildChunks(field, jobs, chunks);
+
+        // ...the upload has to happen here, on the GL thread
+        mapModel = Model{};
+        mapModel.transform = MatrixIdentity();
+        mapModel.meshCount = (int)chunks.size();
+        mapModel.meshes = (Mesh*)MemAlloc(mapModel.meshCount * sizeof(Mesh));
+        mapModel.meshMaterial = (int*)MemAlloc(mapModel.meshCount * sizeof(int));
+        mapModel.materialCount = 1;
+        mapModel.materials = (Material*)MemAlloc(sizeof(Material));
+        mapModel.materials[0] = LoadMaterialDefault();
+
+        for (int i = 0; i < mapModel.meshCount; i++) {
+            mapModel.meshes[i] = chunks[i].mesh;
+            UploadMesh(&mapModel.meshes[i], false);
+            mapChunkBounds.push_back(chunks[i].bounds);
+        }
+
+        // The heightfield answers every ground query
+        collision.buildTerrain(std::move(field));
+        TraceLog(LOG_INFO, "TERRAIN: Generated %.0fm map (seed %u) in %d chunks", config.mapSize, config.seed, mapModel.meshCount);
+    } else {
+        mapModel = ObjLoader::load("assets/maps/Towers/Towers.obj", jobs);
+        for (int i = 0; i < mapModel.meshCount; i++) mapChunkBounds.push_back(GetMeshBoundingBox(mapModel.meshes[i]));
+
+        // The quantised collision copy answers the ball's swept queries and
+        // every height/normal lookup, so it's the only one the CPU keeps
+        collision.buildTerrain(mapModel.meshes[0], mapModel.transform);
+    }
+
+    meshMemory.track("map", mapModel);
+
+    BoundingBox bounds = collision.getTerrain().getBounds();
+    mapHalfSize = 0.5f * fminf(bounds.max.x - bounds.min.x, bounds.max.z - bounds.min.z);
+}
+
+// Every variant the game can draw with, whichever ones this run ends up
+// using: compiled together (or loaded from the cache) instead of one at a
+// time as loading reaches them
+void Game::loadShaders() {
+    PROFILE_SCOPE("loadShaders");
+    const std::vector<std::string> packed = { "PACKED_VERTICES" };
+
+    shaderIds.terrain = shaders.add("assets/shaders/terrain.vs", "assets/shaders/terrain.fs");
+    shaderIds.terrainPacked = shaders.add("assets/shaders/terrain.vs", "assets/shaders/terrain.fs", packed);
+    shaderIds.modelPacked = shaders.add("assets/shaders/model.vs", nullptr, packed);
+    shaderIds.text = shaders.add(nullptr, "assets/shaders/sdf.fs");
+    shaders.build(jobs, assetCache);
 }
 
 // Load in map, models and textures
 void Game::setupResources() {
-    // 1. Load the Map Model
-    mapModel = LoadModel("assets/maps/Towers/Towers.obj");
+    PROFILE_SCOPE("setupResources");
+    trace::Phases phases(config.stress.enabled);    // --stress logs the time of each step
+
+    // Shaders first, the rest of loading picks from them
+    phases.begin("shaders");
+    loadShaders();
+
+    // 1. Load the Map Model (or generate one) and its collision copies
+    phases.begin("map");
+    loadMap();
     grassTexture = LoadTexture("assets/textures/grass.jpg");
     rockTexture = LoadTexture("assets/textures/black-stone.jpg");
 
-    // 2. Load the Shader
-    Shader terrainShader = LoadShader("assets/shaders/terrain.vs", "assets/shaders/terrain.fs");
+    // Packed vertices: the map now (its collision copies are built), the
+    // packs as they load. The map keeps its own shader, so it isn't handed
+    // the shared one its UnloadModel() would free.
+    const bool packVertices = (config.vertexFormat == GameConfig::VertexFormat::Packed);
+    if (packVertices) packedModelShader = shaders.get(shaderIds.modelPacked);
+    bool mapPacked = packVertices && VertexPacking::packModel(mapModel, Shader{}, vertexStats);
+
+    // 2. The terrain shader (its packed variant if the map was packed)
+    terrainShader = shaders.get(mapPacked ? shaderIds.terrainPacked : shaderIds.terrain);
 
     // Link textures to the shader's sampler2D slots
     int texGrassLoc = GetShaderLocation(terrainShader, "texture0");
@@ -143,39 +338,68 @@ void Game::setupResources() {
     int secondSlot = 1;
     SetShaderValue(terrainShader, texRockLoc, &secondSlot, SHADER_UNIFORM_INT);
 
+    // Start in a corner, whatever size the map is
+    float start = mapHalfSize - 10.0f;
+    camera.position = { start, fmaxf(50.0f, getMapHeightAt(start, start) + currentEyeHeight), start };
+
     // Load Ball
-    gameBall.position = (Vector3){ 480.0f, 300.0f, 480.0f }; // Start in the air
+    float ballStart = start - 10.0f;
+    gameBall.position = (Vector3){ ballStart, fmaxf(300.0f, getMapHeightAt(ballStart, ballStart) + 50.0f), ballStart }; // Start in the air
     gameBall.velocity = (Vector3){ 0.0f, 0.0f, 0.0f };
     gameBall.radius = 1.0f;
     gameBall.restitution = 0.8f; // Bounces back with 80% energy
 
+    // The ball is a real mesh now so it can go through the render queue
+    // (same 16x16 tessellation DrawSphere used)
+    ballMesh = GenMeshSphere(1.0f, 16, 16);
+    meshMemory.track("generated", ballMesh);
+    ballMaterial = LoadMaterialDefault();
+    ballMaterial.maps[MATERIAL_MAP_DIFFUSE].color = ORANGE;
+
+    // Wanderers reuse the sphere, stretched into a rough capsule
+    agentMaterial = LoadMaterialDefault();
+    agentMaterial.maps[MATERIAL_MAP_DIFFUSE].color = MAROON;
+
     // 2. Load Templates
-    Model fenceModel = LoadModel("assets/objects/Farm Buildings - Sept 2018/OBJ/Fence.obj");
+    phases.begin("fences");
+    Model fenceModel = ObjLoader::load("assets/objects/Farm Buildings - Sept 2018/OBJ/Fence.obj", jobs);
+    meshMemory.track("farm pack", fenceModel);
     Texture2D woodTex = LoadTexture("assets/textures/wood.png");
     fenceModel.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = woodTex;
 
-    Model treeModel = LoadModel("assets/objects/Ultimate Nature Pack - Jun 2019/OBJ/CommonTree_5.obj");
-    Texture2D leafTex = LoadTexture("assets/textures/leaves.png");
-    treeModel.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = leafTex;
-
-    // 3. FENCE LOOP
-    for (int i = 0; i < 4000; i += 6) {
+    // Local bounds for culling, shared by every instance of a template
+    BoundingBox fenceBounds = GetModelBoundingBox(fenceModel);
+    if (packVertices) VertexPacking::packModel(fenceModel, packedModelShader, vertexStats);
+
+    // 3. FENCE LOOP: one fence every 6 units around the edge of the map, or
+    // however many --stress wants, evenly spaced
+    const float fenceEdge = mapHalfSize - 2.0f;
+    const int side = (int)(2.0f * fenceEdge) + 4;
+    int fenceCount = (4 * side + 5) / 6;
+    float fenceStep = 6.0f;
+    if (config.stress.enabled) {
+        fenceCount = config.stress.fences;
+        fenceStep = (fenceCount > 0) ? 4.0f * side / fenceCount : 0.0f;
+    }
+    sceneObjects.reserve(fenceCount);
+    for (int k = 0; k < fenceCount; k++) {
+        float i = k * fenceStep;
         GameObject f;
         f.model = fenceModel;
         f.scale = { 1.0f, 1.0f, 1.0f };
 
         // Position Logic
-        if (i < 1000) {
-            f.position = { 498.0f - (float)i, 0.0f, 498.0f };
+        if (i < side) {
+            f.position = { fenceEdge - (float)i, 0.0f, fenceEdge };
             f.rotation = { 0, 0, 0 };
-        } else if (i < 2000) {
-            f.position = { -498.0f, 0.0f, 498.0f - (float)(i - 1000) };
+        } else if (i < 2 * side) {
+            f.position = { -fenceEdge, 0.0f, fenceEdge - (float)(i - side) };
             f.rotation = { 0, 90.0f, 0 };
-        } else if (i < 3000) {
-            f.position = { -498.0f + (float)(i - 2000), 0.0f, -498.0f };
+        } else if (i < 3 * side) {
+            f.position = { -fenceEdge + (float)(i - 2 * side), 0.0f, -fenceEdge };
             f.rotation = { 0, 0, 0 };
         } else {
-            f.position = { 498.0f, 0.0f, -498.0f + (float)(i - 3000) };
+            f.position = { fenceEdge, 0.0f, -fenceEdge + (float)(i - 3 * side) };
             f.rotation = { 0, 90.0f, 0 };
         }
 
@@ -187,35 +411,78 @@ void Game::setupResources() {
 
         // Snap to terrain height
         f.position.y = getMapHeightAt(f.position.x, f.position.z);
+        f.updateTransform();
+        f.updateBounds(fenceBounds);
+        collision.addBox(fenceBounds, f.transform);
         sceneObjects.push_back(f);
 
         // Every 500 fences, tell the OS we are still working
-        if (i % 500 == 0) {
+        if (k % 500 == 0) {
             PollInputEvents(); // Keeps the window responsive during the heavy loop
         }
     }
 
-    // 4. TREE LOOP
-    for (int i = 0; i < 50; i++) {
-        GameObject t;
-        t.model = treeModel;
-        t.isTree = true;
+    phases.begin("vegetation");
 
-        float rx = -100.0f + (float)(-(rand() % 375));
-        float rz = 100.0f + (float)(rand() % 375);
-        float groundY = getMapHeightAt(rx, rz);
-        
-        t.position = { rx, groundY, rz };
-        
-        // Random Scale & Rotation
-        float s = 10.0f + (float)(rand() % 201) / 10.0f;
-        t.scale = { s, s, s };
-        t.rotation = { 0, (float)(rand() % 360), 0 };
+    // 4. VEGETATION, or everything --stress asked for
+    if (config.stress.enabled) {
+        buildStressScene(packVertices);
+    } else {
+        scatterVegetation(packVertices);
+    }
 
-        // Slope Alignment Logic (Optional in Raylib - simpler to just set position)
-        t.groundNormal = getMapNormalAt(rx, rz);
+    // Props are placed, bucket them for the swept queries
+    collision.buildBroadphase();
+
+    phases.begin("navmesh");
+
+    // 5. NAVMESH: baked once, then loaded from the cache until the terrain or props change.
+    // Cells grow with the map so big generated ones stay around a million cells.
+    navMesh.settings.cellSize = fmaxf(1.0f, mapHalfSize / 512.0f);
+    navMesh.settings.slopeLimit = controller.settings.slopeLimit;
+    navMesh.settings.agentRadius = controller.settings.radius;
+    navMesh.settings.maxClimb = controller.settings.stepHeight;
+    navMesh.buildCached(collision, jobs, assetCache);
+
+    phases.begin("agents");
+
+    // 6. HORDE: spread over the whole map, they'll find their way to us
+    hordeField.settings.cellSize = 2.0f * navMesh.settings.cellSize;
+    hordeField.init(navMesh, jobs);
+    horde.spawn(navMesh, 2000, { 0.0f, 0.0f, 0.0f }, mapHalfSize - 50.0f, 99);
+
+    // Spawn the wanderers around the start so they're easy to find
+    const int wandererCount = 16;
+    std::uniform_real_distribution<float> spawn(-60.0f, 60.0f);
+    wanderers.reserve(wandererCount);
+    for (int i = 0; i < wandererCount; i++) {
+        Vector3 spot;
+        float around = mapHalfSize - 60.0f;
+        if (navMesh.findNearestWalkable({ around + spawn(wanderRng), 0.0f, around + spawn(wanderRng) }, 20.0f, spot)) {
+            wanderers.create()->position = spot;
+        }
+    }
 
-        sceneObjects.push_back(t);
+    // A batch never has more requests than there are wanderers. Paths are
+    // swapped between the wanderers and the results, never freed, so room
+    // for a long one in each keeps the path jobs off the heap.
+    const size_t pathCapacity = 64;
+    pathRequests.reserve(wanderers.size());
+    pathResults.resize(wanderers.size());
+    pathOwners.reserve(wanderers.size());
+    for (NavMesh::Path& result : pathResults) result.points.reserve(pathCapacity);
+    wanderers.forEach([&](Wanderer& w) { w.path.reserve(pathCapacity); });
+
+    // 7. Everything that can be on screen is known now
+    reserveFrameMemory();
+
+    // 8. Collision, bounds and the navmesh are built, the GPU has the rest
+    phases.begin("release mesh data");
+    releaseMeshData();
+    phases.end();
+
+    if (config.stress.enabled) {
+        TraceLog(LOG_INFO, "STRESS: %.1f MB resident after loading", memory::getResidentBytes() / (1024.0f * 1024.0f));
     }
 
     // // Windmill
@@ -239,9 +506,254 @@ void Game::setupResources() {
     // sceneObjects.push_back(barn);
 }
 
-// Process key presses and events
-void Game::processEvents(float deltaTime) {
+// Everything that grows on the map: Poisson-disk scatter over the whole of
+// it. Same seed, same forest, on any machine and any core count.
+void Game::scatterVegetation(bool packVertices) {
+    // Trees go first so bushes and rocks fill in around them
+    struct Plant {
+        const char* file;
+        bool leaves;            // Gets the leaf texture
+        bool upright;           // Grows straight up instead of following the slope
+        float trunk;            // Collider radius per unit of scale, 0 to walk through
+        Scatter::Species species;
+    };
+
+    Scatter::Species tree;
+    tree.spacing = 24.0f;
+    tree.footprint = 4.0f;
+    tree.density = 0.8f;
+    tree.patchSize = 150.0f;
+    tree.slopeLimit = 0.8f;
+    tree.minScale = 10.0f;
+    tree.maxScale = 20.0f;
+
+    Scatter::Species lowland = tree, highland = tree;
+    lowland.maxHeight = 150.0f;
+    highland.minHeight = 100.0f;
+
+    Scatter::Species rock;
+    rock.spacing = 30.0f;
+    rock.footprint = 3.0f;
+    rock.density = 0.5f;
+    rock.slopeLimit = 0.5f;     // Happy on slopes the trees avoid
+    rock.minScale = 5.0f;
+    rock.maxScale = 12.0f;
+
+    Scatter::Species bush;
+    bush.spacing = 14.0f;
+    bush.footprint = 1.5f;
+    bush.density = 0.6f;
+    bush.patchSize = 80.0f;
+    bush.slopeLimit = 0.8f;
+    bush.minScale = 3.0f;
+    bush.maxScale = 6.0f;
+
+    const std::string naturePack = "assets/objects/Ultimate Nature Pack - Jun 2019/OBJ/";
+    const Plant plants[] = {
+        { "CommonTree_5.obj",  true,  true,  0.2f, lowland },
+        { "CommonTree_1.obj",  true,  true,  0.2f, lowland },
+        { "BirchTree_2.obj",   true,  true,  0.2f, tree },
+        { "PineTree_3.obj",    true,  true,  0.2f, highland },
+        { "Rock_Moss_2.obj",   false, false, 0.3f, rock },
+        { "Rock_3.obj",        false, false, 0.3f, rock },
+        { "Bush_1.obj",        false, true,  0.0f, bush },
+        { "BushBerries_1.obj", false, true,  0.0f, bush },
+    };
+    const int plantCount = sizeof(plants) / sizeof(plants[0]);
+
+    Texture2D leafTex = LoadTexture("assets/textures/leaves.png");
+    std::vector<Model> plantModels(plantCount);
+    std::vector<BoundingBox> plantBounds(plantCount);
+
+    Scatter scatter;
+    scatter.settings.seed = 2019;
+    scatter.addExclusion({ camera.position.x, camera.position.z }, 25.0f);  // Clear the spawn
+
+    for (int p = 0; p < plantCount; p++) {
+        plantModels[p] = ObjLoader::load((naturePack + plants[p].file).c_str(), jobs);
+        meshMemory.track("nature pack", plantModels[p]);
+        if (plants[p].leaves) plantModels[p].materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = leafTex;
+        plantBounds[p] = GetModelBoundingBox(plantModels[p]);
+        if (packVertices) VertexPacking::packModel(plantModels[p], packedModelShader, vertexStats);
+        scatter.addSpecies(plants[p].species);
+    }
+
+    // Inside the fences
+    std::vector<Scatter::Instance> instances;
+    float plantEdge = mapHalfSize - 10.0f;
+    scatter.run(collision.getTerrain(), { -plantEdge, -plantEdge, 2.0f * plantEdge, 2.0f * plantEdge }, jobs, instances);
+    sceneObjects.reserve(sceneObjects.size() + instances.size());
+
+    for (const Scatter::Instance& inst : instances) {
+        const Plant& plant = plants[inst.species];
+
+        GameObject t;
+        t.model = plantModels[inst.species];
+        t.isTree = plant.upright;
+        t.position = inst.position;
+        t.scale = { inst.scale, inst.scale, inst.scale };
+        t.rotation = { 0, inst.yaw, 0 };
+        t.groundNormal = inst.normal;
+        t.updateTransform();
+        t.updateBounds(plantBounds[inst.species]);
+
+        // Trunk only, same radius the player collides with
+        if (plant.trunk > 0.0f) {
+            collision.addCylinder(t.position, plant.trunk * inst.scale, plantBounds[inst.species].max.y * inst.scale);
+        }
+
+        sceneObjects.push_back(t);
+    }
+    TraceLog(LOG_INFO, "SCATTER: Placed %d plants and rocks", (int)instances.size());
+}
+
+// --stress: exact counts instead of the authored layout, at seeded random
+// spots. There is no spacing rule, so they go well past what the scatter
+// would ever fit on the map.
+void Game::buildStressScene(bool packVertices) {
+    const GameConfig::Stress& stress = config.stress;
+    std::mt19937 rng(stress.seed);
+    const float edge = mapHalfSize - 10.0f;
+    std::uniform_real_distribution<float> spot(-edge, edge);
+    std::uniform_real_distribution<float> turn(0.0f, 360.0f);
+
+    struct Template {
+        Model model;
+        BoundingBox bounds;
+        float minScale, maxScale;
+        float trunk;            // Cylinder radius per unit of scale, 0 for the model's box
+        bool solid;             // Bushes are walked through
+        bool upright;
+    };
+    auto loadTemplate = [&](const std::string& path, const char* pack, Texture2D texture) {
+        Template t = {};
+        t.model = ObjLoader::load(path.c_str(), jobs);
+        meshMemory.track(pack, t.model);
+        if (texture.id != 0) t.model.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = texture;
+        t.bounds = GetModelBoundingBox(t.model);
+        if (packVertices) VertexPacking::packModel(t.model, packedModelShader, vertexStats);
+        t.minScale = t.maxScale = 1.0f;
+        t.solid = t.upright = true;
+        return t;
+    };
+    auto place = [&](const Template& t) {
+        GameObject obj;
+        obj.model = t.model;
+        obj.isTree = t.upright;
+        obj.position.x = spot(rng);
+        obj.position.z = spot(rng);
+        obj.position.y = getMapHeightAt(obj.position.x, obj.position.z);
+        float scale = std::uniform_real_distribution<float>(t.minScale, t.maxScale)(rng);
+        obj.scale = { scale, scale, scale };
+        obj.rotation = { 0, turn(rng), 0 };
+        obj.groundNormal = getMapNormalAt(obj.position.x, obj.position.z);
+        obj.updateTransform();
+        obj.updateBounds(t.bounds);
+
+        if (t.trunk > 0.0f) {
+            collision.addCylinder(obj.position, t.trunk * scale, t.bounds.max.y * scale);
+        } else if (t.solid) {
+            collision.addBox(t.bounds, obj.transform);
+        }
+        sceneObjects.push_back(obj);
+    };
+
+    // 1. TREES: the listed Nature Pack species, same sizes and trunks the
+    // scatter gives them
+    std::vector<Template> species;
+    if (stress.trees > 0) {
+        const std::string naturePack = "assets/objects/Ultimate Nature Pack - Jun 2019/OBJ/";
+        Texture2D leafTex = LoadTexture("assets/textures/leaves.png");
+
+        size_t begin = 0;
+        while (begin < stress.species.size()) {
+            size_t end = std::min(stress.species.find(',', begin), stress.species.size());
+            std::string name = stress.species.substr(begin, end - begin);
+            begin = end + 1;
+
+            std::string path = naturePack + name + ".obj";
+            if (name.empty() || !PackArchive::fileExists(path.c_str())) {
+                TraceLog(LOG_WARNING, "STRESS: No Nature Pack model called '%s'", name.c_str());
+                continue;
+            }
+
+            bool isTree = (name.find("Tree") != std::string::npos);
+            bool isRock = (name.find("Rock") != std::string::npos);
+            Template t = loadTemplate(path, "nature pack", isTree ? leafTex : Texture2D{});
+            t.minScale = isTree ? 10.0f : (isRock ? 5.0f : 3.0f);
+            t.maxScale = isTree ? 20.0f : (isRock ? 12.0f : 6.0f);
+            t.trunk = isTree ? 0.2f : (isRock ? 0.3f : 0.0f);
+            t.solid = isTree || isRock;
+            t.upright = !isRock;
+            species.push_back(t);
+        }
+    }
+
+    // 2. PROPS: farm buildings in the fences' wood, and the guns in their own colours
+    std::vector<Template> props;
+    if (stress.props > 0) {
+        const std::string farmPack = "assets/objects/Farm Buildings - Sept 2018/OBJ/";
+        const std::string gunPack = "assets/objects/Ultimate Gun Pack - July 2019/OBJ/";
+        const char* farm[] = { "Barn", "BigBarn", "ChickenCoop", "Silo", "SmallBarn", "WaterTower", "Well", "Windmill" };
+        const char* guns[] = { "AssaultRifle_1", "Bullpup_1", "Pistol_1", "Revolver_1", "Shotgun_1", "SniperRifle_1", "SubmachineGun_1" };
+        Texture2D woodTex = LoadTexture("assets/textures/wood.png");
+
+        for (const char* name : farm) props.push_back(loadTemplate(farmPack + name + ".obj", "farm pack", woodTex));
+        for (const char* name : guns) {
+            Template t = loadTemplate(gunPack + name + ".obj", "gun pack", Texture2D{});
+            t.minScale = t.maxScale = 2.0f;     // Big enough to trip over
+            props.push_back(t);
+        }
+    }
+
+    sceneObjects.reserve(sceneObjects.size() + (species.empty() ? 0 : stress.trees) + stress.props);
+    for (int i = 0; i < stress.trees && !species.empty(); i++) place(species[i % species.size()]);
+    std::uniform_int_distribution<int> pickProp(0, std::max(0, (int)props.size() - 1));
+    for (int i = 0; i < stress.props; i++) place(props[pickProp(rng)]);
+
+    // 3. BALLS: dropped from 20-60 m up, drifting a little so they don't all
+    // bounce in place
+    std::uniform_real_distribution<float> drop(20.0f, 60.0f);
+    std::uniform_real_distribution<float> drift(-10.0f, 10.0f);
+    stressBalls.reserve(stress.balls);
+    for (int i = 0; i < stress.balls; i++) {
+        Ball ball;
+        float x = spot(rng), z = spot(rng);
+        ball.position = { x, getMapHeightAt(x, z) + drop(rng), z };
+        ball.velocity = { drift(rng), 0.0f, drift(rng) };
+        ball.radius = 1.0f;
+        ball.restitution = 0.8f;
+        stressBalls.push_back(ball);
+    }
+
+    TraceLog(LOG_INFO, "STRESS: %d fences, %d trees (%d species), %d props, %d balls", stress.fences,
+             species.empty() ? 0 : stress.trees, (int)species.size(), stress.props, stress.balls);
+}
+
+// Menu and cursor handling. Runs on the main thread since it talks to the window.
+void Game::processMenuEvents() {
     // --- 1. GLOBAL INPUTS (Always active) ---
+    if (IsKeyPressed(KEY_F3)) {
+        showProfiler = !showProfiler;
+        profiler::setEnabled(showProfiler);
+
+        // The overlay's first frames allocate (glyph layouts), start the check over
+        steadyFrames = 0;
+    }
+
+    if (IsKeyPressed(KEY_F6) && currentState == GameState::Playing && !config.flythrough) recordPathKey();
+
+    if (IsKeyPressed(KEY_F4) && !trace::isRecording()) {
+        // Named by time so one session's captures don't overwrite each other
+        char path[64];
+        time_t now = time(nullptr);
+        strftime(path, sizeof(path), "trace-%Y%m%d-%H%M%S.json", localtime(&now));
+        trace::start(path, config.traceFrames > 0 ? config.traceFrames : 300);
+
+        // Each thread's first event allocates its buffer
+        steadyFrames = 0;
+    }
+
     if (IsKeyPressed(KEY_ESCAPE)) {
         if (currentState == GameState::Playing) {
             currentState = GameState::Paused;
@@ -252,11 +764,42 @@ void Game::processEvents(float deltaTime) {
         }
     }
 
-    if (currentState == GameState::Playing) {
+    if (currentState == GameState::Paused) {
+        pauseMenu.update();
+
+        if (pauseMenu.wasClicked(resumeButton)) {
+            currentState = GameState::Playing;
+            DisableCursor();
+        }
+        if (pauseMenu.wasClicked(exitButton)) {
+            // Let run() finish the frame and shut the sim thread down cleanly
+            quitRequested = true;
+        }
+
+        if (pauseMenu.isDragging(sensitivitySlider)) {
+            // 1. Visual 0.0 to 1.0
+            sliderValue = pauseMenu.get(sensitivitySlider).value;
+
+            // 2. Map that to the math sensitivity (0.01 to 0.2)
+            sensitivity = Lerp(0.01f, 0.2f, sliderValue);
+
+            // Only re-renders the cached menu when the shown value changes
+            pauseMenu.setText(sensitivityLabel, TextFormat("Value: %.2f", sliderValue));
+        }
+    }
+}
+
+// Player movement and physics. Runs on the simulation thread, so it only
+// reads the sampled FrameInput and never calls into raylib's input functions.
+void Game::processEvents(const FrameInput& input) {
+    PROFILE_SCOPE("processEvents");
+    float deltaTime = input.deltaTime;
+
+    if (input.playing) {
         // --- 2. TOGGLES ---
-        if (IsKeyPressed(KEY_C)) isCrouching = !isCrouching;
-        if (IsKeyPressed(KEY_LEFT_SHIFT)) isSprinting = !isSprinting;
-        if (IsKeyPressed(KEY_G)) {
+        if (input.isPressed(INPUT_CROUCH)) isCrouching = !isCrouching;
+        if (input.isPressed(INPUT_SPRINT)) isSprinting = !isSprinting;
+        if (input.isPressed(INPUT_CREATIVE)) {
             isCreativeMode = !isCreativeMode;
             verticalVelocity = 0.0f;
         }
@@ -272,11 +815,25 @@ void Game::processEvents(float deltaTime) {
         speedMultiplier = Lerp(speedMultiplier, targetMult, 12.0f * deltaTime);
         float currentSpeed = baseSpeed * speedMultiplier;
 
-        // --- 4. MOVEMENT & COLLISION PREP ---
-        Vector3 nextPos = camera.position;
+        // --- 4. MOUSE LOOK (MANUAL VERSION) ---
+        // First, so this frame's movement goes where the player is looking
+        // now rather than where they were looking last frame
+        Vector2 mouseDelta = input.mouseDelta;
+
+        // 1. Update the internal Yaw and Pitch
+        // We use negative mouseDelta.y because screen coordinates are inverted
+        cameraYaw   += (mouseDelta.x * input.sensitivity);
+        cameraPitch -= (mouseDelta.y * input.sensitivity);
+
+        // 2. Clamp Pitch to prevent the camera from flipping over (somewhat less than 90 degrees)
+        if (cameraPitch > 89.0f)  cameraPitch = 89.0f;
+        if (cameraPitch < -89.0f) cameraPitch = -89.0f;
 
-        // Calculate the true direction vector (where the eyes are looking)
-        Vector3 lookDir = Vector3Normalize(Vector3Subtract(camera.target, camera.position));
+        // 3. The true direction vector (where the eyes are looking)
+        Vector3 lookDir = lookDirection(cameraYaw, cameraPitch);
+
+        // --- 5. MOVEMENT & COLLISION PREP ---
+        Vector3 nextPos = camera.position;
         Vector3 forward = lookDir;
 
         // ONLY lock to the horizontal plane if we are walking
@@ -289,13 +846,13 @@ void Game::processEvents(float deltaTime) {
         Vector3 right = Vector3CrossProduct(forward, camera.up);
 
         // Apply movement to nextPos
-        if (IsKeyDown(KEY_W)) nextPos = Vector3Add(camera.position, Vector3Scale(forward, currentSpeed * deltaTime));
-        if (IsKeyDown(KEY_S)) nextPos = Vector3Subtract(camera.position, Vector3Scale(forward, currentSpeed * deltaTime));
-        if (IsKeyDown(KEY_A)) nextPos = Vector3Subtract(camera.position, Vector3Scale(right, currentSpeed * deltaTime));
-        if (IsKeyDown(KEY_D)) nextPos = Vector3Add(camera.position, Vector3Scale(right, currentSpeed * deltaTime));
+        if (input.isDown(INPUT_FORWARD)) nextPos = Vector3Add(camera.position, Vector3Scale(forward, currentSpeed * deltaTime));
+        if (input.isDown(INPUT_BACK)) nextPos = Vector3Subtract(camera.position, Vector3Scale(forward, currentSpeed * deltaTime));
+        if (input.isDown(INPUT_LEFT)) nextPos = Vector3Subtract(camera.position, Vector3Scale(right, currentSpeed * deltaTime));
+        if (input.isDown(INPUT_RIGHT)) nextPos = Vector3Add(camera.position, Vector3Scale(right, currentSpeed * deltaTime));
 
         // 2. Smooth Boundary Check (Slide along the wall)
-        const float mapLimit = 497.5f; // Stay slightly inside the actual 500 edge
+        const float mapLimit = mapHalfSize - 2.5f; // Stay slightly inside the actual edge
 
         if (nextPos.x > mapLimit)  nextPos.x = mapLimit;
         if (nextPos.x < -mapLimit) nextPos.x = -mapLimit;
@@ -303,12 +860,16 @@ void Game::processEvents(float deltaTime) {
         if (nextPos.z < -mapLimit) nextPos.z = -mapLimit;
 
         // 3. Finally, apply the safe position
-        camera.position.x = nextPos.x;
-        camera.position.z = nextPos.z;
-
-        // NEW: If we are in creative mode, movement keys/look should affect height too!
         if (isCreativeMode) {
-            camera.position.y = nextPos.y;
+            // NEW: If we are in creative mode, movement keys/look should affect height too!
+            camera.position = nextPos;
+        } else {
+            // Walking: sweep the capsule over there, sliding along fences, trees
+            // and anything too steep, and stepping up small ledges
+            Vector3 feet = { camera.position.x, camera.position.y - currentEyeHeight, camera.position.z };
+            Vector3 move = Vector3Subtract(nextPos, camera.position);
+            feet = controller.moveHorizontal(collision, feet, currentEyeHeight + headroom, move, isGrounded);
+            camera.position = { feet.x, feet.y + currentEyeHeight, feet.z };
         }
 
         // Inside Game::processEvents, under your player movement logic:
@@ -321,65 +882,81 @@ void Game::processEvents(float deltaTime) {
             gameBall.velocity = Vector3Add(gameBall.velocity, Vector3Scale(pushDir, kickForce + 5.0f));
         }
 
-        // --- 5. PHYSICS & SLOPES ---
-        float terrainHeight = getMapHeightAt(camera.position.x, camera.position.z);
-        Vector3 groundNormal = getMapNormalAt(camera.position.x, camera.position.z);
-
+        // --- 6. PHYSICS & SLOPES ---
         float targetEyeHeight = isCrouching ? 0.8f : 1.5f;
 
-        // 1. Height Correction (The "Secret Sauce")
-        float oldEyeHeight = currentEyeHeight;
-        currentEyeHeight = Lerp(currentEyeHeight, targetEyeHeight, 12.0f * deltaTime);
-        float frameHeightChange = currentEyeHeight - oldEyeHeight;
-        camera.position.y += frameHeightChange;
+        if (!isCreativeMode) {
+            Vector3 feet = { camera.position.x, camera.position.y - currentEyeHeight, camera.position.z };
 
-        float floorY = terrainHeight + currentEyeHeight;
+            // 1. Height Correction: the feet stay put and the capsule grows or
+            // shrinks above them, but we won't stand up into a ceiling
+            float nextEyeHeight = Lerp(currentEyeHeight, targetEyeHeight, 12.0f * deltaTime);
+            if (controller.canGrow(collision, feet, currentEyeHeight + headroom, nextEyeHeight + headroom)) {
+                currentEyeHeight = nextEyeHeight;
+            }
+            float height = currentEyeHeight + headroom;
 
-        if (!isCreativeMode) {
             // 2. Gravity Logic: Only pull down if we aren't "grounded"
             if (!isGrounded) {
                 verticalVelocity -= 18.0f * deltaTime; // Gravity strength
             }
-            
-            camera.position.y += verticalVelocity * deltaTime;
 
             // 3. Jump Logic: Only allow if on the ground
-            if (IsKeyPressed(KEY_SPACE) && isGrounded) {
+            if (input.isPressed(INPUT_JUMP) && isGrounded) {
                 verticalVelocity = 8.0f; // Jump force
                 isGrounded = false;
             }
 
+            if (verticalVelocity != 0.0f) {
+                SweepHit hit;
+                bool blocked = false;
+                feet = controller.moveVertical(collision, feet, height, verticalVelocity * deltaTime, hit, blocked);
+
+                // Bumped our head, start falling
+                if (blocked && verticalVelocity > 0.0f) verticalVelocity = 0.0f;
+            }
+
             // 4. Ground Snapping & Collision
-            const float slopeLimit = 0.65f; // Steeper than this = slide
-            const float snapDistance = 0.25f; // How close to floor before we stick
-
-            // If we are moving down (or standing) and are at or below the "floor zone"
-            if (verticalVelocity <= 0 && camera.position.y <= floorY + snapDistance) {
-                
-                if (groundNormal.y >= slopeLimit) {
-                    // Safe Ground: Stick the player to the terrain
-                    camera.position.y = floorY; 
-                    verticalVelocity = 0.0f;
-                    isGrounded = true;
-                } else {
-                    // Too Steep: Slide off the slope
-                    isGrounded = false;
-                    // Calculate a slide vector based on the ground normal
-                    Vector3 slideDir = { groundNormal.x, 0, groundNormal.z };
-                    camera.position = Vector3Add(camera.position, Vector3Scale(slideDir, 10.0f * deltaTime));
-                    
-                    // Keep the player just slightly above the slope so they don't jitter
-                    if (camera.position.y < floorY) camera.position.y = floorY + 0.05f;
-                }
+            // If we are moving down (or standing) and there's floor within snapDistance
+            CharacterController::GroundInfo ground;
+            if (verticalVelocity <= 0.0f) ground = controller.probeGround(collision, feet, height);
+
+            if (ground.hit && ground.walkable) {
+                // Safe Ground: Stick the player to the terrain
+                feet.y -= fmaxf(0.0f, ground.distance - controller.settings.skin);
+                verticalVelocity = 0.0f;
+                isGrounded = true;
+            } else if (ground.hit) {
+                // Too Steep: Slide off the slope
+                isGrounded = false;
+                // Calculate a slide vector based on the ground normal
+                Vector3 slideDir = { ground.normal.x, 0, ground.normal.z };
+                feet = controller.moveHorizontal(collision, feet, height, Vector3Scale(slideDir, 10.0f * deltaTime), false);
             } else {
                 // We are actually in the air (jumping or falling off a cliff)
                 isGrounded = false;
             }
+
+            // Safety net: never end a frame under the terrain
+            float terrainHeight = getMapHeightAt(feet.x, feet.z);
+            if (feet.y < terrainHeight - 0.05f) feet.y = terrainHeight;
+
+            camera.position = { feet.x, feet.y + currentEyeHeight, feet.z };
         } 
         else {
+            float terrainHeight = getMapHeightAt(camera.position.x, camera.position.z);
+
+            // 1. Height Correction (The "Secret Sauce")
+            float oldEyeHeight = currentEyeHeight;
+            currentEyeHeight = Lerp(currentEyeHeight, targetEyeHeight, 12.0f * deltaTime);
+            float frameHeightChange = currentEyeHeight - oldEyeHeight;
+            camera.position.y += frameHeightChange;
+
+            float floorY = terrainHeight + currentEyeHeight;
+
             // Creative Mode: Elevator keys still work for precision
-            if (IsKeyDown(KEY_SPACE)) camera.position.y += currentSpeed * deltaTime;
-            if (IsKeyDown(KEY_LEFT_CONTROL)) camera.position.y -= currentSpeed * deltaTime;
+            if (input.isDown(INPUT_JUMP)) camera.position.y += currentSpeed * deltaTime;
+            if (input.isDown(INPUT_DESCEND)) camera.position.y -= currentSpeed * deltaTime;
             
             // Safety Floor Clamp: prevents flying through the map
             if (camera.position.y < floorY) camera.position.y = floorY;
@@ -388,186 +965,535 @@ void Game::processEvents(float deltaTime) {
             verticalVelocity = 0.0f; // Reset gravity speed so you don't fall when switching back
         }
 
-        // --- 6. MOUSE LOOK (MANUAL VERSION) ---
-        Vector2 mouseDelta = GetMouseDelta();
+        // --- 7. CAMERA TARGET ---
+        // The target is just the camera's final position + the direction we are looking
+        camera.target = Vector3Add(camera.position, lookDir);
+    }
+}
 
-        // 1. Update your internal Yaw and Pitch (add these to your Game or Camera class)
-        // We use negative mouseDelta.y because screen coordinates are inverted
-        cameraYaw   += (mouseDelta.x * sensitivity);
-        cameraPitch -= (mouseDelta.y * sensitivity);
+// Copy what the renderer needs out of the live game state.
+// Runs at the end of the simulation step, on the simulation thread.
+void Game::buildSnapshot(RenderSnapshot& out) {
+    PROFILE_SCOPE("buildSnapshot");
+    out.camera = camera;
+    out.yaw = cameraYaw;
+    out.pitch = cameraPitch;
+    out.ballPosition = gameBall.position;
+    out.ballRadius = gameBall.radius;
+
+    // Cull here so the main thread only ever sees objects it has to draw.
+    // It may turn the view a little before drawing (late latch), so the
+    // frustum is widened by a margin on every side.
+    Camera3D cullCamera = camera;
+    float cullAspect = viewAspect;
+    if (config.lateLatch && !config.flythrough) {
+        float halfV = DEG2RAD * 0.5f * camera.fovy;
+        float halfH = atanf(viewAspect * tanf(halfV));
+        float margin = DEG2RAD * latchMarginDeg;
+        float limit = DEG2RAD * 85.0f;
+        halfV = fminf(halfV + margin, limit);
+        halfH = fminf(halfH + margin, limit);
+        cullCamera.fovy = RAD2DEG * 2.0f * halfV;
+        cullAspect = tanf(halfH) / tanf(halfV);
+    }
+    Frustum frustum = Frustum::fromCamera(cullCamera, cullAspect);
 
-        // 2. Clamp Pitch to prevent the camera from flipping over (somewhat less than 90 degrees)
-        if (cameraPitch > 89.0f)  cameraPitch = 89.0f;
-        if (cameraPitch < -89.0f) cameraPitch = -89.0f;
+    out.visibleMapChunks = FrameList<int>(out.arena, mapChunkBounds.size());
+    for (int i = 0; i < (int)mapChunkBounds.size(); i++) {
+        const BoundingBox& b = mapChunkBounds[i];
+        Vector3 center = Vector3Scale(Vector3Add(b.min, b.max), 0.5f);
+        if (frustum.containsSphere(center, Vector3Distance(b.min, b.max) * 0.5f)) out.visibleMapChunks.push_back(i);
+    }
 
-        // 3. Calculate the Direction Vector from Yaw/Pitch
-        // Standard 3D Cartesian conversion
-        Vector3 direction;
-        direction.x = cosf(DEG2RAD * cameraYaw) * cosf(DEG2RAD * cameraPitch);
-        direction.y = sinf(DEG2RAD * cameraPitch);
-        direction.z = sinf(DEG2RAD * cameraYaw) * cosf(DEG2RAD * cameraPitch);
-
-        // 4. Update the Camera Target
-        // The target is just the camera's position + the direction we are looking
-        camera.target = Vector3Add(camera.position, direction);
-
-        // --- 7. TREE COLLISION ---
-        for (auto& obj : sceneObjects) {
-            if (obj.isTree) {
-                float dist = Vector2Distance({camera.position.x, camera.position.z}, {obj.position.x, obj.position.z});
-                float radius = 2.0f * obj.scale.x / 10.0f;
-                if (dist < radius) {
-                    Vector2 push = Vector2Scale(Vector2Normalize(Vector2Subtract({camera.position.x, camera.position.z}, {obj.position.x, obj.position.z})), radius - dist);
-                    camera.position.x += push.x;
-                    camera.position.z += push.y;
-                }
-            }
+    out.visibleObjects = FrameList<RenderInstance>(out.arena, sceneObjects.size());
+    for (const auto& obj : sceneObjects) {
+        if (frustum.containsSphere(obj.boundsCenter, obj.boundsRadius)) {
+            out.visibleObjects.push_back({ &obj.model, obj.transform });
         }
-    } // Inside the Paused branch of processEvents
-    else if (currentState == GameState::Paused) {
-        Vector2 mousePos = GetMousePosition();
-
-        if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-            if (CheckCollisionPointRec(mousePos, resumeBtnRect)) {
-                currentState = GameState::Playing;
-                DisableCursor();
-            }
-            if (CheckCollisionPointRec(mousePos, exitBtnRect)) {
-                // No easy way to break the loop here, so:
-                // Either use a flag or just call exit(0)
-                exit(0); 
+    }
+
+    out.visibleHorde = FrameList<Vector3>(out.arena, horde.size());
+    for (int i = 0; i < horde.size(); i++) {
+        Vector3 feet = horde.getPosition(i);
+        if (frustum.containsSphere({ feet.x, feet.y + 0.9f, feet.z }, 1.0f)) out.visibleHorde.push_back(feet);
+    }
+
+    out.visibleBalls = FrameList<Vector3>(out.arena, stressBalls.size());
+    for (const Ball& ball : stressBalls) {
+        if (frustum.containsSphere(ball.position, ball.radius)) out.visibleBalls.push_back(ball.position);
+    }
+
+    out.visibleAgents = FrameList<Vector3>(out.arena, wanderers.size());
+    wanderers.forEach([&](const Wanderer& w) {
+        Vector3 center = { w.position.x, w.position.y + 0.9f, w.position.z };
+        if (frustum.containsSphere(center, 1.0f)) out.visibleAgents.push_back(w.position);
+    });
+}
+
+void Game::updateHorde(float deltaTime) {
+    PROFILE_SCOPE("horde");
+    Vector3 feet = { camera.position.x, camera.position.y - currentEyeHeight, camera.position.z };
+    hordeField.update(feet, jobs);
+    horde.update(deltaTime, hordeField, navMesh, feet);
+}
+
+// --flythrough: fly the recorded path once, then quit and report
+void Game::startFlythrough() {
+    if (!cameraPath.load(config.flythroughPath)) {
+        TraceLog(LOG_ERROR, "FLYTHROUGH: Couldn't load a camera path from %s", config.flythroughPath);
+        quitRequested = true;
+        return;
+    }
+
+    isCreativeMode = true;
+    flythroughTime = 0.0f;
+
+    // One entry per 60 Hz step, and some slack for the pipeline filling up
+    frameLog.reserve((size_t)(cameraPath.getDuration() * 60.0f) + 16);
+    frameLogPath = "flythrough.csv";
+    TraceLog(LOG_INFO, "FLYTHROUGH: %d keys, %.1f s at %.0f m/s", cameraPath.size(), cameraPath.getDuration(), cameraPath.speed);
+}
+
+// --replay: play a recorded session back frame for frame, then quit and report
+void Game::startReplay() {
+    if (!inputReplay.load(config.replayPath, config)) {
+        TraceLog(LOG_ERROR, "INPUT: Couldn't load a recording from %s", config.replayPath);
+        quitRequested = true;
+        return;
+    }
+
+    deterministic = true;
+    frameLog.reserve((size_t)inputReplay.getFrameCount() + 16);
+    frameLogPath = "replay.csv";
+}
+
+// --stress: report per scope at the end, and log every frame if there's an end
+void Game::startStress() {
+    profiler::setEnabled(true);
+    stressFramesLeft = config.stress.frames;
+
+    // Flythroughs and replays already log, and stop on their own
+    if (!frameLogPath && stressFramesLeft > 0) {
+        frameLog.reserve((size_t)stressFramesLeft + 16);
+        frameLogPath = "stress.csv";
+    }
+}
+
+// Stands in for processEvents during a flythrough, on the simulation thread
+void Game::updateFlythrough(float deltaTime) {
+    CameraPath::Key key = cameraPath.sample(flythroughTime);
+    camera.position = key.position;
+    cameraYaw = key.yaw;
+    cameraPitch = key.pitch;
+
+    // Same look direction the mouse look builds from yaw and pitch
+    camera.target = Vector3Add(camera.position, lookDirection(cameraYaw, cameraPitch));
+
+    flythroughTime += deltaTime;
+    if (flythroughTime > cameraPath.getDuration()) flythroughDone = true;
+}
+
+// F6: fly somewhere in creative mode, press it, repeat. Every key is saved
+// straight away, the first one starts a new file.
+void Game::recordPathKey() {
+    // The camera being drawn, the simulation thread owns the live one
+    const Camera3D& view = snapshots[renderIndex].camera;
+    Vector3 direction = Vector3Normalize(Vector3Subtract(view.target, view.position));
+    cameraPath.add({ view.position, RAD2DEG * atan2f(direction.z, direction.x), RAD2DEG * asinf(direction.y) });
+
+    if (cameraPath.save(config.flythroughPath)) {
+        TraceLog(LOG_INFO, "FLYTHROUGH: Key %d saved to %s", cameraPath.size(), config.flythroughPath);
+    }
+    steadyFrames = 0;
+}
+
+void Game::updateWanderers(float deltaTime) {
+    PROFILE_SCOPE("wanderers");
+
+    // 1. Collect the last batch of paths once the workers are done with it
+    if (deterministic && !pathOwners.empty()) jobs.wait(pathJobs);
+    if (!pathOwners.empty() && JobSystem::isDone(pathJobs)) {
+        for (size_t i = 0; i < pathOwners.size(); i++) {
+            Wanderer& w = *pathOwners[i];
+            w.waiting = false;
+            if (pathResults[i].found) {
+                // Swap rather than move, so the old path's buffer is reused
+                // by the next query instead of freed
+                w.path.swap(pathResults[i].points);
+                w.nextPoint = 1;
             }
-            if (CheckCollisionPointRec(mousePos, sliderHandleRect)) draggingSlider = true;
         }
+        pathOwners.clear();
+    }
 
-        if (IsMouseButtonReleased(MOUSE_LEFT_BUTTON)) draggingSlider = false;
+    // 2. Everyone who arrived gets a new destination, all in one batch
+    if (pathOwners.empty()) {
+        std::uniform_real_distribution<float> goal(-(mapHalfSize - 50.0f), mapHalfSize - 50.0f);
+        pathRequests.clear();
 
-        if (draggingSlider) {
-            float mouseX = Clamp(GetMousePosition().x, sliderTrackRect.x, sliderTrackRect.x + sliderTrackRect.width);
-            
-            // 1. Calculate visual 0.0 to 1.0
-            sliderValue = (mouseX - sliderTrackRect.x) / sliderTrackRect.width;
-            
-            // 2. Map that to the math sensitivity (0.01 to 0.2)
-            sensitivity = Lerp(0.01f, 0.2f, sliderValue);
+        wanderers.forEach([&](Wanderer& w) {
+            if (w.waiting || w.nextPoint < (int)w.path.size()) return;
+
+            pathRequests.push_back({ w.position, { goal(wanderRng), 0.0f, goal(wanderRng) } });
+            pathOwners.push_back(&w);
+            w.waiting = true;
+        });
+
+        if (!pathRequests.empty()) navMesh.findPaths(jobs, pathRequests, pathResults, pathJobs);
+    }
+
+    // 3. Walk along the paths, glued to the navmesh surface
+    const float walkSpeed = 3.0f;
+    wanderers.forEach([&](Wanderer& w) {
+        float step = walkSpeed * deltaTime;
+
+        while (step > 0.0f && w.nextPoint < (int)w.path.size()) {
+            Vector3 target = w.path[w.nextPoint];
+            Vector2 toTarget = { target.x - w.position.x, target.z - w.position.z };
+            float dist = Vector2Length(toTarget);
+
+            if (dist <= step) {
+                w.position.x = target.x;
+                w.position.z = target.z;
+                step -= dist;
+                w.nextPoint++;
+            } else {
+                w.position.x += toTarget.x / dist * step;
+                w.position.z += toTarget.y / dist * step;
+                step = 0.0f;
+            }
         }
+
+        w.position.y = navMesh.getHeightAt(w.position.x, w.position.z);
+    });
+}
+
+void Game::simulate(const FrameInput& input, RenderSnapshot& out) {
+    if (config.flythrough) updateFlythrough(input.deltaTime);
+    else processEvents(input);
+    updateBall(input.deltaTime);
+    if (input.playing) {
+        updateWanderers(input.deltaTime);
+        updateHorde(input.deltaTime);
+    }
+    buildSnapshot(out);
+}
+
+void Game::simulationLoop() {
+    trace::setThreadName("simulation");
+    std::unique_lock<std::mutex> lock(simMutex);
+
+    while (true) {
+        simWake.wait(lock, [this] { return simPending || simQuit; });
+        if (simQuit) return;
+
+        // The snapshot the main thread isn't reading
+        FrameInput input = simInput;
+        RenderSnapshot& out = snapshots[1 - renderIndex];
+
+        lock.unlock();
+        uint64_t allocationsBefore = memory::getAllocationCount();
+        auto simStart = std::chrono::steady_clock::now();
+        simulate(input, out);
+        simMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - simStart).count();
+        simAllocations = memory::getAllocationCount() - allocationsBefore;
+        lock.lock();
+
+        simPending = false;
+        simFinished.notify_one();
     }
 }
 
-// Run the game by calling process_events and drawing everything
+void Game::kickSimulation(const FrameInput& input) {
+    {
+        std::lock_guard<std::mutex> lock(simMutex);
+        simInput = input;
+        simPending = true;
+    }
+    simWake.notify_one();
+}
+
+void Game::waitForSimulation() {
+    PROFILE_SCOPE("wait for sim");
+    std::unique_lock<std::mutex> lock(simMutex);
+    simFinished.wait(lock, [this] { return !simPending; });
+}
+
+// Queue up everything in the 3D world for this frame
+void Game::submitScene(const RenderSnapshot& snapshot) {
+    PROFILE_SCOPE("scene submit");
+    renderQueue.begin(snapshot.camera.position);
+
+    // Draw the Map, just the chunks in view
+    for (int i : snapshot.visibleMapChunks) {
+        renderQueue.submitMesh(mapModel.meshes[i], mapModel.materials[mapModel.meshMaterial[i]], mapModel.transform);
+    }
+
+    // 1. The Core (Brightest part)
+    Vector3 ballPos = snapshot.ballPosition;
+    float r = snapshot.ballRadius;
+    Matrix ballWorld = MatrixMultiply(MatrixScale(r, r, r), MatrixTranslate(ballPos.x, ballPos.y, ballPos.z));
+    renderQueue.submitMesh(ballMesh, ballMaterial, ballWorld);
+
+    // 2. The Detail Lines
+    renderQueue.submitSphereWires(ballPos, r + 0.1f, BLACK);
+
+    // --stress balls, no wires, there can be thousands
+    for (const Vector3& center : snapshot.visibleBalls) {
+        renderQueue.submitMesh(ballMesh, ballMaterial, MatrixTranslate(center.x, center.y, center.z));
+    }
+
+    // Draw all objects with their specific rotation and scale
+    for (const RenderInstance& inst : snapshot.visibleObjects) {
+        renderQueue.submitModel(*inst.model, inst.transform);
+    }
+
+    // Wanderers
+    for (const Vector3& feet : snapshot.visibleAgents) {
+        Matrix world = MatrixMultiply(MatrixScale(0.4f, 0.9f, 0.4f), MatrixTranslate(feet.x, feet.y + 0.9f, feet.z));
+        renderQueue.submitMesh(ballMesh, agentMaterial, world);
+    }
+
+    // Horde: plain boxes, they all go out in a handful of batched draws
+    for (const Vector3& feet : snapshot.visibleHorde) {
+        renderQueue.submitCube({ feet.x, feet.y + 0.9f, feet.z }, { 0.6f, 1.8f, 0.6f }, DARKGREEN);
+    }
+}
+
+// Run the game as a two stage pipeline:
+//   simulation thread -> processEvents/updateBall for frame N+1
+//   main thread       -> input sampling and GL submission for frame N
+// so on multi-core machines a frame costs max(sim, render) instead of the sum.
 void Game::run() {
-    while (!WindowShouldClose()) {
+    // Prime the pipeline so the first rendered frame has something in it
+    simulate(FrameInput{}, snapshots[renderIndex]);
+    simThread = std::thread(&Game::simulationLoop, this);
+    auto lastFrame = std::chrono::steady_clock::now();
+    inputTime = lastInputTime = lastFrame;
+
+    while (!WindowShouldClose() && !quitRequested) {
         float deltaTime = GetFrameTime();
-        
-        // Update logic
-        processEvents(deltaTime);
-        updateBall(deltaTime);
-
-        BeginDrawing();
-            ClearBackground(SKYBLUE);
-
-            BeginMode3D(camera);
-                // Draw the Map
-                DrawModel(mapModel, {0,0,0}, 1.0f, WHITE);
-
-                // 1. The Core (Brightest part)
-                DrawSphere(gameBall.position, gameBall.radius, ORANGE);
-
-                // // 2. The Glow (Slightly larger, semi-transparent)
-                // DrawSphere(gameBall.position, gameBall.radius * 1.1f, Fade(LIME, 0.3f));
-
-                // 3. The Detail Lines
-                DrawSphereWires(gameBall.position, gameBall.radius + 0.1, 10, 10, BLACK);
-
-                // Draw all objects with their specific rotation and scale
-                for (auto& obj : sceneObjects) {
-                    if (obj.isTree) {
-                        // Trees usually grow straight up regardless of slope
-                        DrawModelEx(obj.model, obj.position, {0, 1, 0}, obj.rotation.y, obj.scale, WHITE);
-                    } else {
-                        // Fences should align to the ground normal
-                        // Rotate {0,1,0} (default up) to match groundNormal
-                        Quaternion q = QuaternionFromVector3ToVector3({0, 1, 0}, obj.groundNormal);
-                        
-                        // Combine with the fence's path rotation (around the new normal)
-                        Quaternion pathRot = QuaternionFromAxisAngle(obj.groundNormal, obj.rotation.y * DEG2RAD);
-                        Quaternion finalRot = QuaternionMultiply(pathRot, q);
-                        
-                        // Convert back to Axis-Angle for DrawModelEx
-                        Vector3 axis;
-                        float angle;
-                        QuaternionToAxisAngle(finalRot, &axis, &angle);
-                        
-                        DrawModelEx(obj.model, obj.position, axis, angle * RAD2DEG, obj.scale, WHITE);
-                    }
-                }
-            EndMode3D();
-
-            // --- 2D UI LAYER ---
+        uint64_t allocationsBefore = memory::getAllocationCount();
+        uint64_t jobAllocationsBefore = memory::getJobAllocationCount();
+
+        // The simulation thread is idle and the snapshot it fills next was
+        // drawn last frame, so its lists can all go at once
+        snapshots[1 - renderIndex].arena.reset();
+
+        // Input has to be read here, raylib isn't thread safe
+        processMenuEvents();
+        FrameInput input = sampleFrameInput(deltaTime);
+        inputTime = std::chrono::steady_clock::now();
+        input.playing = (currentState == GameState::Playing);
+        input.sensitivity = sensitivity;
+
+        // --replay: the recorded frame stands in for the live one
+        if (inputReplay.isLoaded() && !inputReplay.next(input)) break;
+
+        // Benchmarks step by a fixed 60 Hz, however long frames really take
+        if (config.flythrough || config.replayFixedStep) input.deltaTime = 1.0f / 60.0f;
+
+        inputRecorder.record(input);
+
+        kickSimulation(input);
+        auto renderStart = std::chrono::steady_clock::now();
+        renderFrame(snapshots[renderIndex], input);
+        float mainMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - renderStart).count();
+        waitForSimulation();
+        checkFrameAllocations(memory::getAllocationCount() - allocationsBefore + simAllocations +
+                              memory::getJobAllocationCount() - jobAllocationsBefore);
+
+        // Both threads are done with the frame, close it in the history
+        profiler::endFrame(deltaTime * 1000.0f, dynamicRes.getGpuMs(), uiTimer.getLastMs());
+        trace::endFrame();
+
+        auto frameEnd = std::chrono::steady_clock::now();
+        if (frameLogPath) {
+            const RenderStats& stats = renderQueue.getStats();
+            float frameMs = std::chrono::duration<float, std::milli>(frameEnd - lastFrame).count();
+            frameLog.add({ frameMs, mainMs, simMs, dynamicRes.getLastGpuMs() + uiTimer.getLastMs(), stats.drawCalls, stats.triangles });
+        }
+        if (flythroughDone) quitRequested = true;
+        if (stressFramesLeft > 0 && --stressFramesLeft == 0) quitRequested = true;
+        lastFrame = frameEnd;
+
+        // The freshly simulated frame becomes next frame's render work
+        renderIndex = 1 - renderIndex;
+        lastInputTime = inputTime;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(simMutex);
+        simQuit = true;
+    }
+    simWake.notify_one();
+    simThread.join();
+
+    // Path jobs write into our vectors, let them land before anything is torn down
+    jobs.wait(pathJobs);
+
+    inputRecorder.stop();
+
+    if (frameLogPath) {
+        const char* label = config.flythrough ? "FLYTHROUGH" : (config.replayPath ? "REPLAY" : "STRESS");
+        if (frameLog.writeCsv(frameLogPath)) TraceLog(LOG_INFO, "%s: Per-frame log written to %s", label, frameLogPath);
+        frameLog.logSummary(label);
+    }
+
+    // --stress: where the time went, per scope, and what it cost in memory
+    if (config.stress.enabled) {
+        profiler::logSummary("STRESS");
+        TraceLog(LOG_INFO, "STRESS: %.1f MB resident at exit", memory::getResidentBytes() / (1024.0f * 1024.0f));
+    }
+}
+
+// Everything that reads mesh vertices (collision, bounds, the navmesh bake)
+// has run by now. What's left in RAM for the map is the quantised collision
+// copy, which answers the height and normal lookups as well.
+void Game::releaseMeshData() {
+    const float megabyte = 1024.0f * 1024.0f;
+
+    if (vertexStats.meshes > 0) {
+        TraceLog(LOG_INFO, "MEMORY: Packed %d meshes, %.2f MB -> %.2f MB of vertex buffers", vertexStats.meshes,
+                 vertexStats.floatBytes / megabyte, vertexStats.packedBytes / megabyte);
+    }
+
+    if (config.keepMeshData) {
+        meshMemory.report();
+    } else {
+        meshMemory.release();
+    }
+
+    TraceLog(LOG_INFO, "MEMORY: terrain collision %.2f MB", collision.getTerrain().getMemoryBytes() / megabyte);
+}
+
+// Worst case for one frame: every object, chunk and agent in view at once
+void Game::reserveFrameMemory() {
+    size_t arenaBytes = mapChunkBounds.size() * sizeof(int)
+                      + sceneObjects.size() * sizeof(RenderInstance)
+                      + (size_t)(horde.size() + wanderers.size() + stressBalls.size()) * sizeof(Vector3)
+                      + 5 * alignof(std::max_align_t);
+    for (RenderSnapshot& snapshot : snapshots) snapshot.arena.init(arenaBytes);
+
+    // Ball and its wires, then one packet per mesh of everything else
+    size_t packets = 2 + mapChunkBounds.size() + wanderers.size() + (size_t)horde.size() + stressBalls.size();
+    for (const GameObject& obj : sceneObjects) packets += obj.model.meshCount;
+    renderQueue.reserve(packets);
+}
+
+// Once the game has been played undisturbed for a couple of seconds, neither
+// thread (nor the jobs they hand out) should touch the heap in a frame. Menus and the frames right after
+// them (caches filling, buffers settling on their size) are exempt.
+void Game::checkFrameAllocations(uint64_t allocations) {
+#if defined(MEMORY_TRACKING)
+    const int warmupFrames = 120;
+    if (currentState != GameState::Playing) {
+        steadyFrames = 0;
+        return;
+    }
+    if (++steadyFrames <= warmupFrames) return;
+
+    if (allocations > 0) {
+        TraceLog(LOG_ERROR, "MEMORY: %llu heap allocations in a steady-state frame", (unsigned long long)allocations);
+        assert(allocations == 0 && "The frame loop allocated");
+    }
+#else
+    (void)allocations;
+#endif
+}
+
+// Only while the simulation applies mouse look itself, so the view never
+// turns by input it will ignore
+bool Game::isLatching(const FrameInput& input) const {
+    return config.lateLatch && input.playing && !config.flythrough;
+}
+
+// The snapshot's camera turned by this frame's mouse delta, the same steps
+// processEvents takes with it. Next frame's snapshot then starts from
+// exactly this pose, so the view never jumps back. raylib only polls input
+// in EndDrawing, so the delta sampled at the top of the frame is already
+// the newest there is.
+Camera3D Game::latchCamera(const RenderSnapshot& snapshot, const FrameInput& input) const {
+    // Culling only left latchMarginDeg either side, so a bigger flick is cut
+    // short here and the rest shows up a frame later with the simulation
+    float yawDelta = Clamp(input.mouseDelta.x * input.sensitivity, -latchMarginDeg, latchMarginDeg);
+    float pitchDelta = Clamp(input.mouseDelta.y * input.sensitivity, -latchMarginDeg, latchMarginDeg);
+    float yaw = snapshot.yaw + yawDelta;
+    float pitch = Clamp(snapshot.pitch - pitchDelta, -89.0f, 89.0f);
+
+    Camera3D view = snapshot.camera;
+    view.target = Vector3Add(view.position, lookDirection(yaw, pitch));
+    return view;
+}
+
+void Game::renderFrame(const RenderSnapshot& snapshot, const FrameInput& input) {
+    submitScene(snapshot);
+
+    // --- 3D PASS (dynamic resolution) ---
+    dynamicRes.beginScene();
+        ClearBackground(SKYBLUE);
+
+        // The view matrix is set as late as it can be. The latency marker is
+        // how old the newest mouse input in it is by now: this frame's when
+        // latched, last frame's when drawn as simulated.
+        bool latched = isLatching(input);
+        Camera3D view = latched ? latchCamera(snapshot, input) : snapshot.camera;
+        PROFILE_SINCE("input latency", latched ? inputTime : lastInputTime);
+
+        BeginMode3D(view);
+        {
+            PROFILE_SCOPE("scene draw");
+            renderQueue.execute();
+        }
+        EndMode3D();
+    dynamicRes.endScene();
+
+    BeginDrawing();
+        dynamicRes.present();
+
+        // --- 2D UI LAYER ---
+        uiTimer.begin();
+        {
+            PROFILE_SCOPE("UI");
+
             if (currentState == GameState::Playing) {
-                if (IsMouseButtonDown(MOUSE_BUTTON_RIGHT)) {
-                    int centerX = GetScreenWidth() / 2;
-                    int centerY = GetScreenHeight() / 2;
-                    DrawCircle(centerX, centerY, 4, WHITE); // Clean dot crosshair
-                    DrawCircleLines(centerX, centerY, 10, Fade(WHITE, 0.5f)); // Subtle ring
-                }
+                hud.setVisible(crosshair, IsMouseButtonDown(MOUSE_BUTTON_RIGHT));
+                hud.draw(text);
             }
 
             if (currentState == GameState::Paused) {
-                float sw = (float)GetScreenWidth();
-                float sh = (float)GetScreenHeight();
-
-                // 1. Dark Overlay
-                DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), Fade(BLACK, 0.7f));
-
-                // 2. Menu Background
-                DrawRectangleRec(pauseMenuRect, Color{ 40, 40, 40, 220 });
-
-                // 3. Title Text
-                int fontSize = (int)(sh * 0.05f);
-                int textWidth = MeasureText("PAUSED", fontSize);
-                DrawText("PAUSED", sw/2 - textWidth/2, pauseMenuRect.y + (pauseMenuRect.height * 0.05f), fontSize, WHITE);
-
-                // 4. Buttons
-                DrawRectangleRec(resumeBtnRect, Color{ 0, 0, 0, 180 });
-                DrawRectangleRec(exitBtnRect, Color{ 0, 0, 0, 180 });
-
-                // 5. Button Labels (Using 60% of button height)
-                int labelSize = (int)(resumeBtnRect.height * 0.6f);
-                DrawText("RESUME", resumeBtnRect.x + (resumeBtnRect.width/2 - MeasureText("RESUME", labelSize)/2), 
-                        resumeBtnRect.y + (resumeBtnRect.height/2 - labelSize/2), labelSize, WHITE);
-                
-                DrawText("EXIT", exitBtnRect.x + (exitBtnRect.width/2 - MeasureText("EXIT", labelSize)/2), 
-                        exitBtnRect.y + (exitBtnRect.height/2 - labelSize/2), labelSize, WHITE);
-
-
-                // 1. Update handle position based on sliderValue
-                sliderHandleRect.x = sliderTrackRect.x + (sliderValue * sliderTrackRect.width) - (sliderHandleRect.width / 2.0f);
-                sliderHandleRect.y = sliderTrackRect.y + (sliderTrackRect.height / 2.0f) - (sliderHandleRect.height / 2.0f);
-
-                // 2. Draw Track and Handle
-                DrawRectangleRec(sliderTrackRect, GRAY); 
-                DrawRectangleRec(sliderHandleRect, WHITE); 
-
-                // 3. Draw "MOUSE SENSITIVITY" Header
-                DrawText("MOUSE SENSITIVITY", sw/2 - MeasureText("MOUSE SENSITIVITY", 20)/2, 
-                        sliderTrackRect.y - pauseMenuRect.height * 0.05, 20, WHITE);
-
-                // 4. Draw the Value BELOW the slider
-                // We show the sliderValue (0.00 to 1.00) here
-                const char* sensText = TextFormat("Value: %.2f", sliderValue);
-                int sensTextWidth = MeasureText(sensText, 20);
-                DrawText(sensText, sw/2 - sensTextWidth/2, sliderTrackRect.y + pauseMenuRect.height * 0.04, 20, WHITE);
+                pauseMenu.draw(text);
             }
 
-        EndDrawing();
-    }
+            // F3, on top of everything else
+            if (showProfiler) {
+                profiler::drawOverlay(text, 10.0f, 10.0f);
+                text.flush();
+            }
+        }
+        uiTimer.end();
+
+    EndDrawing();
+
+    dynamicRes.update();
+    uiTimer.poll();
 }
 
 Game::~Game() {
+    jobs.shutdown();
+    trace::shutdown();
+    dynamicRes.shutdown();
+    uiTimer.shutdown();
+    pauseMenu.unload();
+    hud.unload();
+    text.shutdown();
     UnloadModel(mapModel);
     UnloadTexture(grassTexture);
     UnloadTexture(rockTexture);
+    UnloadMesh(ballMesh);
+    UnloadMaterial(ballMaterial);
+    UnloadMaterial(agentMaterial);
+    if (packedModelShader.id != 0) UnloadShader(packedModelShader);
     
     // Unload everything in your sceneObjects list if they aren't using the templates
     // But since they use shared models, just unload the main templates you loaded
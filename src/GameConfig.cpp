@@ -0,0 +1,119 @@
+#include "GameConfig.hpp"
+#include "raylib.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+    // "--name=value" -> value, or nullptr if arg is a different option
+    const char* optionValue(const char* arg, const char* name) {
+        size_t length = strlen(name);
+        if (strncmp(arg, name, length) != 0 || arg[length] != '=') return nullptr;
+        return arg + length + 1;
+    }
+
+    // One stress setting, from --stress-<key>=value or a line of the --stress file
+    bool setStressOption(GameConfig::Stress& stress, const char* key, const char* value) {
+        if (strcmp(key, "species") == 0) {
+            stress.species = value;
+            return !stress.species.empty();
+        }
+
+        char* end = nullptr;
+        long number = strtol(value, &end, 10);
+        if (end == value || *end != '\0' || number < 0) return false;
+
+        if (strcmp(key, "fences") == 0) stress.fences = (int)number;
+        else if (strcmp(key, "trees") == 0) stress.trees = (int)number;
+        else if (strcmp(key, "balls") == 0) stress.balls = (int)number;
+        else if (strcmp(key, "props") == 0) stress.props = (int)number;
+        else if (strcmp(key, "frames") == 0) stress.frames = (int)number;
+        else if (strcmp(key, "seed") == 0) stress.seed = (uint32_t)number;
+        else return false;
+        return true;
+    }
+
+    // key=value per line, '#' comments, spaces around either side are fine
+    bool loadStressFile(GameConfig::Stress& stress, const char* path) {
+        FILE* file = fopen(path, "r");
+        if (!file) return false;
+
+        char line[512];
+        while (fgets(line, sizeof(line), file)) {
+            char* hash = strchr(line, '#');
+            if (hash) *hash = '\0';
+
+            char key[64], value[448];
+            if (sscanf(line, " %63[^= \t] = %447s", key, value) != 2) continue;
+            if (!setStressOption(stress, key, value)) TraceLog(LOG_WARNING, "CONFIG: Bad stress setting '%s=%s' in %s", key, value, path);
+        }
+        fclose(file);
+        return true;
+    }
+}
+
+GameConfig GameConfig::fromArgs(int argc, char** argv) {
+    GameConfig config;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = nullptr;
+        char* end = nullptr;
+
+        if ((value = optionValue(arg, "--terrain"))) {
+            if (strcmp(value, "towers") == 0) config.terrain = Terrain::Towers;
+            else if (strcmp(value, "procedural") == 0) config.terrain = Terrain::Procedural;
+            else TraceLog(LOG_WARNING, "CONFIG: Unknown terrain '%s', using towers", value);
+        } else if ((value = optionValue(arg, "--seed"))) {
+            unsigned long seed = strtoul(value, &end, 10);
+            if (end != value && *end == '\0') config.seed = (uint32_t)seed;
+            else TraceLog(LOG_WARNING, "CONFIG: Bad seed '%s'", value);
+        } else if ((value = optionValue(arg, "--map-size"))) {
+            float size = strtof(value, &end);
+            if (end != value && *end == '\0' && size >= 64.0f) config.mapSize = size;
+            else TraceLog(LOG_WARNING, "CONFIG: Bad map size '%s' (at least 64)", value);
+        } else if ((value = optionValue(arg, "--mesh-data"))) {
+            if (strcmp(value, "release") == 0) config.keepMeshData = false;
+            else if (strcmp(value, "keep") == 0) config.keepMeshData = true;
+            else TraceLog(LOG_WARNING, "CONFIG: Unknown mesh data mode '%s', using release", value);
+        } else if ((value = optionValue(arg, "--vertex-format"))) {
+            if (strcmp(value, "float") == 0) config.vertexFormat = VertexFormat::Float;
+            else if (strcmp(value, "packed") == 0) config.vertexFormat = VertexFormat::Packed;
+            else TraceLog(LOG_WARNING, "CONFIG: Unknown vertex format '%s', using float", value);
+        } else if ((value = optionValue(arg, "--pack"))) {
+            config.packPath = (strcmp(value, "none") == 0) ? nullptr : value;
+        } else if ((value = optionValue(arg, "--mouse-look"))) {
+            if (strcmp(value, "latched") == 0) config.lateLatch = true;
+            else if (strcmp(value, "simulated") == 0) config.lateLatch = false;
+            else TraceLog(LOG_WARNING, "CONFIG: Unknown mouse look mode '%s', using latched", value);
+        } else if (strcmp(arg, "--flythrough") == 0) {
+            config.flythrough = true;
+        } else if ((value = optionValue(arg, "--flythrough"))) {
+            config.flythrough = true;
+            config.flythroughPath = value;
+        } else if ((value = optionValue(arg, "--record"))) {
+            config.recordPath = value;
+        } else if ((value = optionValue(arg, "--replay"))) {
+            config.replayPath = value;
+        } else if ((value = optionValue(arg, "--replay-step"))) {
+            if (strcmp(value, "recorded") == 0) config.replayFixedStep = false;
+            else if (strcmp(value, "fixed") == 0) config.replayFixedStep = true;
+            else TraceLog(LOG_WARNING, "CONFIG: Unknown replay step '%s', using recorded", value);
+        } else if ((value = optionValue(arg, "--stress"))) {
+            config.stress.enabled = true;
+            if (!loadStressFile(config.stress, value)) TraceLog(LOG_WARNING, "CONFIG: Can't read stress file '%s'", value);
+        } else if (strncmp(arg, "--stress-", 9) == 0 && strchr(arg, '=')) {
+            std::string key(arg + 9, strchr(arg, '='));
+            config.stress.enabled = true;
+            if (!setStressOption(config.stress, key.c_str(), strchr(arg, '=') + 1)) TraceLog(LOG_WARNING, "CONFIG: Bad stress option '%s'", arg);
+        } else if ((value = optionValue(arg, "--trace"))) {
+            long frames = strtol(value, &end, 10);
+            if (end != value && *end == '\0' && frames > 0) config.traceFrames = (int)frames;
+            else TraceLog(LOG_WARNING, "CONFIG: Bad trace frame count '%s'", value);
+        } else {
+            TraceLog(LOG_WARNING, "CONFIG: Unknown option '%s'", arg);
+        }
+    }
+
+    return config;
+}
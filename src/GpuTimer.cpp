@@ -0,0 +1,58 @@
+#include "GpuTimer.hpp"
+#include "GLExt.hpp"
+#include "rlgl.h"
+
+GpuTimer::~GpuTimer() {
+    shutdown();
+}
+
+bool GpuTimer::init() {
+    GLExt::load();
+    available = GLExt::hasTimerQueries();
+    if (available) GLExt::genQueries(ringSize, queries);
+    return available;
+}
+
+void GpuTimer::shutdown() {
+    if (available) {
+        GLExt::deleteQueries(ringSize, queries);
+        available = false;
+    }
+}
+
+void GpuTimer::begin() {
+    if (!available) return;
+
+    // Ring is full of unread results, skip this frame rather than stall
+    if (inFlight[writeIndex]) return;
+
+    rlDrawRenderBatchActive();
+    GLExt::beginQuery(GLExt::TIME_ELAPSED, queries[writeIndex]);
+    active = true;
+}
+
+void GpuTimer::end() {
+    if (!active) return;
+
+    rlDrawRenderBatchActive();
+    GLExt::endQuery(GLExt::TIME_ELAPSED);
+
+    inFlight[writeIndex] = true;
+    writeIndex = (writeIndex + 1) % ringSize;
+    active = false;
+}
+
+void GpuTimer::poll() {
+    while (available && inFlight[readIndex]) {
+        int ready = 0;
+        GLExt::getQueryObjectiv(queries[readIndex], GLExt::QUERY_RESULT_AVAILABLE, &ready);
+        if (!ready) break;
+
+        uint64_t ns = 0;
+        GLExt::getQueryObjectui64v(queries[readIndex], GLExt::QUERY_RESULT, &ns);
+        lastMs = (float)((double)ns / 1000000.0);
+
+        inFlight[readIndex] = false;
+        readIndex = (readIndex + 1) % ringSize;
+    }
+}
@@ -0,0 +1,144 @@
+#include "InputRecording.hpp"
+#include "raylib.h"
+#include <cstring>
+
+namespace {
+    const char kMagic[4] = { 'D', 'J', 'O', 'I' };
+    const uint16_t kVersion = 1;
+    const size_t kHeaderSize = 20;
+    const size_t kFrameSize = 20;
+    const size_t kFrameCountOffset = 16;
+    const uint16_t kPlayingBit = 0x8000;
+
+    // Fields go through memcpy one at a time, so the layout doesn't depend on padding
+    template <typename T>
+    uint8_t* put(uint8_t* p, T value) {
+        memcpy(p, &value, sizeof(T));
+        return p + sizeof(T);
+    }
+
+    template <typename T>
+    const uint8_t* get(const uint8_t* p, T& value) {
+        memcpy(&value, p, sizeof(T));
+        return p + sizeof(T);
+    }
+}
+
+bool InputRecorder::start(const char* path, const GameConfig& config) {
+    stop();
+
+    file = fopen(path, "wb");
+    if (!file) {
+        TraceLog(LOG_WARNING, "INPUT: Can't open '%s' for recording", path);
+        return false;
+    }
+
+    uint8_t header[kHeaderSize];
+    uint8_t* p = header;
+    memcpy(p, kMagic, sizeof(kMagic));
+    p += sizeof(kMagic);
+    p = put(p, kVersion);
+    p = put(p, (uint8_t)config.terrain);
+    p = put(p, (uint8_t)0);
+    p = put(p, config.seed);
+    p = put(p, config.mapSize);
+    put(p, (uint32_t)0);            // Frame count, filled in by stop()
+    fwrite(header, 1, sizeof(header), file);
+
+    frameCount = 0;
+    TraceLog(LOG_INFO, "INPUT: Recording to %s", path);
+    return true;
+}
+
+void InputRecorder::record(const FrameInput& input) {
+    if (!file) return;
+
+    uint8_t frame[kFrameSize];
+    uint8_t* p = frame;
+    p = put(p, input.deltaTime);
+    p = put(p, input.mouseDelta.x);
+    p = put(p, input.mouseDelta.y);
+    p = put(p, input.sensitivity);
+    p = put(p, (uint16_t)(input.keysDown | (input.playing ? kPlayingBit : 0)));
+    put(p, input.keysPressed);
+
+    // stdio buffers it, the disk sees a write every few hundred frames
+    fwrite(frame, 1, sizeof(frame), file);
+    frameCount++;
+}
+
+void InputRecorder::stop() {
+    if (!file) return;
+
+    uint8_t count[sizeof(uint32_t)];
+    put(count, frameCount);
+    fseek(file, (long)kFrameCountOffset, SEEK_SET);
+    fwrite(count, 1, sizeof(count), file);
+    fclose(file);
+    file = nullptr;
+
+    TraceLog(LOG_INFO, "INPUT: Recorded %u frames", frameCount);
+}
+
+bool InputReplay::load(const char* path, GameConfig& config) {
+    frames.clear();
+    position = 0;
+
+    int size = 0;
+    unsigned char* data = LoadFileData(path, &size);
+    if (!data) return false;
+
+    // 1. Header: ours, a version we read, and a frame count the file can hold
+    uint16_t version = 0;
+    uint8_t terrain = 0, unused = 0;
+    uint32_t seed = 0, count = 0;
+    float mapSize = 0.0f;
+
+    bool valid = (size_t)size >= kHeaderSize && memcmp(data, kMagic, sizeof(kMagic)) == 0;
+    if (valid) {
+        const uint8_t* p = data + sizeof(kMagic);
+        p = get(p, version);
+        p = get(p, terrain);
+        p = get(p, unused);
+        p = get(p, seed);
+        p = get(p, mapSize);
+        get(p, count);
+        valid = version == kVersion && terrain <= (uint8_t)GameConfig::Terrain::Procedural
+             && count > 0 && (size_t)size >= kHeaderSize + (size_t)count * kFrameSize;
+    }
+    if (!valid) {
+        TraceLog(LOG_WARNING, "INPUT: '%s' isn't a complete input recording", path);
+        UnloadFileData(data);
+        return false;
+    }
+
+    // 2. Frames, decoded once so playback is a copy
+    frames.resize(count);
+    const uint8_t* p = data + kHeaderSize;
+    for (FrameInput& input : frames) {
+        uint16_t keysDown;
+        p = get(p, input.deltaTime);
+        p = get(p, input.mouseDelta.x);
+        p = get(p, input.mouseDelta.y);
+        p = get(p, input.sensitivity);
+        p = get(p, keysDown);
+        p = get(p, input.keysPressed);
+        input.keysDown = keysDown & ~kPlayingBit;
+        input.playing = (keysDown & kPlayingBit) != 0;
+    }
+    UnloadFileData(data);
+
+    // 3. Same map as the session, or nothing else will line up
+    config.terrain = (GameConfig::Terrain)terrain;
+    config.seed = seed;
+    config.mapSize = mapSize;
+
+    TraceLog(LOG_INFO, "INPUT: Replaying %u frames from %s", count, path);
+    return true;
+}
+
+bool InputReplay::next(FrameInput& out) {
+    if (position >= frames.size()) return false;
+    out = frames[position++];
+    return true;
+}
@@ -0,0 +1,117 @@
+#include "JobSystem.hpp"
+#include "Memory.hpp"
+#include "Profiler.hpp"
+
+JobSystem::~JobSystem() {
+    shutdown();
+}
+
+void JobSystem::init(int workerCount) {
+    if (!workers.empty()) return;
+
+    if (workerCount <= 0) {
+        int hardware = (int)std::thread::hardware_concurrency();
+        workerCount = (hardware > 3) ? hardware - 2 : 1;
+    }
+
+    // Room for a few big parallelFor fan-outs before the ring has to grow
+    jobs.resize(256);
+    head = 0;
+    queued = 0;
+
+    quit = false;
+    for (int i = 0; i < workerCount; i++) {
+        workers.emplace_back(&JobSystem::workerLoop, this);
+    }
+}
+
+void JobSystem::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+    wake.notify_all();
+
+    for (std::thread& t : workers) t.join();
+    workers.clear();
+
+    // Anything still queued runs here so no counter is left hanging
+    while (runOne()) {}
+}
+
+void JobSystem::push(const Job& job) {
+    job.counter->pending.fetch_add(1, std::memory_order_relaxed);
+
+    // No workers (not initialised or already shut down): run it inline
+    if (workers.empty()) {
+        execute(job);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        // Full: unroll into a buffer twice the size, oldest job first
+        if (queued == jobs.size()) {
+            std::vector<Job> grown(jobs.empty() ? 64 : jobs.size() * 2);
+            for (size_t i = 0; i < queued; i++) grown[i] = jobs[(head + i) % jobs.size()];
+            jobs.swap(grown);
+            head = 0;
+        }
+
+        jobs[(head + queued) % jobs.size()] = job;
+        queued++;
+    }
+    wake.notify_one();
+}
+
+// Caller holds the mutex
+bool JobSystem::pop(Job& job) {
+    if (queued == 0) return false;
+    job = jobs[head];
+    head = (head + 1) % jobs.size();
+    queued--;
+    return true;
+}
+
+void JobSystem::execute(const Job& job) {
+    {
+        PROFILE_SCOPE("jobs");
+        memory::JobScope charged;
+        job.invoke(job.storage);
+    }
+    job.counter->pending.fetch_sub(1, std::memory_order_release);
+}
+
+bool JobSystem::runOne() {
+    Job job;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!pop(job)) return false;
+    }
+
+    execute(job);
+    return true;
+}
+
+void JobSystem::wait(Counter& counter) {
+    while (!isDone(counter)) {
+        // Help out, and only yield once the queue is empty (the rest is in flight)
+        if (!runOne()) std::this_thread::yield();
+    }
+}
+
+void JobSystem::workerLoop() {
+    trace::setThreadName("worker");
+
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return quit || queued > 0; });
+            if (!pop(job)) return;
+        }
+
+        execute(job);
+    }
+}
@@ -0,0 +1,154 @@
+#include "Lz4.hpp"
+#include <cstring>
+#include <vector>
+
+namespace lz4 {
+    namespace {
+        const int kHashBits = 16;
+        const size_t kMinMatch = 4;
+        const size_t kLastLiterals = 5;     // A block always ends in at least this many literals
+        const size_t kMatchLimit = 12;      // and its last match starts at least this far from the end
+        const size_t kMaxOffset = 65535;
+
+        inline uint32_t read32(const uint8_t* p) {
+            uint32_t v;
+            memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        inline uint32_t hash(uint32_t sequence) {
+            return (sequence * 2654435761u) >> (32 - kHashBits);
+        }
+
+        // 15 in the token, then 255s until the rest fits in one byte
+        inline uint8_t* writeLength(uint8_t* op, size_t length) {
+            while (length >= 255) {
+                *op++ = 255;
+                length -= 255;
+            }
+            *op++ = (uint8_t)length;
+            return op;
+        }
+
+        inline uint8_t* writeSequence(uint8_t* op, const uint8_t* literals, size_t literalLength, size_t offset, size_t matchLength) {
+            uint8_t* token = op++;
+            size_t matchCode = matchLength - kMinMatch;
+            *token = (uint8_t)(((literalLength < 15 ? literalLength : 15) << 4) | (matchCode < 15 ? matchCode : 15));
+
+            if (literalLength >= 15) op = writeLength(op, literalLength - 15);
+            memcpy(op, literals, literalLength);
+            op += literalLength;
+
+            *op++ = (uint8_t)(offset & 0xFF);
+            *op++ = (uint8_t)(offset >> 8);
+            if (matchCode >= 15) op = writeLength(op, matchCode - 15);
+            return op;
+        }
+
+        // Adds up a 15 + 255 + ... length. False if it runs off the end.
+        inline bool readLength(const uint8_t*& ip, const uint8_t* end, size_t& length) {
+            uint8_t b;
+            do {
+                if (ip >= end) return false;
+                b = *ip++;
+                length += b;
+            } while (b == 255);
+            return true;
+        }
+    }
+
+    size_t compress(const uint8_t* src, size_t size, uint8_t* dst) {
+        const uint8_t* ip = src;
+        const uint8_t* anchor = src;
+        const uint8_t* end = src + size;
+        uint8_t* op = dst;
+
+        // Anything shorter is all literals
+        if (size > kMatchLimit) {
+            std::vector<int32_t> table((size_t)1 << kHashBits, -1);
+            const uint8_t* lastMatchStart = end - kMatchLimit;
+            const uint8_t* matchEndLimit = end - kLastLiterals;
+
+            while (ip < lastMatchStart) {
+                uint32_t sequence = read32(ip);
+                uint32_t h = hash(sequence);
+                int32_t candidate = table[h];
+                table[h] = (int32_t)(ip - src);
+
+                if (candidate < 0 || (size_t)(ip - src) - (size_t)candidate > kMaxOffset || read32(src + candidate) != sequence) {
+                    ip++;
+                    continue;
+                }
+                const uint8_t* match = src + candidate;
+
+                // Grow the match backwards into the pending literals, then forwards
+                while (ip > anchor && match > src && ip[-1] == match[-1]) {
+                    ip--;
+                    match--;
+                }
+                const uint8_t* matchEnd = ip + kMinMatch;
+                const uint8_t* ref = match + kMinMatch;
+                while (matchEnd < matchEndLimit && *matchEnd == *ref) {
+                    matchEnd++;
+                    ref++;
+                }
+
+                op = writeSequence(op, anchor, (size_t)(ip - anchor), (size_t)(ip - match), (size_t)(matchEnd - ip));
+                ip = matchEnd;
+                anchor = ip;
+            }
+        }
+
+        // Last sequence: literals only, no offset
+        size_t literalLength = (size_t)(end - anchor);
+        *op++ = (uint8_t)((literalLength < 15 ? literalLength : 15) << 4);
+        if (literalLength >= 15) op = writeLength(op, literalLength - 15);
+        memcpy(op, anchor, literalLength);
+        op += literalLength;
+
+        return (size_t)(op - dst);
+    }
+
+    bool decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize) {
+        const uint8_t* ip = src;
+        const uint8_t* iend = src + srcSize;
+        uint8_t* op = dst;
+        uint8_t* oend = dst + dstSize;
+
+        while (ip < iend) {
+            uint8_t token = *ip++;
+
+            // 1. Literals
+            size_t literalLength = token >> 4;
+            if (literalLength == 15 && !readLength(ip, iend, literalLength)) return false;
+            if (literalLength > (size_t)(iend - ip) || literalLength > (size_t)(oend - op)) return false;
+            memcpy(op, ip, literalLength);
+            ip += literalLength;
+            op += literalLength;
+
+            // The last sequence stops after its literals
+            if (ip == iend) break;
+
+            // 2. Match, byte by byte where it overlaps what it is writing
+            if (iend - ip < 2) return false;
+            size_t offset = ip[0] | ((size_t)ip[1] << 8);
+            ip += 2;
+            if (offset == 0 || offset > (size_t)(op - dst)) return false;
+
+            size_t matchLength = token & 15;
+            if (matchLength == 15 && !readLength(ip, iend, matchLength)) return false;
+            matchLength += kMinMatch;
+            if (matchLength > (size_t)(oend - op)) return false;
+
+            const uint8_t* match = op - offset;
+            if (offset >= matchLength) {
+                memcpy(op, match, matchLength);
+            } else {
+                for (size_t i = 0; i < matchLength; i++) op[i] = match[i];
+            }
+            op += matchLength;
+        }
+
+        return op == oend;
+    }
+}
@@ -0,0 +1,88 @@
+#include "Memory.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#if defined(__linux__)
+    #include <unistd.h>
+#endif
+
+#if defined(MEMORY_TRACKING)
+
+namespace {
+    thread_local uint64_t allocations = 0;
+    thread_local int untrackedDepth = 0;
+    thread_local int jobDepth = 0;
+
+    // Shared, since the frame can't know which threads ran its jobs. Only
+    // touched when a job allocates, which a steady frame shouldn't.
+    std::atomic<uint64_t> jobAllocations{0};
+}
+
+// The array, nothrow and sized forms all end up in these two
+void* operator new(std::size_t size) {
+    if (untrackedDepth == 0) {
+        if (jobDepth > 0) jobAllocations.fetch_add(1, std::memory_order_relaxed);
+        else allocations++;
+    }
+    if (size == 0) size = 1;
+
+    while (true) {
+        if (void* p = std::malloc(size)) return p;
+
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace memory {
+    uint64_t getAllocationCount() { return allocations; }
+    uint64_t getJobAllocationCount() { return jobAllocations.load(std::memory_order_relaxed); }
+
+    UntrackedScope::UntrackedScope() { untrackedDepth++; }
+    UntrackedScope::~UntrackedScope() { untrackedDepth--; }
+
+    JobScope::JobScope() { jobDepth++; }
+    JobScope::~JobScope() { jobDepth--; }
+}
+
+#else
+
+namespace memory {
+    uint64_t getAllocationCount() { return 0; }
+    uint64_t getJobAllocationCount() { return 0; }
+
+    UntrackedScope::UntrackedScope() {}
+    UntrackedScope::~UntrackedScope() {}
+
+    JobScope::JobScope() {}
+    JobScope::~JobScope() {}
+}
+
+#endif
+
+namespace memory {
+    uint64_t getResidentBytes() {
+#if defined(__linux__)
+        // Second field of statm, in pages
+        FILE* file = fopen("/proc/self/statm", "r");
+        if (!file) return 0;
+        unsigned long long size = 0, resident = 0;
+        int fields = fscanf(file, "%llu %llu", &size, &resident);
+        fclose(file);
+        return (fields == 2) ? resident * (uint64_t)sysconf(_SC_PAGESIZE) : 0;
+#else
+        return 0;
+#endif
+    }
+}
@@ -0,0 +1,107 @@
+#include "MeshMemory.hpp"
+#include <cstring>
+
+namespace {
+    const float kMegabyte = 1024.0f * 1024.0f;
+
+    template <typename T>
+    void freeArray(T*& array) {
+        MemFree(array);
+        array = nullptr;
+    }
+}
+
+void MeshMemory::track(const char* group, const Model& model) {
+    for (const Entry& e : entries) {
+        if (e.meshes == model.meshes) return;
+    }
+    entries.push_back({ group, model.meshes, model.meshCount });
+}
+
+void MeshMemory::track(const char* group, Mesh& mesh) {
+    for (const Entry& e : entries) {
+        if (e.meshes == &mesh) return;
+    }
+    entries.push_back({ group, &mesh, 1 });
+}
+
+size_t MeshMemory::getCpuBytes(const Mesh& mesh) {
+    size_t vertices = (size_t)mesh.vertexCount;
+    size_t bytes = 0;
+
+    if (mesh.vertices) bytes += vertices * 3 * sizeof(float);
+    if (mesh.texcoords) bytes += vertices * 2 * sizeof(float);
+    if (mesh.texcoords2) bytes += vertices * 2 * sizeof(float);
+    if (mesh.normals) bytes += vertices * 3 * sizeof(float);
+    if (mesh.tangents) bytes += vertices * 4 * sizeof(float);
+    if (mesh.colors) bytes += vertices * 4;
+    if (mesh.indices) bytes += (size_t)mesh.triangleCount * 3 * sizeof(unsigned short);
+    if (mesh.animVertices) bytes += vertices * 3 * sizeof(float);
+    if (mesh.animNormals) bytes += vertices * 3 * sizeof(float);
+    if (mesh.boneIds) bytes += vertices * 4;
+    if (mesh.boneWeights) bytes += vertices * 4 * sizeof(float);
+    return bytes;
+}
+
+size_t MeshMemory::getCpuBytes(const char* group) const {
+    size_t bytes = 0;
+    for (const Entry& e : entries) {
+        if (group && strcmp(e.group, group) != 0) continue;
+        for (int i = 0; i < e.count; i++) bytes += getCpuBytes(e.meshes[i]);
+    }
+    return bytes;
+}
+
+void MeshMemory::release() {
+    std::vector<const char*> names = groups();
+    std::vector<size_t> before;
+    for (const char* name : names) before.push_back(getCpuBytes(name));
+    size_t totalBefore = getCpuBytes();
+
+    for (const Entry& e : entries) {
+        for (int i = 0; i < e.count; i++) {
+            Mesh& mesh = e.meshes[i];
+
+            // Never uploaded: the CPU copy is all there is
+            if (mesh.vaoId == 0 && (mesh.vboId == nullptr || mesh.vboId[0] == 0)) continue;
+
+            freeArray(mesh.vertices);
+            freeArray(mesh.texcoords);
+            freeArray(mesh.texcoords2);
+            freeArray(mesh.normals);
+            freeArray(mesh.tangents);
+            freeArray(mesh.colors);
+            freeArray(mesh.animVertices);
+            freeArray(mesh.animNormals);
+            freeArray(mesh.boneIds);
+            freeArray(mesh.boneWeights);
+        }
+    }
+
+    for (size_t g = 0; g < names.size(); g++) {
+        TraceLog(LOG_INFO, "MEMORY: %-12s %8.2f MB -> %6.2f MB of CPU mesh data", names[g],
+                 before[g] / kMegabyte, getCpuBytes(names[g]) / kMegabyte);
+    }
+    TraceLog(LOG_INFO, "MEMORY: %-12s %8.2f MB -> %6.2f MB of CPU mesh data", "total",
+             totalBefore / kMegabyte, getCpuBytes() / kMegabyte);
+}
+
+void MeshMemory::report() const {
+    for (const char* name : groups()) {
+        TraceLog(LOG_INFO, "MEMORY: %-12s %8.2f MB of CPU mesh data", name, getCpuBytes(name) / kMegabyte);
+    }
+    TraceLog(LOG_INFO, "MEMORY: %-12s %8.2f MB of CPU mesh data", "total", getCpuBytes() / kMegabyte);
+}
+
+// Group names in the order they were first tracked
+std::vector<const char*> MeshMemory::groups() const {
+    std::vector<const char*> names;
+    for (const Entry& e : entries) {
+        bool seen = false;
+        for (const char* name : names) {
+            if (strcmp(name, e.group) == 0) seen = true;
+        }
+        if (!seen) names.push_back(e.group);
+    }
+    return names;
+}
@@ -0,0 +1,624 @@
+#include "NavMesh.hpp"
+#include "raymath.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+// Bump whenever the build changes, so old cache entries get rebuilt
+static const uint32_t kNavMeshVersion = 1;
+
+static const float kNoHeight = -FLT_MAX;
+
+namespace {
+    // Per-thread A* state, sized to the polygon count and reused between queries.
+    // Stamps avoid clearing the arrays for every search.
+    struct PathScratch {
+        std::vector<float> g;
+        std::vector<Vector2> entry;
+        std::vector<int32_t> parent;
+        std::vector<int32_t> parentLink;
+        std::vector<uint32_t> openStamp;
+        std::vector<uint32_t> closedStamp;
+        std::vector<std::pair<float, int32_t>> heap;
+        uint32_t generation = 0;
+
+        // Portal chain and funnel sides, kept so a query reuses their room
+        std::vector<int32_t> chain;
+        std::vector<Vector2> lefts, rights;
+
+        void prepare(size_t polyCount) {
+            if (g.size() != polyCount) {
+                g.assign(polyCount, 0.0f);
+                entry.assign(polyCount, { 0, 0 });
+                parent.assign(polyCount, -1);
+                parentLink.assign(polyCount, -1);
+                openStamp.assign(polyCount, 0);
+                closedStamp.assign(polyCount, 0);
+                generation = 0;
+            }
+            heap.clear();
+            chain.clear();
+            lefts.clear();
+            rights.clear();
+            generation++;
+        }
+    };
+
+    // Twice the signed area of abc, the funnel's side test
+    inline float triarea2(Vector2 a, Vector2 b, Vector2 c) {
+        float ax = b.x - a.x;
+        float ay = b.y - a.y;
+        float bx = c.x - a.x;
+        float by = c.y - a.y;
+        return bx * ay - ax * by;
+    }
+
+    inline bool vequal(Vector2 a, Vector2 b) {
+        return Vector2DistanceSqr(a, b) < 0.001f * 0.001f;
+    }
+
+    inline Vector2 closestOnSegment(Vector2 p, Vector2 a, Vector2 b) {
+        Vector2 ab = Vector2Subtract(b, a);
+        float lengthSqr = Vector2LengthSqr(ab);
+        if (lengthSqr < 1e-12f) return a;
+        float t = Clamp(Vector2DotProduct(Vector2Subtract(p, a), ab) / lengthSqr, 0.0f, 1.0f);
+        return Vector2Add(a, Vector2Scale(ab, t));
+    }
+
+    struct HeapOrder {
+        bool operator()(const std::pair<float, int32_t>& a, const std::pair<float, int32_t>& b) const {
+            return a.first > b.first;
+        }
+    };
+}
+
+uint64_t NavMesh::computeKey(const CollisionWorld& world, const Settings& settings) {
+    uint64_t key = AssetCache::hashValue(kNavMeshVersion, 14695981039346656037ull);
+    key = AssetCache::hashValue(settings.cellSize, key);
+    key = AssetCache::hashValue(settings.slopeLimit, key);
+    key = AssetCache::hashValue(settings.agentRadius, key);
+    key = AssetCache::hashValue(settings.maxClimb, key);
+    key = AssetCache::hashValue(settings.maxPolySize, key);
+
+    // 1. Terrain triangles, in grid order
+    const TerrainCollider& terrain = world.getTerrain();
+    BoundingBox b = terrain.getBounds();
+    terrain.forEachTriangle(b.min.x, b.min.z, b.max.x, b.max.z, [&key](Vector3 v0, Vector3 v1, Vector3 v2) {
+        Vector3 tri[3] = { v0, v1, v2 };
+        key = AssetCache::hash(tri, sizeof(tri), key);
+    });
+
+    // 2. Props (tree placement isn't the same on every platform yet)
+    for (const StaticCollider& c : world.getColliders()) {
+        key = AssetCache::hashValue((int)c.shape, key);
+        key = AssetCache::hashValue(c.center, key);
+        if (c.shape == StaticCollider::Box) {
+            key = AssetCache::hash(c.axes, sizeof(c.axes), key);
+            key = AssetCache::hashValue(c.halfExtents, key);
+        } else {
+            key = AssetCache::hashValue(c.radius, key);
+            key = AssetCache::hashValue(c.height, key);
+        }
+    }
+
+    return key;
+}
+
+bool NavMesh::buildCached(const CollisionWorld& world, JobSystem& jobs, const AssetCache& cache) {
+    uint64_t key = computeKey(world, settings);
+
+    std::vector<uint8_t> bytes;
+    if (cache.load("navmesh", key, bytes)) {
+        CacheReader in(bytes);
+        if (deserialize(in)) {
+            TraceLog(LOG_INFO, "NAVMESH: Loaded %d polygons from cache", getPolyCount());
+            return true;
+        }
+    }
+
+    build(world, jobs);
+
+    CacheWriter out;
+    serialize(out);
+    if (!cache.store("navmesh", key, out.bytes)) {
+        TraceLog(LOG_WARNING, "NAVMESH: Couldn't write the cache entry");
+    }
+    return false;
+}
+
+void NavMesh::serialize(CacheWriter& out) const {
+    out.put(settings);
+    out.put(origin);
+    out.put(cellsX);
+    out.put(cellsZ);
+    out.putArray(heights);
+    out.putArray(cellPoly);
+    out.putArray(polys);
+    out.putArray(linkStart);
+    out.putArray(links);
+}
+
+bool NavMesh::deserialize(CacheReader& in) {
+    // The key already covers the settings, so the stored copy must match ours
+    Settings stored;
+    bool ok = in.get(stored) && in.get(origin) && in.get(cellsX) && in.get(cellsZ) &&
+              in.getArray(heights) && in.getArray(cellPoly) && in.getArray(polys) &&
+              in.getArray(linkStart) && in.getArray(links) && in.atEnd();
+
+    // Sanity check the sizes before trusting any index in there
+    ok = ok && memcmp(&stored, &settings, sizeof(Settings)) == 0 && heights.size() == (size_t)cellsX * cellsZ && cellPoly.size() == heights.size() &&
+         linkStart.size() == polys.size() + 1 && linkStart.back() == links.size();
+
+    if (!ok) {
+        heights.clear();
+        cellPoly.clear();
+        polys.clear();
+        linkStart.clear();
+        links.clear();
+    }
+    return ok;
+}
+
+void NavMesh::build(const CollisionWorld& world, JobSystem& jobs) {
+    polys.clear();
+    links.clear();
+    linkStart.clear();
+
+    const TerrainCollider& terrain = world.getTerrain();
+    if (!terrain.isBuilt()) return;
+
+    const float cs = settings.cellSize;
+    BoundingBox bounds = terrain.getBounds();
+    origin = { bounds.min.x, bounds.min.z };
+    cellsX = (int)ceilf((bounds.max.x - bounds.min.x) / cs);
+    cellsZ = (int)ceilf((bounds.max.z - bounds.min.z) / cs);
+    if (cellsX <= 0 || cellsZ <= 0) return;
+
+    const int cellCount = cellsX * cellsZ;
+    heights.assign(cellCount, kNoHeight);
+    std::vector<float> normalY(cellCount, 0.0f);
+
+    // 1. Rasterise the terrain: each job owns a band of rows and writes the
+    // highest surface under every cell centre in it
+    jobs.parallelFor(cellsZ, 16, [&](int rowBegin, int rowEnd) {
+        float minZ = origin.y + rowBegin * cs;
+        float maxZ = origin.y + rowEnd * cs;
+
+        terrain.forEachTriangle(bounds.min.x, minZ, bounds.max.x, maxZ, [&](Vector3 a, Vector3 b, Vector3 c) {
+            float e0x = b.x - a.x, e0z = b.z - a.z;
+            float e1x = c.x - a.x, e1z = c.z - a.z;
+            float area = e0x * e1z - e1x * e0z;
+            if (fabsf(area) < 1e-12f) return; // Vertical, covers no cell centre
+
+            Vector3 n = Vector3Normalize(Vector3CrossProduct(Vector3Subtract(b, a), Vector3Subtract(c, a)));
+            float ny = fabsf(n.y);
+
+            float triMinX = fminf(a.x, fminf(b.x, c.x)), triMaxX = fmaxf(a.x, fmaxf(b.x, c.x));
+            float triMinZ = fminf(a.z, fminf(b.z, c.z)), triMaxZ = fmaxf(a.z, fmaxf(b.z, c.z));
+
+            int x0 = std::max(0, (int)ceilf((triMinX - origin.x) / cs - 0.5f));
+            int x1 = std::min(cellsX - 1, (int)floorf((triMaxX - origin.x) / cs - 0.5f));
+            int z0 = std::max(rowBegin, (int)ceilf((triMinZ - origin.y) / cs - 0.5f));
+            int z1 = std::min(rowEnd - 1, (int)floorf((triMaxZ - origin.y) / cs - 0.5f));
+
+            for (int cz = z0; cz <= z1; cz++) {
+                float pz = origin.y + (cz + 0.5f) * cs;
+                for (int cx = x0; cx <= x1; cx++) {
+                    float px = origin.x + (cx + 0.5f) * cs;
+
+                    // Barycentric coordinates in XZ
+                    float wx = px - a.x, wz = pz - a.z;
+                    float s = (wx * e1z - e1x * wz) / area;
+                    float t = (e0x * wz - wx * e0z) / area;
+                    if (s < -1e-5f || t < -1e-5f || s + t > 1.0f + 1e-5f) continue;
+
+                    float y = a.y + s * (b.y - a.y) + t * (c.y - a.y);
+                    int cell = cz * cellsX + cx;
+                    if (y > heights[cell]) {
+                        heights[cell] = y;
+                        normalY[cell] = ny;
+                    }
+                }
+            }
+        });
+    });
+
+    // 2. Slope test, then erode by the agent radius so nobody hugs a cliff edge
+    std::vector<uint8_t> slopeOk(cellCount);
+    for (int i = 0; i < cellCount; i++) {
+        slopeOk[i] = (heights[i] != kNoHeight && normalY[i] >= settings.slopeLimit) ? 1 : 0;
+    }
+
+    std::vector<uint8_t> walkable(cellCount, 0);
+    int erode = (int)ceilf(settings.agentRadius / cs);
+    jobs.parallelFor(cellsZ, 32, [&](int rowBegin, int rowEnd) {
+        for (int cz = rowBegin; cz < rowEnd; cz++) {
+            for (int cx = 0; cx < cellsX; cx++) {
+                bool ok = slopeOk[cz * cellsX + cx] != 0;
+                for (int dz = -erode; ok && dz <= erode; dz++) {
+                    for (int dx = -erode; ok && dx <= erode; dx++) {
+                        int nx = cx + dx, nz = cz + dz;
+                        ok = nx >= 0 && nz >= 0 && nx < cellsX && nz < cellsZ && slopeOk[nz * cellsX + nx];
+                    }
+                }
+                walkable[cz * cellsX + cx] = ok ? 1 : 0;
+            }
+        }
+    });
+
+    // 3. Carve out tree trunks and fences, grown by the agent radius plus half
+    // a cell diagonal so thin props can't slip between cell centres
+    float grow = settings.agentRadius + cs * 0.7072f;
+    for (const StaticCollider& c : world.getColliders()) {
+        int x0 = std::max(0, (int)floorf((c.bounds.min.x - grow - origin.x) / cs));
+        int x1 = std::min(cellsX - 1, (int)floorf((c.bounds.max.x + grow - origin.x) / cs));
+        int z0 = std::max(0, (int)floorf((c.bounds.min.z - grow - origin.y) / cs));
+        int z1 = std::min(cellsZ - 1, (int)floorf((c.bounds.max.z + grow - origin.y) / cs));
+
+        for (int cz = z0; cz <= z1; cz++) {
+            for (int cx = x0; cx <= x1; cx++) {
+                int cell = cz * cellsX + cx;
+                if (!walkable[cell]) continue;
+
+                float px = origin.x + (cx + 0.5f) * cs;
+                float pz = origin.y + (cz + 0.5f) * cs;
+                bool blocked = false;
+
+                if (c.shape == StaticCollider::Cylinder) {
+                    float dx = px - c.center.x, dz = pz - c.center.z;
+                    blocked = dx * dx + dz * dz <= (c.radius + grow) * (c.radius + grow);
+                } else {
+                    // Test a point about knee height above the cell against the grown box
+                    Vector3 d = Vector3Subtract({ px, heights[cell] + 0.5f, pz }, c.center);
+                    blocked = fabsf(Vector3DotProduct(d, c.axes[0])) <= c.halfExtents.x + grow &&
+                              fabsf(Vector3DotProduct(d, c.axes[1])) <= c.halfExtents.y + grow &&
+                              fabsf(Vector3DotProduct(d, c.axes[2])) <= c.halfExtents.z + grow;
+                }
+
+                if (blocked) walkable[cell] = 0;
+            }
+        }
+    }
+
+    // 4. Merge walkable cells into rectangles, growing along X then Z
+    cellPoly.assign(cellCount, -1);
+    const int maxSize = std::max(1, settings.maxPolySize);
+    for (int cz = 0; cz < cellsZ; cz++) {
+        for (int cx = 0; cx < cellsX; cx++) {
+            int start = cz * cellsX + cx;
+            if (!walkable[start] || cellPoly[start] >= 0) continue;
+
+            int w = 1;
+            while (cx + w < cellsX && w < maxSize) {
+                int cell = start + w;
+                if (!walkable[cell] || cellPoly[cell] >= 0 || !connected(cell - 1, cell)) break;
+                w++;
+            }
+
+            int h = 1;
+            while (cz + h < cellsZ && h < maxSize) {
+                int row = (cz + h) * cellsX + cx;
+                bool ok = true;
+                for (int i = 0; i < w && ok; i++) {
+                    int cell = row + i;
+                    ok = walkable[cell] && cellPoly[cell] < 0 && connected(cell - cellsX, cell) &&
+                         (i == 0 || connected(cell - 1, cell));
+                }
+                if (!ok) break;
+                h++;
+            }
+
+            int id = (int)polys.size();
+            polys.push_back({ cx, cz, cx + w, cz + h });
+            for (int z = cz; z < cz + h; z++) {
+                for (int x = cx; x < cx + w; x++) cellPoly[z * cellsX + x] = id;
+            }
+        }
+    }
+
+    // 5. Portals: walk each side of every polygon and group the neighbouring
+    // cells into runs that lead into the same polygon
+    linkStart.resize(polys.size() + 1);
+    for (int p = 0; p < (int)polys.size(); p++) {
+        const Poly& poly = polys[p];
+        linkStart[p] = (uint32_t)links.size();
+
+        for (int side = 0; side < 4; side++) {
+            bool alongZ = side < 2;     // +X and -X sides run along Z
+            int length = alongZ ? (poly.z1 - poly.z0) : (poly.x1 - poly.x0);
+            int runPoly = -1;
+            int runStart = 0;
+
+            for (int k = 0; k <= length; k++) {
+                int next = -1;
+                if (k < length) {
+                    int ix, iz, ox, oz;
+                    switch (side) {
+                        case 0:  ix = poly.x1 - 1; iz = poly.z0 + k; ox = poly.x1;     oz = iz;          break;
+                        case 1:  ix = poly.x0;     iz = poly.z0 + k; ox = poly.x0 - 1; oz = iz;          break;
+                        case 2:  ix = poly.x0 + k; iz = poly.z1 - 1; ox = ix;          oz = poly.z1;     break;
+                        default: ix = poly.x0 + k; iz = poly.z0;     ox = ix;          oz = poly.z0 - 1; break;
+                    }
+                    if (ox >= 0 && oz >= 0 && ox < cellsX && oz < cellsZ) {
+                        int inside = iz * cellsX + ix;
+                        int outside = oz * cellsX + ox;
+                        if (cellPoly[outside] >= 0 && connected(inside, outside)) next = cellPoly[outside];
+                    }
+                }
+
+                if (next == runPoly) continue;
+
+                if (runPoly >= 0) {
+                    Link link;
+                    link.poly = runPoly;
+                    if (alongZ) {
+                        float x = origin.x + (side == 0 ? poly.x1 : poly.x0) * cs;
+                        link.ax = x; link.az = origin.y + (poly.z0 + runStart) * cs;
+                        link.bx = x; link.bz = origin.y + (poly.z0 + k) * cs;
+                    } else {
+                        float z = origin.y + (side == 2 ? poly.z1 : poly.z0) * cs;
+                        link.ax = origin.x + (poly.x0 + runStart) * cs; link.az = z;
+                        link.bx = origin.x + (poly.x0 + k) * cs;        link.bz = z;
+                    }
+                    links.push_back(link);
+                }
+
+                runPoly = next;
+                runStart = k;
+            }
+        }
+    }
+    linkStart[polys.size()] = (uint32_t)links.size();
+
+    TraceLog(LOG_INFO, "NAVMESH: %dx%d cells -> %d polygons, %d portals", cellsX, cellsZ, getPolyCount(), (int)links.size());
+}
+
+bool NavMesh::connected(int a, int b) const {
+    return fabsf(heights[a] - heights[b]) <= settings.maxClimb;
+}
+
+bool NavMesh::cellAt(float x, float z, int& cx, int& cz) const {
+    if (cellsX == 0) return false;
+    cx = (int)floorf((x - origin.x) / settings.cellSize);
+    cz = (int)floorf((z - origin.y) / settings.cellSize);
+    return cx >= 0 && cz >= 0 && cx < cellsX && cz < cellsZ;
+}
+
+bool NavMesh::isWalkable(float x, float z) const {
+    int cx, cz;
+    return cellAt(x, z, cx, cz) && !cellPoly.empty() && cellPoly[cz * cellsX + cx] >= 0;
+}
+
+float NavMesh::getHeightAt(float x, float z) const {
+    int cx, cz;
+    if (!cellAt(x, z, cx, cz) || heights.empty()) return 0.0f;
+    float h = heights[cz * cellsX + cx];
+    return (h == kNoHeight) ? 0.0f : h;
+}
+
+bool NavMesh::findNearestWalkable(Vector3 position, float radius, Vector3& out) const {
+    if (!isBuilt()) return false;
+
+    int cx = (int)floorf((position.x - origin.x) / settings.cellSize);
+    int cz = (int)floorf((position.z - origin.y) / settings.cellSize);
+    int maxRing = (int)ceilf(radius / settings.cellSize);
+
+    // Grow square rings around the cell, the first ring with a hit holds the nearest one
+    for (int ring = 0; ring <= maxRing; ring++) {
+        float bestDist = FLT_MAX;
+        for (int z = cz - ring; z <= cz + ring; z++) {
+            for (int x = cx - ring; x <= cx + ring; x++) {
+                if (std::max(abs(x - cx), abs(z - cz)) != ring) continue;
+                if (x < 0 || z < 0 || x >= cellsX || z >= cellsZ) continue;
+
+                int cell = z * cellsX + x;
+                if (cellPoly[cell] < 0) continue;
+
+                Vector3 center = { origin.x + (x + 0.5f) * settings.cellSize, heights[cell],
+                                   origin.y + (z + 0.5f) * settings.cellSize };
+                float dist = (center.x - position.x) * (center.x - position.x) + (center.z - position.z) * (center.z - position.z);
+                if (dist < bestDist) {
+                    bestDist = dist;
+                    out = center;
+                }
+            }
+        }
+        if (bestDist < FLT_MAX) return true;
+    }
+    return false;
+}
+
+int NavMesh::locate(Vector3 position, Vector3& snapped) const {
+    int cx, cz;
+    if (cellAt(position.x, position.z, cx, cz) && cellPoly[cz * cellsX + cx] >= 0) {
+        snapped = { position.x, heights[cz * cellsX + cx], position.z };
+        return cellPoly[cz * cellsX + cx];
+    }
+
+    // Slightly off the mesh (against a tree, on a steep bit): use the closest cell
+    if (!findNearestWalkable(position, 4.0f * settings.cellSize, snapped)) return -1;
+    cellAt(snapped.x, snapped.z, cx, cz);
+    return cellPoly[cz * cellsX + cx];
+}
+
+bool NavMesh::findPath(Vector3 start, Vector3 end, Path& out) const {
+    out.found = false;
+    out.points.clear();
+    if (!isBuilt()) return false;
+
+    Vector3 from, to;
+    int startPoly = locate(start, from);
+    int endPoly = locate(end, to);
+    if (startPoly < 0 || endPoly < 0) return false;
+
+    if (startPoly == endPoly) {
+        out.points = { from, to };
+        out.found = true;
+        return true;
+    }
+
+    static thread_local PathScratch scratch;
+    scratch.prepare(polys.size());
+    const uint32_t gen = scratch.generation;
+
+    Vector2 goal = { to.x, to.z };
+
+    // 1. A* over polygons. Each polygon is entered at the closest point of the
+    // portal we came through, which keeps costs close to the real walk.
+    scratch.g[startPoly] = 0.0f;
+    scratch.entry[startPoly] = { from.x, from.z };
+    scratch.parent[startPoly] = -1;
+    scratch.parentLink[startPoly] = -1;
+    scratch.openStamp[startPoly] = gen;
+    scratch.heap.push_back({ Vector2Distance(scratch.entry[startPoly], goal), startPoly });
+
+    bool reached = false;
+    while (!scratch.heap.empty()) {
+        std::pop_heap(scratch.heap.begin(), scratch.heap.end(), HeapOrder());
+        int p = scratch.heap.back().second;
+        scratch.heap.pop_back();
+
+        if (scratch.closedStamp[p] == gen) continue;    // Stale duplicate
+        scratch.closedStamp[p] = gen;
+        if (p == endPoly) { reached = true; break; }
+
+        Vector2 here = scratch.entry[p];
+        for (uint32_t l = linkStart[p]; l < linkStart[p + 1]; l++) {
+            const Link& link = links[l];
+            int q = link.poly;
+            if (scratch.closedStamp[q] == gen) continue;
+
+            Vector2 entry = closestOnSegment(here, { link.ax, link.az }, { link.bx, link.bz });
+            float g = scratch.g[p] + Vector2Distance(here, entry);
+
+            if (scratch.openStamp[q] != gen || g < scratch.g[q]) {
+                scratch.openStamp[q] = gen;
+                scratch.g[q] = g;
+                scratch.entry[q] = entry;
+                scratch.parent[q] = p;
+                scratch.parentLink[q] = (int32_t)l;
+                scratch.heap.push_back({ g + Vector2Distance(entry, goal), q });
+                std::push_heap(scratch.heap.begin(), scratch.heap.end(), HeapOrder());
+            }
+        }
+    }
+
+    if (!reached) return false;
+
+    // 2. Walk back to the start collecting portals, oriented left/right
+    // relative to the direction we cross them
+    std::vector<int32_t>& chain = scratch.chain;
+    for (int p = endPoly; scratch.parentLink[p] >= 0; p = scratch.parent[p]) chain.push_back(p);
+    std::reverse(chain.begin(), chain.end());
+
+    std::vector<Vector2>& lefts = scratch.lefts;
+    std::vector<Vector2>& rights = scratch.rights;
+    lefts.reserve(chain.size() + 2);
+    rights.reserve(chain.size() + 2);
+    lefts.push_back({ from.x, from.z });
+    rights.push_back({ from.x, from.z });
+
+    auto centerOf = [this](int p) {
+        const Poly& poly = polys[p];
+        return Vector2{ origin.x + (poly.x0 + poly.x1) * 0.5f * settings.cellSize,
+                        origin.y + (poly.z0 + poly.z1) * 0.5f * settings.cellSize };
+    };
+
+    for (int q : chain) {
+        const Link& link = links[scratch.parentLink[q]];
+        Vector2 d = Vector2Subtract(centerOf(q), centerOf(scratch.parent[q]));
+        Vector2 a = { link.ax, link.az };
+        Vector2 b = { link.bx, link.bz };
+
+        // a is on the left if it's counter-clockwise of b, looking along d
+        Vector2 ab = Vector2Subtract(a, b);
+        bool aIsLeft = (d.x * ab.y - d.y * ab.x) > 0.0f;
+        lefts.push_back(aIsLeft ? a : b);
+        rights.push_back(aIsLeft ? b : a);
+    }
+
+    lefts.push_back(goal);
+    rights.push_back(goal);
+
+    // 3. Straighten
+    stringPull(lefts, rights, out.points);
+    out.points.front().y = from.y;
+    out.points.back().y = to.y;
+    out.found = true;
+    return true;
+}
+
+// Simple stupid funnel algorithm (Mononen): keep the tightest left/right
+// boundaries seen from the apex, and turn a corner into a waypoint once the
+// boundaries cross.
+void NavMesh::stringPull(const std::vector<Vector2>& lefts, const std::vector<Vector2>& rights,
+                         std::vector<Vector3>& points) const {
+    auto emit = [this, &points](Vector2 p) {
+        if (!points.empty() && fabsf(points.back().x - p.x) < 1e-4f && fabsf(points.back().z - p.y) < 1e-4f) return;
+        points.push_back({ p.x, getHeightAt(p.x, p.y), p.y });
+    };
+
+    int count = (int)lefts.size();
+    Vector2 apex = lefts[0];
+    Vector2 portalLeft = lefts[0];
+    Vector2 portalRight = rights[0];
+    int apexIndex = 0, leftIndex = 0, rightIndex = 0;
+
+    emit(apex);
+
+    for (int i = 1; i < count; i++) {
+        Vector2 left = lefts[i];
+        Vector2 right = rights[i];
+
+        // Update the right side
+        if (triarea2(apex, portalRight, right) <= 0.0f) {
+            if (vequal(apex, portalRight) || triarea2(apex, portalLeft, right) > 0.0f) {
+                portalRight = right;
+                rightIndex = i;
+            } else {
+                // Right crossed over left: the left corner is a waypoint
+                emit(portalLeft);
+                apex = portalLeft;
+                apexIndex = leftIndex;
+                portalLeft = portalRight = apex;
+                leftIndex = rightIndex = apexIndex;
+                i = apexIndex;
+                continue;
+            }
+        }
+
+        // Update the left side
+        if (triarea2(apex, portalLeft, left) >= 0.0f) {
+            if (vequal(apex, portalLeft) || triarea2(apex, portalRight, left) < 0.0f) {
+                portalLeft = left;
+                leftIndex = i;
+            } else {
+                emit(portalRight);
+                apex = portalRight;
+                apexIndex = rightIndex;
+                portalLeft = portalRight = apex;
+                leftIndex = rightIndex = apexIndex;
+                i = apexIndex;
+                continue;
+            }
+        }
+    }
+
+    emit(lefts[count - 1]);
+}
+
+void NavMesh::findPaths(JobSystem& jobs, const std::vector<PathRequest>& requests,
+                        std::vector<Path>& results, JobSystem::Counter& done, int batchSize) const {
+    // Never shrinks, so the paths past this batch keep their buffers too
+    if (results.size() < requests.size()) results.resize(requests.size());
+    if (batchSize < 1) batchSize = 1;
+
+    for (size_t begin = 0; begin < requests.size(); begin += batchSize) {
+        size_t end = std::min(requests.size(), begin + (size_t)batchSize);
+        jobs.submit(done, [this, &requests, &results, begin, end] {
+            for (size_t i = begin; i < end; i++) findPath(requests[i].start, requests[i].end, results[i]);
+        });
+    }
+}
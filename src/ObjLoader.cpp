@@ -0,0 +1,584 @@
+#include "ObjLoader.hpp"
+#include "JobSystem.hpp"
+#include "PackArchive.hpp"
+#include "Profiler.hpp"
+#include "raymath.h"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <unordered_map>
+
+namespace ObjLoader {
+    namespace {
+        const size_t kMinChunk = 64 * 1024;     // Smaller than this isn't worth a job
+        const int kMissing = INT_MIN;           // f v//vn has no texcoord
+
+        struct Corner {
+            int v, vt, vn;
+        };
+
+        struct FaceCorner {
+            Corner corner;
+            uint8_t relative;       // Bit per field, see fixIndex
+        };
+
+        struct Switch {
+            int triangle;           // First triangle drawn with it, within the chunk
+            int material;           // -1 until the MTL files are read, and for unknown names
+            std::string name;
+        };
+
+        struct Chunk {
+            const char* begin;
+            const char* end;
+
+            std::vector<float> positions;
+            std::vector<float> texcoords;
+            std::vector<float> normals;
+            std::vector<Corner> corners;        // 3 per triangle
+            std::vector<int> relative;          // corner * 3 + field, for indices counted back from the end
+            std::vector<Switch> switches;
+            std::vector<std::string> libraries;
+
+            // Filled in by the merge
+            int positionBase = 0, texcoordBase = 0, normalBase = 0;
+            int startMaterial = -1;
+            std::vector<int> meshCounts;        // Triangles per mesh
+            std::vector<int> meshStarts;        // Where they go in it
+            int badIndices = 0;
+        };
+
+        inline bool isSpace(char c) { return c == ' ' || c == '\t'; }
+        inline bool isDigit(char c) { return (unsigned)(c - '0') < 10u; }
+
+        inline const char* skipSpaces(const char* p, const char* end) {
+            while (p < end && isSpace(*p)) p++;
+            return p;
+        }
+
+        inline const char* lineEnd(const char* p, const char* end) {
+            const void* newline = memchr(p, '\n', (size_t)(end - p));
+            return newline ? (const char*)newline : end;
+        }
+
+        // The rest of the line, trimmed (names and paths may contain spaces)
+        std::string restOfLine(const char* p, const char* end) {
+            p = skipSpaces(p, end);
+            while (end > p && (isSpace(end[-1]) || end[-1] == '\r')) end--;
+            return std::string(p, end);
+        }
+
+        // "v ", "vt " etc: the keyword followed by a space or tab
+        inline bool keyword(const char* p, const char* end, const char* word, size_t length) {
+            return (size_t)(end - p) > length && memcmp(p, word, length) == 0 && isSpace(p[length]);
+        }
+
+        // Up to count floats, missing ones are 0 like tinyobj
+        inline const char* parseFloats(const char* p, const char* end, float* out, int count) {
+            for (int i = 0; i < count; i++) {
+                p = skipSpaces(p, end);
+                const char* next = parseFloat(p, end, out[i]);
+                if (next == p) out[i] = 0.0f;
+                p = next;
+            }
+            return p;
+        }
+
+        inline const char* parseInt(const char* p, const char* end, int& value, bool& found) {
+            bool negative = false;
+            if (p < end && (*p == '-' || *p == '+')) {
+                negative = (*p == '-');
+                p++;
+            }
+            found = false;
+            int64_t v = 0;
+            while (p < end && isDigit(*p)) {
+                if (v < INT_MAX) v = v * 10 + (*p - '0');
+                found = true;
+                p++;
+            }
+            if (v > INT_MAX) v = INT_MAX;
+            value = negative ? -(int)v : (int)v;
+            return p;
+        }
+
+        // OBJ counts from 1, or back from the last one read when negative.
+        // Negatives are relative to this chunk until the merge knows its base.
+        inline int fixIndex(int index, int localCount, bool& relative) {
+            relative = index < 0;
+            if (index > 0) return index - 1;
+            if (index == 0) return 0;
+            return localCount + index;
+        }
+
+        void parseChunk(Chunk& chunk) {
+            std::vector<FaceCorner> face;
+            const char* p = chunk.begin;
+
+            while (p < chunk.end) {
+                const char* end = lineEnd(p, chunk.end);
+                const char* s = skipSpaces(p, end);
+                p = end + 1;
+
+                if (s >= end) continue;
+
+                if (keyword(s, end, "v", 1)) {
+                    float xyz[3];
+                    parseFloats(s + 2, end, xyz, 3);
+                    chunk.positions.insert(chunk.positions.end(), xyz, xyz + 3);
+                } else if (keyword(s, end, "vt", 2)) {
+                    float uv[2];
+                    parseFloats(s + 3, end, uv, 2);
+                    chunk.texcoords.insert(chunk.texcoords.end(), uv, uv + 2);
+                } else if (keyword(s, end, "vn", 2)) {
+                    float xyz[3];
+                    parseFloats(s + 3, end, xyz, 3);
+                    chunk.normals.insert(chunk.normals.end(), xyz, xyz + 3);
+                } else if (keyword(s, end, "f", 1)) {
+                    // 1. v, v/vt, v//vn or v/vt/vn per corner
+                    face.clear();
+                    const int counts[3] = {
+                        (int)chunk.positions.size() / 3, (int)chunk.texcoords.size() / 2, (int)chunk.normals.size() / 3
+                    };
+                    const char* q = s + 2;
+                    while (true) {
+                        q = skipSpaces(q, end);
+                        int index[3] = { 0, kMissing, kMissing };
+                        bool found;
+                        q = parseInt(q, end, index[0], found);
+                        if (!found) break;
+
+                        for (int field = 1; field < 3 && q < end && *q == '/'; field++) {
+                            int value;
+                            q = parseInt(q + 1, end, value, found);
+                            if (found) index[field] = value;
+                        }
+
+                        FaceCorner c = {};
+                        int* out[3] = { &c.corner.v, &c.corner.vt, &c.corner.vn };
+                        for (int field = 0; field < 3; field++) {
+                            bool relative = false;
+                            *out[field] = (index[field] == kMissing) ? kMissing : fixIndex(index[field], counts[field], relative);
+                            c.relative |= (uint8_t)(relative << field);
+                        }
+                        face.push_back(c);
+
+                        // Skip whatever follows that isn't a corner
+                        while (q < end && !isSpace(*q) && *q != '\r') q++;
+                    }
+
+                    // 2. Fan into triangles, the way tinyobj triangulates
+                    if (face.size() < 3) continue;
+                    for (size_t k = 2; k < face.size(); k++) {
+                        const FaceCorner* tri[3] = { &face[0], &face[k - 1], &face[k] };
+                        for (int i = 0; i < 3; i++) {
+                            for (int field = 0; field < 3; field++) {
+                                if (tri[i]->relative & (1 << field)) chunk.relative.push_back((int)chunk.corners.size() * 3 + field);
+                            }
+                            chunk.corners.push_back(tri[i]->corner);
+                        }
+                    }
+                } else if (keyword(s, end, "usemtl", 6)) {
+                    chunk.switches.push_back({ (int)chunk.corners.size() / 3, -1, restOfLine(s + 7, end) });
+                } else if (keyword(s, end, "mtllib", 6)) {
+                    chunk.libraries.push_back(restOfLine(s + 7, end));
+                }
+            }
+        }
+
+        inline Color toColor(const float rgb[3]) {
+            auto channel = [](float v) { return (unsigned char)(Clamp(v, 0.0f, 1.0f) * 255.0f); };
+            return { channel(rgb[0]), channel(rgb[1]), channel(rgb[2]), 255 };
+        }
+
+        std::string relativeTo(const std::filesystem::path& folder, const std::string& name) {
+            std::filesystem::path p(name);
+            if (p.is_absolute() || folder.empty()) return p.generic_string();
+            return (folder / p).generic_string();
+        }
+
+        // MTL files are a few hundred bytes, no point spreading them out
+        void parseLibrary(const std::string& path, const std::filesystem::path& folder, std::vector<MaterialData>& materials) {
+            std::vector<uint8_t> bytes;
+            if (!PackArchive::readFile(path.c_str(), bytes)) {
+                TraceLog(LOG_WARNING, "MODEL: [%s] Failed to open material library", path.c_str());
+                return;
+            }
+
+            const char* p = (const char*)bytes.data();
+            const char* fileEnd = p + bytes.size();
+            MaterialData* current = nullptr;
+            float rgb[3];
+
+            while (p < fileEnd) {
+                const char* end = lineEnd(p, fileEnd);
+                const char* s = skipSpaces(p, end);
+                p = end + 1;
+
+                if (keyword(s, end, "newmtl", 6)) {
+                    materials.emplace_back();
+                    current = &materials.back();
+                    current->name = restOfLine(s + 7, end);
+                    continue;
+                }
+                if (!current) continue;
+
+                if (keyword(s, end, "Kd", 2)) {
+                    parseFloats(s + 3, end, rgb, 3);
+                    current->diffuse = toColor(rgb);
+                } else if (keyword(s, end, "Ks", 2)) {
+                    parseFloats(s + 3, end, rgb, 3);
+                    current->specular = toColor(rgb);
+                } else if (keyword(s, end, "Ke", 2)) {
+                    parseFloats(s + 3, end, rgb, 3);
+                    current->emission = toColor(rgb);
+                } else if (keyword(s, end, "Ns", 2)) {
+                    parseFloats(s + 3, end, &current->shininess, 1);
+                } else if (keyword(s, end, "map_Kd", 6)) {
+                    current->diffuseMap = relativeTo(folder, restOfLine(s + 7, end));
+                } else if (keyword(s, end, "map_Ks", 6)) {
+                    current->specularMap = relativeTo(folder, restOfLine(s + 7, end));
+                } else if (keyword(s, end, "map_bump", 8)) {
+                    current->normalMap = relativeTo(folder, restOfLine(s + 9, end));
+                } else if (keyword(s, end, "bump", 4)) {
+                    current->normalMap = relativeTo(folder, restOfLine(s + 5, end));
+                } else if (keyword(s, end, "disp", 4)) {
+                    current->heightMap = relativeTo(folder, restOfLine(s + 5, end));
+                }
+            }
+        }
+
+        // One attribute of one corner, zeros if the index is out of range
+        inline bool copyAttribute(const std::vector<float>& source, int index, int width, float* out) {
+            if (index < 0 || (size_t)index * width + width > source.size()) {
+                for (int i = 0; i < width; i++) out[i] = 0.0f;
+                return index == kMissing;
+            }
+            memcpy(out, source.data() + (size_t)index * width, width * sizeof(float));
+            return true;
+        }
+    }
+
+    // Decimal mantissa and exponent, then Clinger's fast path: when both fit
+    // a double exactly, one multiply or divide is a correctly rounded double.
+    // Narrowing that to float rounds a second time, which only goes wrong
+    // when the double landed exactly halfway between two floats (the true
+    // value may have been just off it), so those go the slow way. So do
+    // float subnormals and longer or huge numbers (no exporter writes them):
+    // strtof rounds them once, from the text.
+    const char* parseFloat(const char* begin, const char* end, float& value) {
+        static const double powers[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+
+        const char* p = begin;
+        bool negative = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            negative = (*p == '-');
+            p++;
+        }
+
+        uint64_t mantissa = 0;
+        int digits = 0;             // Significant ones in mantissa
+        int exponent = 0;
+        bool any = false, truncated = false;
+
+        for (; p < end && isDigit(*p); p++) {
+            any = true;
+            if (digits < 19) {
+                mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+                if (mantissa != 0) digits++;
+            } else {
+                exponent++;
+                truncated |= (*p != '0');
+            }
+        }
+        if (p < end && *p == '.') {
+            for (p++; p < end && isDigit(*p); p++) {
+                any = true;
+                if (digits < 19) {
+                    mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+                    if (mantissa != 0) digits++;
+                    exponent--;
+                } else {
+                    truncated |= (*p != '0');
+                }
+            }
+        }
+        if (!any) return begin;
+
+        if (p < end && (*p == 'e' || *p == 'E')) {
+            const char* q = p + 1;
+            bool negativeExponent = false;
+            if (q < end && (*q == '-' || *q == '+')) {
+                negativeExponent = (*q == '-');
+                q++;
+            }
+            if (q < end && isDigit(*q)) {
+                int e = 0;
+                for (; q < end && isDigit(*q); q++) {
+                    if (e < 100000) e = e * 10 + (*q - '0');
+                }
+                exponent += negativeExponent ? -e : e;
+                p = q;
+            }
+        }
+
+        if (!truncated && mantissa <= (1ull << 53) && exponent >= -22 && exponent <= 22) {
+            double d = (double)mantissa;
+            d = (exponent < 0) ? d / powers[-exponent] : d * powers[exponent];
+
+            // Float's 24 bits are the top of double's 53, halfway is the 29
+            // below them reading 1000...0. Exponent 897 is 2^-126, FLT_MIN.
+            uint64_t bits;
+            memcpy(&bits, &d, sizeof(bits));
+            int biasedExponent = (int)(bits >> 52);
+            if (d == 0.0 || (biasedExponent >= 897 && (bits & 0x1FFFFFFFull) != 0x10000000ull)) {
+                value = (float)(negative ? -d : d);
+                return p;
+            }
+        }
+
+        char buffer[128];
+        size_t length = std::min((size_t)(p - begin), sizeof(buffer) - 1);
+        memcpy(buffer, begin, length);
+        buffer[length] = '\0';
+        value = strtof(buffer, nullptr);
+        return p;
+    }
+
+    bool parse(const char* path, JobSystem& jobs, Data& out) {
+        PROFILE_SCOPE("ObjLoader::parse");
+        out = Data();
+
+        std::vector<uint8_t> bytes;
+        if (!PackArchive::readFile(path, bytes)) {
+            TraceLog(LOG_WARNING, "MODEL: [%s] Failed to open file", path);
+            return false;
+        }
+        const char* text = (const char*)bytes.data();
+        const char* textEnd = text + bytes.size();
+
+        // 1. Chunks at line breaks, a few per thread so an unlucky one
+        // (all faces, say) doesn't hold up the rest
+        size_t maxChunks = (size_t)(jobs.getWorkerCount() + 1) * 4;
+        size_t chunkCount = std::max<size_t>(1, std::min(bytes.size() / kMinChunk, maxChunks));
+        std::vector<Chunk> chunks(chunkCount);
+        const char* cursor = text;
+        for (size_t i = 0; i < chunkCount; i++) {
+            const char* target = text + bytes.size() * (i + 1) / chunkCount;
+            const char* split = textEnd;
+            if (i + 1 < chunkCount) {
+                split = lineEnd(std::max(target, cursor), textEnd);
+                if (split < textEnd) split++;
+            }
+            chunks[i].begin = cursor;
+            chunks[i].end = split;
+            cursor = split;
+        }
+
+        // 2. Parse them
+        jobs.parallelFor((int)chunkCount, 1, [&](int begin, int end) {
+            for (int i = begin; i < end; i++) parseChunk(chunks[i]);
+        });
+
+        // 3. Where each chunk's vertices land, and the materials
+        int positionCount = 0, texcoordCount = 0, normalCount = 0;
+        std::vector<std::string> libraries;
+        for (Chunk& chunk : chunks) {
+            chunk.positionBase = positionCount;
+            chunk.texcoordBase = texcoordCount;
+            chunk.normalBase = normalCount;
+            positionCount += (int)chunk.positions.size() / 3;
+            texcoordCount += (int)chunk.texcoords.size() / 2;
+            normalCount += (int)chunk.normals.size() / 3;
+            for (const std::string& library : chunk.libraries) {
+                if (std::find(libraries.begin(), libraries.end(), library) == libraries.end()) libraries.push_back(library);
+            }
+        }
+
+        std::filesystem::path folder = std::filesystem::path(path).parent_path();
+        for (const std::string& library : libraries) parseLibrary(relativeTo(folder, library), folder, out.materials);
+
+        std::unordered_map<std::string, int> materialIds;
+        for (int m = (int)out.materials.size() - 1; m >= 0; m--) materialIds[out.materials[m].name] = m;
+
+        // usemtl carries over chunk boundaries
+        int material = -1;
+        for (Chunk& chunk : chunks) {
+            chunk.startMaterial = material;
+            for (Switch& s : chunk.switches) {
+                auto found = materialIds.find(s.name);
+                s.material = (found != materialIds.end()) ? found->second : -1;
+                material = s.material;
+            }
+        }
+
+        // 4. Gather the attributes, make every index absolute and count each
+        // mesh's triangles, per chunk
+        const int meshCount = out.materials.empty() ? 1 : (int)out.materials.size();
+        std::vector<float> positions((size_t)positionCount * 3);
+        std::vector<float> texcoords((size_t)texcoordCount * 2);
+        std::vector<float> normals((size_t)normalCount * 3);
+
+        jobs.parallelFor((int)chunkCount, 1, [&](int begin, int end) {
+            for (int i = begin; i < end; i++) {
+                Chunk& chunk = chunks[i];
+                std::copy(chunk.positions.begin(), chunk.positions.end(), positions.begin() + (size_t)chunk.positionBase * 3);
+                std::copy(chunk.texcoords.begin(), chunk.texcoords.end(), texcoords.begin() + (size_t)chunk.texcoordBase * 2);
+                std::copy(chunk.normals.begin(), chunk.normals.end(), normals.begin() + (size_t)chunk.normalBase * 3);
+
+                const int bases[3] = { chunk.positionBase, chunk.texcoordBase, chunk.normalBase };
+                for (int r : chunk.relative) {
+                    Corner& c = chunk.corners[r / 3];
+                    int* field = (r % 3 == 0) ? &c.v : (r % 3 == 1) ? &c.vt : &c.vn;
+                    *field += bases[r % 3];
+                }
+
+                // Spans of triangles between usemtl lines
+                chunk.meshCounts.assign(meshCount, 0);
+                int triangles = (int)chunk.corners.size() / 3;
+                int current = chunk.startMaterial;
+                int spanStart = 0;
+                for (size_t s = 0; s <= chunk.switches.size(); s++) {
+                    int spanEnd = (s < chunk.switches.size()) ? chunk.switches[s].triangle : triangles;
+                    chunk.meshCounts[current < 0 ? 0 : current] += spanEnd - spanStart;
+                    if (s < chunk.switches.size()) current = chunk.switches[s].material;
+                    spanStart = spanEnd;
+                }
+            }
+        });
+
+        // 5. Each chunk's slice of each mesh
+        std::vector<int> meshTriangles(meshCount, 0);
+        for (Chunk& chunk : chunks) {
+            chunk.meshStarts = meshTriangles;
+            for (int m = 0; m < meshCount; m++) meshTriangles[m] += chunk.meshCounts[m];
+        }
+
+        out.meshes.resize(meshCount);
+        for (int m = 0; m < meshCount; m++) {
+            out.meshes[m].vertices.resize((size_t)meshTriangles[m] * 9);
+            out.meshes[m].texcoords.resize((size_t)meshTriangles[m] * 6);
+            out.meshes[m].normals.resize((size_t)meshTriangles[m] * 9);
+            out.triangles += meshTriangles[m];
+        }
+
+        // 6. Write the triangles, unindexed like raylib's meshes
+        const bool hasTexcoords = texcoordCount > 0;
+        const bool hasNormals = normalCount > 0;
+        jobs.parallelFor((int)chunkCount, 1, [&](int begin, int end) {
+            for (int i = begin; i < end; i++) {
+                Chunk& chunk = chunks[i];
+                std::vector<int> next = chunk.meshStarts;
+                int current = chunk.startMaterial;
+                size_t s = 0;
+
+                int triangles = (int)chunk.corners.size() / 3;
+                for (int t = 0; t < triangles; t++) {
+                    while (s < chunk.switches.size() && chunk.switches[s].triangle == t) current = chunk.switches[s++].material;
+                    int m = current < 0 ? 0 : current;
+                    MeshData& mesh = out.meshes[m];
+                    size_t slot = (size_t)next[m]++;
+
+                    for (int k = 0; k < 3; k++) {
+                        const Corner& c = chunk.corners[(size_t)t * 3 + k];
+                        size_t vertex = slot * 3 + k;
+                        bool ok = copyAttribute(positions, c.v, 3, &mesh.vertices[vertex * 3]);
+                        if (hasTexcoords) {
+                            float* uv = &mesh.texcoords[vertex * 2];
+                            ok &= copyAttribute(texcoords, c.vt, 2, uv);
+                            if (c.vt >= 0 && c.vt < texcoordCount) uv[1] = 1.0f - uv[1];
+                        }
+                        if (hasNormals) ok &= copyAttribute(normals, c.vn, 3, &mesh.normals[vertex * 3]);
+                        chunk.badIndices += !ok;
+                    }
+                }
+            }
+        });
+
+        int badIndices = 0;
+        for (const Chunk& chunk : chunks) badIndices += chunk.badIndices;
+        if (badIndices > 0) TraceLog(LOG_WARNING, "MODEL: [%s] %d corners index past the end, zeroed", path, badIndices);
+
+        TraceLog(LOG_INFO, "MODEL: [%s] OBJ data parsed: %d triangles, %d materials in %d chunks", path, out.triangles,
+                 (int)out.materials.size(), (int)chunkCount);
+        return true;
+    }
+
+    Model upload(Data& data) {
+        PROFILE_SCOPE("ObjLoader::upload");
+        Model model = {};
+        model.transform = MatrixIdentity();
+
+        // 1. Meshes, handed to raylib's allocator so UnloadModel can free them
+        model.meshCount = (int)data.meshes.size();
+        model.meshes = (Mesh*)MemAlloc(model.meshCount * sizeof(Mesh));
+        model.meshMaterial = (int*)MemAlloc(model.meshCount * sizeof(int));
+
+        auto give = [](const std::vector<float>& values) {
+            float* p = (float*)MemAlloc((unsigned int)(std::max<size_t>(values.size(), 1) * sizeof(float)));
+            if (!values.empty()) memcpy(p, values.data(), values.size() * sizeof(float));
+            return p;
+        };
+        for (int m = 0; m < model.meshCount; m++) {
+            MeshData& source = data.meshes[m];
+            Mesh& mesh = model.meshes[m];
+            mesh.vertexCount = (int)source.vertices.size() / 3;
+            mesh.triangleCount = mesh.vertexCount / 3;
+            mesh.vertices = give(source.vertices);
+            mesh.texcoords = give(source.texcoords);
+            mesh.normals = give(source.normals);
+            source = MeshData();
+
+            model.meshMaterial[m] = data.materials.empty() ? 0 : m;
+            UploadMesh(&mesh, false);
+        }
+
+        // 2. Materials, as raylib fills them in from tinyobj's
+        if (data.materials.empty()) {
+            model.materialCount = 1;
+            model.materials = (Material*)MemAlloc(sizeof(Material));
+            model.materials[0] = LoadMaterialDefault();
+            return model;
+        }
+
+        model.materialCount = (int)data.materials.size();
+        model.materials = (Material*)MemAlloc(model.materialCount * sizeof(Material));
+        for (int m = 0; m < model.materialCount; m++) {
+            const MaterialData& source = data.materials[m];
+            Material& material = model.materials[m];
+            material = LoadMaterialDefault();
+
+            // The default material already has the 1x1 white texture in diffuse
+            MaterialMap& diffuse = material.maps[MATERIAL_MAP_DIFFUSE];
+            if (!source.diffuseMap.empty()) diffuse.texture = LoadTexture(source.diffuseMap.c_str());
+            else diffuse.color = source.diffuse;
+            diffuse.value = 0.0f;
+
+            MaterialMap& specular = material.maps[MATERIAL_MAP_SPECULAR];
+            if (!source.specularMap.empty()) specular.texture = LoadTexture(source.specularMap.c_str());
+            specular.color = source.specular;
+            specular.value = 0.0f;
+
+            MaterialMap& normal = material.maps[MATERIAL_MAP_NORMAL];
+            if (!source.normalMap.empty()) normal.texture = LoadTexture(source.normalMap.c_str());
+            normal.color = WHITE;
+            normal.value = source.shininess;
+
+            material.maps[MATERIAL_MAP_EMISSION].color = source.emission;
+            if (!source.heightMap.empty()) material.maps[MATERIAL_MAP_HEIGHT].texture = LoadTexture(source.heightMap.c_str());
+        }
+        return model;
+    }
+
+    Model load(const char* path, JobSystem& jobs) {
+        Data data;
+        if (!parse(path, jobs, data)) return Model{};
+        return upload(data);
+    }
+}
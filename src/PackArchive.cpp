@@ -0,0 +1,377 @@
+#include "PackArchive.hpp"
+#include "AssetCache.hpp"
+#include "Lz4.hpp"
+#include "raylib.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #define PACK_MMAP 1
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+    struct Header {
+        char magic[4];          // "DJOP"
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t namesSize;
+        uint64_t fileSize;
+        uint64_t reserved;
+    };
+
+    const uint32_t kPackVersion = 1;
+    const size_t kMaxName = 1024;       // Lookups resolve into a stack buffer this big
+
+    PackArchive* mounted = nullptr;
+
+    uint64_t pathHash(const char* name, size_t length) {
+        return AssetCache::hash(name, length);
+    }
+
+    bool readWhole(const char* path, std::vector<uint8_t>& out) {
+        FILE* file = fopen(path, "rb");
+        if (!file) return false;
+
+        fseek(file, 0, SEEK_END);
+        long length = ftell(file);
+        fseek(file, 0, SEEK_SET);
+        out.resize(length > 0 ? (size_t)length : 0);
+        bool ok = length >= 0 && (out.empty() || fread(out.data(), 1, out.size(), file) == out.size());
+        fclose(file);
+        return ok;
+    }
+
+    // raylib frees what these return with RL_FREE, so it all comes from RL_MALLOC
+    unsigned char* loadFileData(const char* fileName, int* dataSize) {
+        *dataSize = 0;
+        if (!fileName) return nullptr;
+
+        if (const PackArchive::Entry* entry = mounted ? mounted->find(fileName) : nullptr) {
+            unsigned char* data = (unsigned char*)RL_MALLOC(entry->size > 0 ? (size_t)entry->size : 1);
+            if (data && mounted->read(*entry, data)) {
+                *dataSize = (int)entry->size;
+                return data;
+            }
+            RL_FREE(data);
+            TraceLog(LOG_WARNING, "PACK: [%s] Damaged entry", fileName);
+            return nullptr;
+        }
+
+        std::vector<uint8_t> bytes;
+        if (!readWhole(fileName, bytes)) {
+            TraceLog(LOG_WARNING, "FILEIO: [%s] Failed to open file", fileName);
+            return nullptr;
+        }
+        unsigned char* data = (unsigned char*)RL_MALLOC(bytes.size() > 0 ? bytes.size() : 1);
+        if (!data) return nullptr;
+        memcpy(data, bytes.data(), bytes.size());
+        *dataSize = (int)bytes.size();
+        return data;
+    }
+
+    char* loadFileText(const char* fileName) {
+        int length = 0;
+        unsigned char* data = loadFileData(fileName, &length);
+        if (!data) return nullptr;
+
+        char* text = (char*)RL_MALLOC((size_t)length + 1);
+        if (text) {
+            memcpy(text, data, (size_t)length);
+            text[length] = '\0';
+        }
+        RL_FREE(data);
+        return text;
+    }
+}
+
+PackArchive::~PackArchive() {
+    close();
+}
+
+bool PackArchive::open(const char* path) {
+    close();
+
+#if defined(PACK_MMAP)
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        void* p = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+            base = (const uint8_t*)p;
+            size = (size_t)info.st_size;
+            mapped = true;
+
+            // Ask for all of it now: the kernel reads ahead in big sequential
+            // chunks instead of faulting in one page per file later
+            madvise(p, size, MADV_WILLNEED);
+        }
+    }
+    ::close(fd);
+#else
+    if (readWhole(path, contents) && !contents.empty()) {
+        base = contents.data();
+        size = contents.size();
+    }
+#endif
+    if (!base) return false;
+
+    // Everything below is checked once here, so lookups and reads can trust it
+    Header header;
+    bool ok = size >= sizeof(Header);
+    if (ok) {
+        memcpy(&header, base, sizeof(Header));
+        ok = memcmp(header.magic, "DJOP", 4) == 0 && header.version == kPackVersion && header.fileSize == size &&
+             (uint64_t)header.entryCount * sizeof(Entry) + header.namesSize <= size - sizeof(Header);
+    }
+
+    if (ok) {
+        entries = (const Entry*)(base + sizeof(Header));
+        entryCount = header.entryCount;
+        names = (const char*)(entries + entryCount);
+
+        for (uint32_t i = 0; i < entryCount && ok; i++) {
+            const Entry& e = entries[i];
+            ok = e.offset <= size && e.storedSize <= size - e.offset &&
+                 (uint64_t)e.nameOffset + e.nameLength <= header.namesSize &&
+                 ((e.flags & kCompressed) || e.storedSize == e.size) &&
+                 (i == 0 || entries[i - 1].pathHash <= e.pathHash);
+        }
+    }
+
+    if (!ok) {
+        TraceLog(LOG_WARNING, "PACK: %s isn't a valid version %u archive", path, kPackVersion);
+        close();
+        return false;
+    }
+
+    std::error_code error;
+    root = std::filesystem::current_path(error).string();
+    return true;
+}
+
+void PackArchive::close() {
+    unmount();
+
+#if defined(PACK_MMAP)
+    if (mapped) munmap((void*)base, size);
+#endif
+    base = nullptr;
+    size = 0;
+    mapped = false;
+    contents = std::vector<uint8_t>();
+    entries = nullptr;
+    entryCount = 0;
+    names = nullptr;
+}
+
+// Archive names are relative to where the game started (root), with forward
+// slashes and no "." or ".." parts. Relative paths are taken as being from
+// root as they stand; the working directory is never asked, which keeps
+// lookups thread safe and free of syscalls and allocations. Anything
+// relative to another file (an MTL's textures) has to be joined up by the
+// loader first, the way ObjLoader does. Returns the name's length in out, or
+// 0 if the path can't name an entry.
+size_t PackArchive::resolve(const char* path, char* out, size_t capacity) const {
+    auto isSeparator = [](char c) { return c == '/' || c == '\\'; };
+
+    // 1. Absolute paths have to be under root, and lose it
+    bool absolute = isSeparator(path[0]) || (path[0] != '\0' && path[1] == ':');
+    if (absolute) {
+        size_t i = 0;
+        for (; i < root.size(); i++) {
+            bool same = (root[i] == path[i]) || (isSeparator(root[i]) && isSeparator(path[i]));
+            if (!same) return 0;
+        }
+        if (i > 0 && !isSeparator(path[i]) && !isSeparator(root[i - 1])) return 0;
+        path += i;
+    }
+
+    // 2. Copy it over a part at a time: "." goes, ".." takes the last part back
+    size_t length = 0;
+    while (*path) {
+        while (isSeparator(*path)) path++;
+        const char* part = path;
+        while (*path && !isSeparator(*path)) path++;
+        size_t partLength = (size_t)(path - part);
+
+        if (partLength == 0 || (partLength == 1 && part[0] == '.')) continue;
+        if (partLength == 2 && part[0] == '.' && part[1] == '.') {
+            if (length == 0) return 0;      // Climbs out of root
+            while (length > 0 && out[length - 1] != '/') length--;
+            if (length > 0) length--;       // And its separator
+            continue;
+        }
+
+        if (length + (length > 0) + partLength > capacity) return 0;
+        if (length > 0) out[length++] = '/';
+        memcpy(out + length, part, partLength);
+        length += partLength;
+    }
+    return length;
+}
+
+const PackArchive::Entry* PackArchive::find(const char* path) const {
+    if (!base || !path) return nullptr;
+
+    char name[kMaxName];
+    size_t length = resolve(path, name, sizeof(name));
+    if (length == 0) return nullptr;
+    uint64_t hash = pathHash(name, length);
+
+    const Entry* end = entries + entryCount;
+    const Entry* e = std::lower_bound(entries, end, hash, [](const Entry& entry, uint64_t h) { return entry.pathHash < h; });
+    for (; e != end && e->pathHash == hash; e++) {
+        if (e->nameLength == length && memcmp(names + e->nameOffset, name, length) == 0) return e;
+    }
+    return nullptr;
+}
+
+bool PackArchive::read(const Entry& entry, uint8_t* out) const {
+    const uint8_t* stored = base + entry.offset;
+    if (entry.flags & kCompressed) return lz4::decompress(stored, (size_t)entry.storedSize, out, (size_t)entry.size);
+
+    memcpy(out, stored, (size_t)entry.size);
+    return true;
+}
+
+bool PackArchive::read(const Entry& entry, std::vector<uint8_t>& out) const {
+    out.resize((size_t)entry.size);
+    if (read(entry, out.data())) return true;
+    out.clear();
+    return false;
+}
+
+const uint8_t* PackArchive::view(const Entry& entry) const {
+    return (entry.flags & kCompressed) ? nullptr : base + entry.offset;
+}
+
+void PackArchive::mount() {
+    if (!base) return;
+    mounted = this;
+    SetLoadFileDataCallback(loadFileData);
+    SetLoadFileTextCallback(loadFileText);
+}
+
+void PackArchive::unmount() {
+    if (mounted != this) return;
+    mounted = nullptr;
+    SetLoadFileDataCallback(nullptr);
+    SetLoadFileTextCallback(nullptr);
+}
+
+bool PackArchive::readFile(const char* path, std::vector<uint8_t>& out) {
+    if (const Entry* entry = mounted ? mounted->find(path) : nullptr) return mounted->read(*entry, out);
+    return readWhole(path, out);
+}
+
+bool PackArchive::fileExists(const char* path) {
+    return (mounted && mounted->find(path)) || FileExists(path);
+}
+
+bool PackArchive::build(const char* path, const std::vector<std::string>& files, BuildStats& stats) {
+    stats = BuildStats();
+
+    // 1. Path order for the data, so a folder's files end up side by side
+    std::vector<std::string> sorted = files;
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    struct Pending {
+        Entry entry;
+        std::vector<uint8_t> stored;
+    };
+    std::vector<Pending> pending(sorted.size());
+    std::string nameTable;
+
+    // 2. Compress what's worth it
+    for (size_t i = 0; i < sorted.size(); i++) {
+        std::string name = std::filesystem::path(sorted[i]).lexically_normal().generic_string();
+        std::vector<uint8_t> data;
+        if (!readWhole(sorted[i].c_str(), data)) {
+            TraceLog(LOG_WARNING, "PACK: Can't read %s", sorted[i].c_str());
+            return false;
+        }
+        if (name.size() > kMaxName) {
+            TraceLog(LOG_WARNING, "PACK: %s has a name over %zu bytes", sorted[i].c_str(), kMaxName);
+            return false;
+        }
+
+        Pending& p = pending[i];
+        p.entry = {};
+        p.entry.pathHash = pathHash(name.data(), name.size());
+        p.entry.size = data.size();
+        p.entry.nameOffset = (uint32_t)nameTable.size();
+        p.entry.nameLength = (uint16_t)name.size();
+        nameTable += name;
+
+        std::vector<uint8_t> compressed(lz4::compressBound(data.size()));
+        compressed.resize(lz4::compress(data.data(), data.size(), compressed.data()));
+        if (compressed.size() <= data.size() - data.size() / 8 && !data.empty()) {
+            p.entry.flags = kCompressed;
+            p.stored = std::move(compressed);
+            stats.compressed++;
+        } else {
+            p.stored = std::move(data);
+        }
+        p.entry.storedSize = p.stored.size();
+
+        stats.files++;
+        stats.inputBytes += p.entry.size;
+    }
+
+    // 3. Lay out: header, contents, names, then each entry on a boundary
+    auto align = [](uint64_t offset) { return (offset + kAlignment - 1) / kAlignment * kAlignment; };
+    uint64_t offset = align(sizeof(Header) + pending.size() * sizeof(Entry) + nameTable.size());
+    for (Pending& p : pending) {
+        p.entry.offset = offset;
+        offset = align(offset + p.entry.storedSize);
+    }
+
+    std::vector<Entry> toc(pending.size());
+    for (size_t i = 0; i < pending.size(); i++) toc[i] = pending[i].entry;
+    std::sort(toc.begin(), toc.end(), [](const Entry& a, const Entry& b) { return a.pathHash < b.pathHash; });
+
+    Header header = { { 'D', 'J', 'O', 'P' }, kPackVersion, (uint32_t)toc.size(), (uint32_t)nameTable.size(), offset, 0 };
+
+    // 4. Through a temp file, like the asset cache, so a failed build never
+    // leaves a half archive for the game to mount
+    std::string temp = std::string(path) + ".tmp";
+    FILE* file = fopen(temp.c_str(), "wb");
+    if (!file) return false;
+
+    const uint8_t zeros[kAlignment] = {};
+    uint64_t written = 0;
+    auto put = [&](const void* data, size_t bytes) {
+        if (bytes > 0 && fwrite(data, 1, bytes, file) != bytes) return false;
+        written += bytes;
+        return true;
+    };
+    auto pad = [&](uint64_t to) { return put(zeros, (size_t)(to - written)); };
+
+    bool ok = put(&header, sizeof(header)) &&
+              put(toc.data(), toc.size() * sizeof(Entry)) &&
+              put(nameTable.data(), nameTable.size());
+    for (size_t i = 0; i < pending.size() && ok; i++) {
+        ok = pad(pending[i].entry.offset) && put(pending[i].stored.data(), pending[i].stored.size());
+    }
+    ok = ok && pad(offset);
+    ok = (fclose(file) == 0) && ok;
+
+    std::error_code error;
+    if (ok) {
+        std::filesystem::rename(temp, path, error);
+        ok = !error;
+    }
+    if (!ok) std::filesystem::remove(temp, error);
+
+    stats.outputBytes = written;
+    return ok;
+}
@@ -0,0 +1,23 @@
+#include "Placement.hpp"
+#include "raymath.h"
+
+Matrix placementTransform(Vector3 position, float yawDegrees, Vector3 scale, Vector3 groundNormal, bool alignToGround) {
+    Vector3 axis = { 0, 1, 0 };
+    float angle = yawDegrees * DEG2RAD;
+
+    if (alignToGround) {
+        // Rotate {0,1,0} (default up) to match groundNormal
+        Quaternion q = QuaternionFromVector3ToVector3({0, 1, 0}, groundNormal);
+
+        // Combine with the path rotation (around the new normal)
+        Quaternion pathRot = QuaternionFromAxisAngle(groundNormal, yawDegrees * DEG2RAD);
+        Quaternion finalRot = QuaternionMultiply(pathRot, q);
+
+        QuaternionToAxisAngle(finalRot, &axis, &angle);
+    }
+
+    Matrix matScale = MatrixScale(scale.x, scale.y, scale.z);
+    Matrix matRotation = MatrixRotate(axis, angle);
+    Matrix matTranslation = MatrixTranslate(position.x, position.y, position.z);
+    return MatrixMultiply(MatrixMultiply(matScale, matRotation), matTranslation);
+}
@@ -0,0 +1,180 @@
+#include "Profiler.hpp"
+#include "TextRenderer.hpp"
+#include "raylib.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+namespace profiler {
+    namespace detail {
+        std::atomic<bool> enabled{ false };
+    }
+
+    namespace {
+        const int kAverageFrames = 60;
+        const float kBudgetMs = 1000.0f / 60.0f;
+
+        struct State {
+            std::mutex registry;
+            const char* names[kMaxMarkers] = {};
+            int markerCount = 0;
+
+            // Nanoseconds spent in each scope so far this frame
+            std::atomic<int64_t> accumulated[kMaxMarkers];
+
+            // Finished frames, oldest overwritten first
+            float scopeMs[kHistory][kMaxMarkers] = {};
+            float frameMs[kHistory] = {};
+            float gpuSceneMs[kHistory] = {};
+            float gpuUiMs[kHistory] = {};
+            int head = 0;       // Next frame to write
+            int filled = 0;
+        };
+
+        State state;
+
+        // Mean of the newest count frames of a series
+        template <typename Get>
+        float average(int count, Get get) {
+            count = std::min(count, state.filled);
+            if (count == 0) return 0.0f;
+
+            float sum = 0.0f;
+            for (int i = 1; i <= count; i++) sum += get((state.head - i + kHistory) % kHistory);
+            return sum / count;
+        }
+
+        // One labelled bar, full width at a whole frame's budget
+        void drawBar(TextRenderer& text, const char* label, float ms, float x, float y, Color color) {
+            const float barX = x + 130.0f, barWidth = 160.0f, fontSize = 14.0f;
+            char value[32];
+            snprintf(value, sizeof(value), "%6.2f", ms);
+
+            DrawRectangle((int)barX, (int)y + 3, (int)(barWidth * std::min(ms / kBudgetMs, 1.0f)), 10, color);
+            text.draw(label, { x, y }, fontSize, RAYWHITE);
+            text.draw(value, { barX + barWidth + 8.0f, y }, fontSize, RAYWHITE, false);
+        }
+    }
+
+    Marker::Marker(const char* name) : name(name) {
+        std::lock_guard<std::mutex> lock(state.registry);
+
+        // Same name, same slot, wherever it's used from
+        for (int i = 0; i < state.markerCount; i++) {
+            if (strcmp(state.names[i], name) == 0) {
+                slot = i;
+                return;
+            }
+        }
+
+        if (state.markerCount == kMaxMarkers) {
+            slot = -1;
+            return;
+        }
+        slot = state.markerCount;
+        state.names[state.markerCount++] = name;
+    }
+
+    void setEnabled(bool enabled) {
+        if (enabled && !isEnabled()) {
+            for (std::atomic<int64_t>& a : state.accumulated) a.store(0, std::memory_order_relaxed);
+            state.head = 0;
+            state.filled = 0;
+        }
+        detail::enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    void addSince(const Marker& marker, std::chrono::steady_clock::time_point start) {
+        int slot = marker.getSlot();
+        if (!isEnabled() || slot < 0) return;
+
+        int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        state.accumulated[slot].fetch_add(ns, std::memory_order_relaxed);
+    }
+
+    void Scope::finish() {
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+        int slot = marker->getSlot();
+        if (isEnabled() && slot >= 0) {
+            int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+            state.accumulated[slot].fetch_add(ns, std::memory_order_relaxed);
+        }
+        trace::record(marker->getName(), start, end);
+    }
+
+    void endFrame(float frameMs, float gpuSceneMs, float gpuUiMs) {
+        if (!isEnabled()) return;
+
+        int frame = state.head;
+        for (int i = 0; i < kMaxMarkers; i++) {
+            state.scopeMs[frame][i] = (float)state.accumulated[i].exchange(0, std::memory_order_relaxed) / 1000000.0f;
+        }
+        state.frameMs[frame] = frameMs;
+        state.gpuSceneMs[frame] = gpuSceneMs;
+        state.gpuUiMs[frame] = gpuUiMs;
+
+        state.head = (state.head + 1) % kHistory;
+        state.filled = std::min(state.filled + 1, kHistory);
+    }
+
+    void drawOverlay(TextRenderer& text, float x, float y) {
+        int markers;
+        {
+            std::lock_guard<std::mutex> lock(state.registry);
+            markers = state.markerCount;
+        }
+
+        const float width = 360.0f, graphHeight = 80.0f, lineHeight = 18.0f;
+        const float height = 40.0f + graphHeight + lineHeight * (markers + 2);
+        DrawRectangle((int)x, (int)y, (int)width, (int)height, Fade(BLACK, 0.7f));
+
+        // 1. Frame times, newest on the right. The line is the 60 fps budget,
+        // the graph tops out at twice that.
+        char line[64];
+        float frameAverage = average(kAverageFrames, [](int f) { return state.frameMs[f]; });
+        snprintf(line, sizeof(line), "Frame %.2f ms (%.0f fps)", frameAverage, frameAverage > 0.0f ? 1000.0f / frameAverage : 0.0f);
+        text.draw(line, { x + 10.0f, y + 8.0f }, 16.0f, RAYWHITE, false);
+
+        float graphTop = y + 32.0f;
+        float step = (width - 20.0f) / kHistory;
+        for (int i = 0; i < state.filled; i++) {
+            int f = (state.head - state.filled + i + kHistory) % kHistory;
+            float ms = state.frameMs[f];
+            float h = std::min(ms / (2.0f * kBudgetMs), 1.0f) * graphHeight;
+            Color color = (ms <= kBudgetMs * 1.05f) ? GREEN : (ms <= 2.0f * kBudgetMs ? YELLOW : RED);
+            float left = x + 10.0f + (kHistory - state.filled + i) * step;
+            DrawRectangle((int)left, (int)(graphTop + graphHeight - h), std::max(1, (int)step), (int)h, color);
+        }
+        DrawLine((int)x + 10, (int)(graphTop + graphHeight * 0.5f), (int)(x + width - 10.0f), (int)(graphTop + graphHeight * 0.5f), Fade(WHITE, 0.5f));
+
+        // 2. Where it went: CPU scopes in registration order, then the GPU passes
+        float rowY = graphTop + graphHeight + 8.0f;
+        for (int m = 0; m < markers; m++) {
+            float ms = average(kAverageFrames, [m](int f) { return state.scopeMs[f][m]; });
+            drawBar(text, state.names[m], ms, x + 10.0f, rowY, SKYBLUE);
+            rowY += lineHeight;
+        }
+        drawBar(text, "GPU 3D pass", average(kAverageFrames, [](int f) { return state.gpuSceneMs[f]; }), x + 10.0f, rowY, ORANGE);
+        rowY += lineHeight;
+        drawBar(text, "GPU 2D pass", average(kAverageFrames, [](int f) { return state.gpuUiMs[f]; }), x + 10.0f, rowY, ORANGE);
+    }
+
+    void logSummary(const char* label) {
+        int markers;
+        {
+            std::lock_guard<std::mutex> lock(state.registry);
+            markers = state.markerCount;
+        }
+
+        TraceLog(LOG_INFO, "%s: Averages over the last %d frames", label, state.filled);
+        TraceLog(LOG_INFO, "%s:   %-20s %8.2f ms", label, "frame", average(kHistory, [](int f) { return state.frameMs[f]; }));
+        TraceLog(LOG_INFO, "%s:   %-20s %8.2f ms", label, "GPU 3D", average(kHistory, [](int f) { return state.gpuSceneMs[f]; }));
+        TraceLog(LOG_INFO, "%s:   %-20s %8.2f ms", label, "GPU 2D", average(kHistory, [](int f) { return state.gpuUiMs[f]; }));
+        for (int m = 0; m < markers; m++) {
+            float ms = average(kHistory, [m](int f) { return state.scopeMs[f][m]; });
+            TraceLog(LOG_INFO, "%s:   %-20s %8.2f ms", label, state.names[m], ms);
+        }
+    }
+}
@@ -0,0 +1,456 @@
+#include "RayMesh.hpp"
+#include "raymath.h"
+#include <cmath>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #define RAYMESH_X86 1
+    #define RAYMESH_TARGET(isa) __attribute__((target(isa)))
+    #include <immintrin.h>
+#elif defined(_M_X64)
+    // MSVC: SSE2 is baseline on x64, the wider paths need per-function targets
+    #define RAYMESH_SSE_ONLY 1
+    #define RAYMESH_TARGET(isa)
+    #include <immintrin.h>
+#endif
+
+// NOTE: bit-compatibility relies on this file being built without FMA
+// contraction (-ffp-contract=off, see src/CMakeLists.txt), the same way
+// raylib's own scalar code ends up on a default x86-64 build.
+
+// Same threshold as raylib's GetRayCollisionTriangle
+static const float kEpsilon = 0.000001f;
+
+namespace {
+    struct SoaView {
+        const float *p1x, *p1y, *p1z;
+        const float *e1x, *e1y, *e1z;
+        const float *e2x, *e2y, *e2z;
+        int count;
+    };
+
+    // Closest hit with ties to the lowest index, i.e. exactly what raylib's
+    // "first hit, then strictly closer" loop ends up keeping
+    inline void keepBest(RayMesh::Best& best, float t, int index) {
+        if (!best.hit || t < best.t || (t == best.t && index < best.index)) {
+            best.hit = true;
+            best.t = t;
+            best.index = index;
+        }
+    }
+
+    void kernelScalar(const SoaView& tri, const Ray* rays, int rayCount, RayMesh::Best* best) {
+        for (int r = 0; r < rayCount; r++) {
+            const Vector3 o = rays[r].position;
+            const Vector3 d = rays[r].direction;
+
+            for (int i = 0; i < tri.count; i++) {
+                // p = cross(direction, edge2)
+                float px = d.y * tri.e2z[i] - d.z * tri.e2y[i];
+                float py = d.z * tri.e2x[i] - d.x * tri.e2z[i];
+                float pz = d.x * tri.e2y[i] - d.y * tri.e2x[i];
+
+                float det = tri.e1x[i] * px + tri.e1y[i] * py + tri.e1z[i] * pz;
+                if ((det > -kEpsilon) && (det < kEpsilon)) continue;
+                float invDet = 1.0f / det;
+
+                float tvx = o.x - tri.p1x[i];
+                float tvy = o.y - tri.p1y[i];
+                float tvz = o.z - tri.p1z[i];
+
+                float u = (tvx * px + tvy * py + tvz * pz) * invDet;
+                if ((u < 0.0f) || (u > 1.0f)) continue;
+
+                // q = cross(tv, edge1)
+                float qx = tvy * tri.e1z[i] - tvz * tri.e1y[i];
+                float qy = tvz * tri.e1x[i] - tvx * tri.e1z[i];
+                float qz = tvx * tri.e1y[i] - tvy * tri.e1x[i];
+
+                float v = (d.x * qx + d.y * qy + d.z * qz) * invDet;
+                if ((v < 0.0f) || ((u + v) > 1.0f)) continue;
+
+                float t = (tri.e2x[i] * qx + tri.e2y[i] * qy + tri.e2z[i] * qz) * invDet;
+                if (t > kEpsilon) keepBest(best[r], t, i);
+            }
+        }
+    }
+
+#if defined(RAYMESH_X86) || defined(RAYMESH_SSE_ONLY)
+    // --- SSE2: 4 triangles per step ---
+    RAYMESH_TARGET("sse2")
+    void kernelSSE(const SoaView& tri, const Ray* rays, int rayCount, RayMesh::Best* best) {
+        const __m128 eps = _mm_set1_ps(kEpsilon);
+        const __m128 negEps = _mm_set1_ps(-kEpsilon);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+
+        __m128 ox[RayMesh::maxPacket], oy[RayMesh::maxPacket], oz[RayMesh::maxPacket];
+        __m128 dx[RayMesh::maxPacket], dy[RayMesh::maxPacket], dz[RayMesh::maxPacket];
+        __m128 bestT[RayMesh::maxPacket], bestI[RayMesh::maxPacket], laneHit[RayMesh::maxPacket];
+
+        for (int r = 0; r < rayCount; r++) {
+            ox[r] = _mm_set1_ps(rays[r].position.x);
+            oy[r] = _mm_set1_ps(rays[r].position.y);
+            oz[r] = _mm_set1_ps(rays[r].position.z);
+            dx[r] = _mm_set1_ps(rays[r].direction.x);
+            dy[r] = _mm_set1_ps(rays[r].direction.y);
+            dz[r] = _mm_set1_ps(rays[r].direction.z);
+            bestT[r] = zero;
+            bestI[r] = zero;
+            laneHit[r] = zero;
+        }
+
+        __m128i index = _mm_setr_epi32(0, 1, 2, 3);
+        const __m128i step = _mm_set1_epi32(4);
+
+        for (int i = 0; i < tri.count; i += 4) {
+            const __m128 e1x = _mm_loadu_ps(tri.e1x + i), e1y = _mm_loadu_ps(tri.e1y + i), e1z = _mm_loadu_ps(tri.e1z + i);
+            const __m128 e2x = _mm_loadu_ps(tri.e2x + i), e2y = _mm_loadu_ps(tri.e2y + i), e2z = _mm_loadu_ps(tri.e2z + i);
+            const __m128 p1x = _mm_loadu_ps(tri.p1x + i), p1y = _mm_loadu_ps(tri.p1y + i), p1z = _mm_loadu_ps(tri.p1z + i);
+            const __m128 indexF = _mm_castsi128_ps(index);
+
+            for (int r = 0; r < rayCount; r++) {
+                __m128 px = _mm_sub_ps(_mm_mul_ps(dy[r], e2z), _mm_mul_ps(dz[r], e2y));
+                __m128 py = _mm_sub_ps(_mm_mul_ps(dz[r], e2x), _mm_mul_ps(dx[r], e2z));
+                __m128 pz = _mm_sub_ps(_mm_mul_ps(dx[r], e2y), _mm_mul_ps(dy[r], e2x));
+
+                __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+                __m128 invDet = _mm_div_ps(one, det);
+
+                __m128 tvx = _mm_sub_ps(ox[r], p1x);
+                __m128 tvy = _mm_sub_ps(oy[r], p1y);
+                __m128 tvz = _mm_sub_ps(oz[r], p1z);
+
+                __m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tvx, px), _mm_mul_ps(tvy, py)), _mm_mul_ps(tvz, pz)), invDet);
+
+                __m128 qx = _mm_sub_ps(_mm_mul_ps(tvy, e1z), _mm_mul_ps(tvz, e1y));
+                __m128 qy = _mm_sub_ps(_mm_mul_ps(tvz, e1x), _mm_mul_ps(tvx, e1z));
+                __m128 qz = _mm_sub_ps(_mm_mul_ps(tvx, e1y), _mm_mul_ps(tvy, e1x));
+
+                __m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx[r], qx), _mm_mul_ps(dy[r], qy)), _mm_mul_ps(dz[r], qz)), invDet);
+                __m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), invDet);
+
+                // Same rejections as the scalar test, NaNs fall through the same way
+                __m128 reject = _mm_and_ps(_mm_cmpgt_ps(det, negEps), _mm_cmplt_ps(det, eps));
+                reject = _mm_or_ps(reject, _mm_or_ps(_mm_cmplt_ps(u, zero), _mm_cmpgt_ps(u, one)));
+                reject = _mm_or_ps(reject, _mm_or_ps(_mm_cmplt_ps(v, zero), _mm_cmpgt_ps(_mm_add_ps(u, v), one)));
+                __m128 hit = _mm_andnot_ps(reject, _mm_cmpgt_ps(t, eps));
+
+                // Strictly closer only, so each lane keeps its earliest index on ties
+                __m128 take = _mm_and_ps(hit, _mm_or_ps(_mm_cmplt_ps(t, bestT[r]), _mm_andnot_ps(laneHit[r], hit)));
+                bestT[r] = _mm_or_ps(_mm_and_ps(take, t), _mm_andnot_ps(take, bestT[r]));
+                bestI[r] = _mm_or_ps(_mm_and_ps(take, indexF), _mm_andnot_ps(take, bestI[r]));
+                laneHit[r] = _mm_or_ps(laneHit[r], hit);
+            }
+
+            index = _mm_add_epi32(index, step);
+        }
+
+        for (int r = 0; r < rayCount; r++) {
+            alignas(16) float t[4];
+            alignas(16) int idx[4];
+            _mm_store_ps(t, bestT[r]);
+            _mm_store_si128((__m128i*)idx, _mm_castps_si128(bestI[r]));
+            int mask = _mm_movemask_ps(laneHit[r]);
+            for (int l = 0; l < 4; l++) {
+                if (mask & (1 << l)) keepBest(best[r], t[l], idx[l]);
+            }
+        }
+    }
+#endif
+
+#if defined(RAYMESH_X86)
+    // --- AVX2: 8 triangles per step ---
+    RAYMESH_TARGET("avx2")
+    void kernelAVX2(const SoaView& tri, const Ray* rays, int rayCount, RayMesh::Best* best) {
+        const __m256 eps = _mm256_set1_ps(kEpsilon);
+        const __m256 negEps = _mm256_set1_ps(-kEpsilon);
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 one = _mm256_set1_ps(1.0f);
+
+        __m256 ox[RayMesh::maxPacket], oy[RayMesh::maxPacket], oz[RayMesh::maxPacket];
+        __m256 dx[RayMesh::maxPacket], dy[RayMesh::maxPacket], dz[RayMesh::maxPacket];
+        __m256 bestT[RayMesh::maxPacket], bestI[RayMesh::maxPacket], laneHit[RayMesh::maxPacket];
+
+        for (int r = 0; r < rayCount; r++) {
+            ox[r] = _mm256_set1_ps(rays[r].position.x);
+            oy[r] = _mm256_set1_ps(rays[r].position.y);
+            oz[r] = _mm256_set1_ps(rays[r].position.z);
+            dx[r] = _mm256_set1_ps(rays[r].direction.x);
+            dy[r] = _mm256_set1_ps(rays[r].direction.y);
+            dz[r] = _mm256_set1_ps(rays[r].direction.z);
+            bestT[r] = zero;
+            bestI[r] = zero;
+            laneHit[r] = zero;
+        }
+
+        __m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m256i step = _mm256_set1_epi32(8);
+
+        for (int i = 0; i < tri.count; i += 8) {
+            const __m256 e1x = _mm256_loadu_ps(tri.e1x + i), e1y = _mm256_loadu_ps(tri.e1y + i), e1z = _mm256_loadu_ps(tri.e1z + i);
+            const __m256 e2x = _mm256_loadu_ps(tri.e2x + i), e2y = _mm256_loadu_ps(tri.e2y + i), e2z = _mm256_loadu_ps(tri.e2z + i);
+            const __m256 p1x = _mm256_loadu_ps(tri.p1x + i), p1y = _mm256_loadu_ps(tri.p1y + i), p1z = _mm256_loadu_ps(tri.p1z + i);
+            const __m256 indexF = _mm256_castsi256_ps(index);
+
+            for (int r = 0; r < rayCount; r++) {
+                __m256 px = _mm256_sub_ps(_mm256_mul_ps(dy[r], e2z), _mm256_mul_ps(dz[r], e2y));
+                __m256 py = _mm256_sub_ps(_mm256_mul_ps(dz[r], e2x), _mm256_mul_ps(dx[r], e2z));
+                __m256 pz = _mm256_sub_ps(_mm256_mul_ps(dx[r], e2y), _mm256_mul_ps(dy[r], e2x));
+
+                __m256 det = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e1x, px), _mm256_mul_ps(e1y, py)), _mm256_mul_ps(e1z, pz));
+                __m256 invDet = _mm256_div_ps(one, det);
+
+                __m256 tvx = _mm256_sub_ps(ox[r], p1x);
+                __m256 tvy = _mm256_sub_ps(oy[r], p1y);
+                __m256 tvz = _mm256_sub_ps(oz[r], p1z);
+
+                __m256 u = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(tvx, px), _mm256_mul_ps(tvy, py)), _mm256_mul_ps(tvz, pz)), invDet);
+
+                __m256 qx = _mm256_sub_ps(_mm256_mul_ps(tvy, e1z), _mm256_mul_ps(tvz, e1y));
+                __m256 qy = _mm256_sub_ps(_mm256_mul_ps(tvz, e1x), _mm256_mul_ps(tvx, e1z));
+                __m256 qz = _mm256_sub_ps(_mm256_mul_ps(tvx, e1y), _mm256_mul_ps(tvy, e1x));
+
+                __m256 v = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx[r], qx), _mm256_mul_ps(dy[r], qy)), _mm256_mul_ps(dz[r], qz)), invDet);
+                __m256 t = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e2x, qx), _mm256_mul_ps(e2y, qy)), _mm256_mul_ps(e2z, qz)), invDet);
+
+                __m256 reject = _mm256_and_ps(_mm256_cmp_ps(det, negEps, _CMP_GT_OQ), _mm256_cmp_ps(det, eps, _CMP_LT_OQ));
+                reject = _mm256_or_ps(reject, _mm256_or_ps(_mm256_cmp_ps(u, zero, _CMP_LT_OQ), _mm256_cmp_ps(u, one, _CMP_GT_OQ)));
+                reject = _mm256_or_ps(reject, _mm256_or_ps(_mm256_cmp_ps(v, zero, _CMP_LT_OQ), _mm256_cmp_ps(_mm256_add_ps(u, v), one, _CMP_GT_OQ)));
+                __m256 hit = _mm256_andnot_ps(reject, _mm256_cmp_ps(t, eps, _CMP_GT_OQ));
+
+                __m256 take = _mm256_and_ps(hit, _mm256_or_ps(_mm256_cmp_ps(t, bestT[r], _CMP_LT_OQ), _mm256_andnot_ps(laneHit[r], hit)));
+                bestT[r] = _mm256_blendv_ps(bestT[r], t, take);
+                bestI[r] = _mm256_blendv_ps(bestI[r], indexF, take);
+                laneHit[r] = _mm256_or_ps(laneHit[r], hit);
+            }
+
+            index = _mm256_add_epi32(index, step);
+        }
+
+        for (int r = 0; r < rayCount; r++) {
+            alignas(32) float t[8];
+            alignas(32) int idx[8];
+            _mm256_store_ps(t, bestT[r]);
+            _mm256_store_si256((__m256i*)idx, _mm256_castps_si256(bestI[r]));
+            int mask = _mm256_movemask_ps(laneHit[r]);
+            for (int l = 0; l < 8; l++) {
+                if (mask & (1 << l)) keepBest(best[r], t[l], idx[l]);
+            }
+        }
+    }
+
+    // --- AVX-512: 16 triangles per step ---
+    RAYMESH_TARGET("avx512f")
+    void kernelAVX512(const SoaView& tri, const Ray* rays, int rayCount, RayMesh::Best* best) {
+        const __m512 eps = _mm512_set1_ps(kEpsilon);
+        const __m512 negEps = _mm512_set1_ps(-kEpsilon);
+        const __m512 zero = _mm512_setzero_ps();
+        const __m512 one = _mm512_set1_ps(1.0f);
+
+        __m512 ox[RayMesh::maxPacket], oy[RayMesh::maxPacket], oz[RayMesh::maxPacket];
+        __m512 dx[RayMesh::maxPacket], dy[RayMesh::maxPacket], dz[RayMesh::maxPacket];
+        __m512 bestT[RayMesh::maxPacket];
+        __m512i bestI[RayMesh::maxPacket];
+        __mmask16 laneHit[RayMesh::maxPacket];
+
+        for (int r = 0; r < rayCount; r++) {
+            ox[r] = _mm512_set1_ps(rays[r].position.x);
+            oy[r] = _mm512_set1_ps(rays[r].position.y);
+            oz[r] = _mm512_set1_ps(rays[r].position.z);
+            dx[r] = _mm512_set1_ps(rays[r].direction.x);
+            dy[r] = _mm512_set1_ps(rays[r].direction.y);
+            dz[r] = _mm512_set1_ps(rays[r].direction.z);
+            bestT[r] = zero;
+            bestI[r] = _mm512_setzero_si512();
+            laneHit[r] = 0;
+        }
+
+        __m512i index = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        const __m512i step = _mm512_set1_epi32(16);
+
+        for (int i = 0; i < tri.count; i += 16) {
+            const __m512 e1x = _mm512_loadu_ps(tri.e1x + i), e1y = _mm512_loadu_ps(tri.e1y + i), e1z = _mm512_loadu_ps(tri.e1z + i);
+            const __m512 e2x = _mm512_loadu_ps(tri.e2x + i), e2y = _mm512_loadu_ps(tri.e2y + i), e2z = _mm512_loadu_ps(tri.e2z + i);
+            const __m512 p1x = _mm512_loadu_ps(tri.p1x + i), p1y = _mm512_loadu_ps(tri.p1y + i), p1z = _mm512_loadu_ps(tri.p1z + i);
+
+            for (int r = 0; r < rayCount; r++) {
+                __m512 px = _mm512_sub_ps(_mm512_mul_ps(dy[r], e2z), _mm512_mul_ps(dz[r], e2y));
+                __m512 py = _mm512_sub_ps(_mm512_mul_ps(dz[r], e2x), _mm512_mul_ps(dx[r], e2z));
+                __m512 pz = _mm512_sub_ps(_mm512_mul_ps(dx[r], e2y), _mm512_mul_ps(dy[r], e2x));
+
+                __m512 det = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(e1x, px), _mm512_mul_ps(e1y, py)), _mm512_mul_ps(e1z, pz));
+                __m512 invDet = _mm512_div_ps(one, det);
+
+                __m512 tvx = _mm512_sub_ps(ox[r], p1x);
+                __m512 tvy = _mm512_sub_ps(oy[r], p1y);
+                __m512 tvz = _mm512_sub_ps(oz[r], p1z);
+
+                __m512 u = _mm512_mul_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(tvx, px), _mm512_mul_ps(tvy, py)), _mm512_mul_ps(tvz, pz)), invDet);
+
+                __m512 qx = _mm512_sub_ps(_mm512_mul_ps(tvy, e1z), _mm512_mul_ps(tvz, e1y));
+                __m512 qy = _mm512_sub_ps(_mm512_mul_ps(tvz, e1x), _mm512_mul_ps(tvx, e1z));
+                __m512 qz = _mm512_sub_ps(_mm512_mul_ps(tvx, e1y), _mm512_mul_ps(tvy, e1x));
+
+                __m512 v = _mm512_mul_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(dx[r], qx), _mm512_mul_ps(dy[r], qy)), _mm512_mul_ps(dz[r], qz)), invDet);
+                __m512 t = _mm512_mul_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(e2x, qx), _mm512_mul_ps(e2y, qy)), _mm512_mul_ps(e2z, qz)), invDet);
+
+                __mmask16 reject = _mm512_cmp_ps_mask(det, negEps, _CMP_GT_OQ) & _mm512_cmp_ps_mask(det, eps, _CMP_LT_OQ);
+                reject |= _mm512_cmp_ps_mask(u, zero, _CMP_LT_OQ) | _mm512_cmp_ps_mask(u, one, _CMP_GT_OQ);
+                reject |= _mm512_cmp_ps_mask(v, zero, _CMP_LT_OQ) | _mm512_cmp_ps_mask(_mm512_add_ps(u, v), one, _CMP_GT_OQ);
+                __mmask16 hit = _mm512_cmp_ps_mask(t, eps, _CMP_GT_OQ) & (__mmask16)~reject;
+
+                __mmask16 take = hit & (_mm512_cmp_ps_mask(t, bestT[r], _CMP_LT_OQ) | (__mmask16)~laneHit[r]);
+                bestT[r] = _mm512_mask_mov_ps(bestT[r], take, t);
+                bestI[r] = _mm512_mask_mov_epi32(bestI[r], take, index);
+                laneHit[r] |= hit;
+            }
+
+            index = _mm512_add_epi32(index, step);
+        }
+
+        for (int r = 0; r < rayCount; r++) {
+            alignas(64) float t[16];
+            alignas(64) int idx[16];
+            _mm512_store_ps(t, bestT[r]);
+            _mm512_store_si512(idx, bestI[r]);
+            for (int l = 0; l < 16; l++) {
+                if (laneHit[r] & (1 << l)) keepBest(best[r], t[l], idx[l]);
+            }
+        }
+    }
+#endif
+}
+
+void RayMesh::build(const Mesh& mesh, const Matrix& transform) {
+    clear();
+    if (mesh.vertices == NULL || mesh.triangleCount <= 0) return;
+
+    triangleCount = mesh.triangleCount;
+    paddedCount = (triangleCount + 15) & ~15;
+
+    std::vector<float>* arrays[9] = { &p1x, &p1y, &p1z, &e1x, &e1y, &e1z, &e2x, &e2y, &e2z };
+    for (std::vector<float>* a : arrays) a->assign(paddedCount, 0.0f);
+
+    const Vector3* vertdata = (const Vector3*)mesh.vertices;
+    for (int i = 0; i < triangleCount; i++) {
+        Vector3 a, b, c;
+        if (mesh.indices) {
+            a = vertdata[mesh.indices[i*3 + 0]];
+            b = vertdata[mesh.indices[i*3 + 1]];
+            c = vertdata[mesh.indices[i*3 + 2]];
+        } else {
+            a = vertdata[i*3 + 0];
+            b = vertdata[i*3 + 1];
+            c = vertdata[i*3 + 2];
+        }
+
+        // Same transform and edge maths raylib does per query, just done once
+        a = Vector3Transform(a, transform);
+        b = Vector3Transform(b, transform);
+        c = Vector3Transform(c, transform);
+
+        Vector3 edge1 = Vector3Subtract(b, a);
+        Vector3 edge2 = Vector3Subtract(c, a);
+
+        p1x[i] = a.x;     p1y[i] = a.y;     p1z[i] = a.z;
+        e1x[i] = edge1.x; e1y[i] = edge1.y; e1z[i] = edge1.z;
+        e2x[i] = edge2.x; e2y[i] = edge2.y; e2z[i] = edge2.z;
+    }
+}
+
+void RayMesh::clear() {
+    std::vector<float>* arrays[9] = { &p1x, &p1y, &p1z, &e1x, &e1y, &e1z, &e2x, &e2y, &e2z };
+    for (std::vector<float>* a : arrays) {
+        a->clear();
+        a->shrink_to_fit();
+    }
+    triangleCount = 0;
+    paddedCount = 0;
+}
+
+RayMesh::Isa RayMesh::detectIsa() {
+#if defined(RAYMESH_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return Isa::AVX512;
+    if (__builtin_cpu_supports("avx2")) return Isa::AVX2;
+    if (__builtin_cpu_supports("sse2")) return Isa::SSE;
+    return Isa::Scalar;
+#elif defined(RAYMESH_SSE_ONLY)
+    return Isa::SSE;
+#else
+    return Isa::Scalar;
+#endif
+}
+
+void RayMesh::setIsa(Isa wanted) {
+    Isa available = detectIsa();
+    isa = ((int)wanted <= (int)available) ? wanted : available;
+}
+
+const char* RayMesh::isaName(Isa isa) {
+    switch (isa) {
+        case Isa::SSE:    return "SSE (4-wide)";
+        case Isa::AVX2:   return "AVX2 (8-wide)";
+        case Isa::AVX512: return "AVX-512 (16-wide)";
+        default:          return "scalar";
+    }
+}
+
+RayCollision RayMesh::finish(const Ray& ray, const Best& best) const {
+    RayCollision collision = {};
+    if (!best.hit) return collision;
+
+    // Rebuild the winner the way GetRayCollisionTriangle fills it in
+    int i = best.index;
+    Vector3 edge1 = { e1x[i], e1y[i], e1z[i] };
+    Vector3 edge2 = { e2x[i], e2y[i], e2z[i] };
+
+    collision.hit = true;
+    collision.distance = best.t;
+    collision.normal = Vector3Normalize(Vector3CrossProduct(edge1, edge2));
+    collision.point = Vector3Add(ray.position, Vector3Scale(ray.direction, best.t));
+    return collision;
+}
+
+RayCollision RayMesh::cast(Ray ray) const {
+    RayCollision result;
+    castPacket(&ray, 1, &result);
+    return result;
+}
+
+void RayMesh::castPacket(const Ray* rays, int count, RayCollision* results) const {
+    SoaView view = {
+        p1x.data(), p1y.data(), p1z.data(),
+        e1x.data(), e1y.data(), e1z.data(),
+        e2x.data(), e2y.data(), e2z.data(),
+        paddedCount
+    };
+
+    for (int start = 0; start < count; start += maxPacket) {
+        int n = (count - start < maxPacket) ? count - start : maxPacket;
+        const Ray* packet = rays + start;
+
+        Best best[maxPacket];
+        for (int r = 0; r < n; r++) best[r] = { false, 0.0f, 0 };
+
+        if (paddedCount > 0) {
+            switch (isa) {
+#if defined(RAYMESH_X86)
+                case Isa::AVX512: kernelAVX512(view, packet, n, best); break;
+                case Isa::AVX2:   kernelAVX2(view, packet, n, best); break;
+#endif
+#if defined(RAYMESH_X86) || defined(RAYMESH_SSE_ONLY)
+                case Isa::SSE:    kernelSSE(view, packet, n, best); break;
+#endif
+                default:
+                    // Padding triangles are degenerate, so the scalar loop can skip them
+                    view.count = triangleCount;
+                    kernelScalar(view, packet, n, best);
+                    view.count = paddedCount;
+                    break;
+            }
+        }
+
+        for (int r = 0; r < n; r++) results[start + r] = finish(packet[r], best[r]);
+    }
+}
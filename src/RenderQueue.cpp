@@ -0,0 +1,251 @@
+#include "RenderQueue.hpp"
+#include "raymath.h"
+#include "rlgl.h"
+#include <algorithm>
+
+namespace {
+    // Anything further than this just shares the last depth bucket
+    const float maxSortDistance = 2048.0f;
+
+    const uint32_t depthBits = 22;
+    const uint32_t meshBits = 12;
+    const uint32_t textureBits = 12;
+    const uint32_t materialBits = 8;
+    const uint32_t shaderBits = 8;
+
+    uint64_t mask(uint32_t value, uint32_t bits) {
+        return (uint64_t)(value & ((1u << bits) - 1u));
+    }
+
+    // Material maps DIFFUSE through BRDF, one texture unit each (as DrawMesh does)
+    const int textureSlots = MATERIAL_MAP_BRDF + 1;
+
+    bool isCubemap(int slot) {
+        return slot == MATERIAL_MAP_CUBEMAP || slot == MATERIAL_MAP_IRRADIANCE || slot == MATERIAL_MAP_PREFILTER;
+    }
+
+    // What execute() has left bound, zeros where it hasn't bound anything
+    struct BoundState {
+        unsigned int shader = 0;
+        const Material* material = nullptr;     // Whose colours/samplers the program holds
+        unsigned int textures[textureSlots] = {};
+        unsigned int vao = 0;
+    };
+
+    // Hand GL back the way DrawMesh leaves it, before rlgl's batch or
+    // DrawMesh itself touch anything
+    void release(BoundState& bound) {
+        bool anyTexture = false;
+        for (int slot = 0; slot < textureSlots; slot++) {
+            if (bound.textures[slot] == 0) continue;
+            rlActiveTextureSlot(slot);
+            if (isCubemap(slot)) rlDisableTextureCubemap();
+            else rlDisableTexture();
+            anyTexture = true;
+        }
+        if (anyTexture) rlActiveTextureSlot(0);
+        if (bound.vao != 0) rlDisableVertexArray();
+        if (bound.shader != 0) rlDisableShader();
+        bound = BoundState{};
+    }
+
+    void setColor(int location, Color color) {
+        if (location == -1) return;
+        float values[4] = { color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f };
+        rlSetUniform(location, values, SHADER_UNIFORM_VEC4, 1);
+    }
+}
+
+RenderQueue::RenderQueue() {
+    // Enough for the fences, trees and ball without growing mid-frame,
+    // and every material id the sort key can hold
+    packets.reserve(1024);
+    materialIds.reserve(1u << materialBits);
+}
+
+void RenderQueue::reserve(size_t packetCount) {
+    packets.reserve(packetCount);
+}
+
+uint64_t RenderQueue::makeKey(RenderLayer layer, uint32_t shader, uint32_t material,
+                              uint32_t texture, uint32_t mesh, float depth) {
+    float d = Clamp(depth, 0.0f, 1.0f);
+    uint32_t depthKey = (uint32_t)(d * (float)((1u << depthBits) - 1u));
+
+    uint64_t key = 0;
+    key |= mask((uint32_t)layer, 2) << 62;
+    key |= mask(shader, shaderBits) << 54;
+    key |= mask(material, materialBits) << 46;
+    key |= mask(texture, textureBits) << 34;
+    key |= mask(mesh, meshBits) << 22;
+    key |= mask(depthKey, depthBits);
+    return key;
+}
+
+void RenderQueue::begin(Vector3 cameraPosition) {
+    packets.clear();
+    viewPosition = cameraPosition;
+}
+
+uint32_t RenderQueue::getMaterialId(const Material* material) {
+    // Only a handful of materials exist, a linear scan beats hashing here
+    for (size_t i = 0; i < materialIds.size(); i++) {
+        if (materialIds[i] == material) return (uint32_t)i;
+    }
+    materialIds.push_back(material);
+    return (uint32_t)(materialIds.size() - 1);
+}
+
+float RenderQueue::getDepth(const Matrix& world) const {
+    // Translation lives in the last column of raylib's matrix
+    Vector3 origin = { world.m12, world.m13, world.m14 };
+    return Vector3Distance(origin, viewPosition) / maxSortDistance;
+}
+
+void RenderQueue::submitMesh(const Mesh& mesh, const Material& material, const Matrix& world, RenderLayer layer) {
+    DrawPacket p = {};
+    p.type = PacketType::Mesh;
+    p.mesh = &mesh;
+    p.material = &material;
+    p.transform = world;
+    p.sortKey = makeKey(layer, material.shader.id, getMaterialId(&material),
+                        material.maps[MATERIAL_MAP_DIFFUSE].texture.id, mesh.vaoId, getDepth(world));
+    packets.push_back(p);
+}
+
+void RenderQueue::submitModel(const Model& model, const Matrix& world, RenderLayer layer) {
+    // Same math DrawModelEx does: the model's own transform goes first
+    Matrix transform = MatrixMultiply(model.transform, world);
+
+    for (int i = 0; i < model.meshCount; i++) {
+        submitMesh(model.meshes[i], model.materials[model.meshMaterial[i]], transform, layer);
+    }
+}
+
+void RenderQueue::submitSphereWires(Vector3 center, float radius, Color color) {
+    DrawPacket p = {};
+    p.type = PacketType::SphereWires;
+    p.center = center;
+    p.radius = radius;
+    p.color = color;
+
+    Matrix world = MatrixTranslate(center.x, center.y, center.z);
+    p.sortKey = makeKey(RenderLayer::Debug, 0, 0, 0, 0, getDepth(world));
+    packets.push_back(p);
+}
+
+void RenderQueue::submitCube(Vector3 center, Vector3 size, Color color) {
+    DrawPacket p = {};
+    p.type = PacketType::Cube;
+    p.center = center;
+    p.size = size;
+    p.color = color;
+
+    // Shader/material/texture 0 keeps every cube next to each other in the sort
+    Matrix world = MatrixTranslate(center.x, center.y, center.z);
+    p.sortKey = makeKey(RenderLayer::Opaque, 0, 0, 0, 0, getDepth(world));
+    packets.push_back(p);
+}
+
+void RenderQueue::execute() {
+    stats = RenderStats{};
+
+    std::sort(packets.begin(), packets.end(), [](const DrawPacket& a, const DrawPacket& b) {
+        return a.sortKey < b.sortKey;
+    });
+
+    // 1. Matrices that hold for the whole pass (BeginMode3D set them up).
+    // Stereo needs two MVPs per draw, which is DrawMesh's business.
+    const bool direct = !rlIsStereoRenderEnabled();
+    Matrix view = rlGetMatrixModelview();
+    Matrix projection = rlGetMatrixProjection();
+    Matrix outer = rlGetMatrixTransform();
+    Matrix viewProjection = MatrixMultiply(view, projection);
+
+    BoundState bound;
+
+    for (const DrawPacket& p : packets) {
+        // Immediate-mode packets go through rlgl's batch, which binds its own
+        // state whenever it flushes
+        if (p.type == PacketType::SphereWires) {
+            release(bound);
+            DrawSphereWires(p.center, p.radius, 10, 10, p.color);
+            continue;
+        }
+
+        if (p.type == PacketType::Cube) {
+            release(bound);
+            DrawCubeV(p.center, p.size, p.color);
+            continue;
+        }
+
+        const Mesh& mesh = *p.mesh;
+        const Material& material = *p.material;
+        stats.drawCalls++;
+        stats.triangles += mesh.triangleCount;
+
+        // Meshes without a VAO need DrawMesh's per-buffer attribute setup
+        if (!direct || mesh.vaoId == 0) {
+            release(bound);
+            DrawMesh(mesh, material, p.transform);
+            continue;
+        }
+
+        // 2. Program, plus the uniforms that are the same for every draw
+        // with it. Sorting puts each shader's packets together, so this is
+        // once per shader per frame.
+        const int* locs = material.shader.locs;
+        if (material.shader.id != bound.shader) {
+            rlEnableShader(material.shader.id);
+            bound.shader = material.shader.id;
+            bound.material = nullptr;
+            stats.shaderBinds++;
+
+            if (locs[SHADER_LOC_MATRIX_VIEW] != -1) rlSetUniformMatrix(locs[SHADER_LOC_MATRIX_VIEW], view);
+            if (locs[SHADER_LOC_MATRIX_PROJECTION] != -1) rlSetUniformMatrix(locs[SHADER_LOC_MATRIX_PROJECTION], projection);
+        }
+
+        // 3. Material colours and sampler units live in the program, so they
+        // only need setting when the material changes. Texture units keep
+        // their textures across programs, so those only rebind when a slot
+        // really gets a different texture. Slots a material leaves empty keep
+        // what they had; no shader samples a map its material doesn't set.
+        if (&material != bound.material) {
+            bound.material = &material;
+            setColor(locs[SHADER_LOC_COLOR_DIFFUSE], material.maps[MATERIAL_MAP_DIFFUSE].color);
+            setColor(locs[SHADER_LOC_COLOR_SPECULAR], material.maps[MATERIAL_MAP_SPECULAR].color);
+
+            for (int slot = 0; slot < textureSlots; slot++) {
+                unsigned int texture = material.maps[slot].texture.id;
+                if (texture == 0) continue;
+
+                if (texture != bound.textures[slot]) {
+                    rlActiveTextureSlot(slot);
+                    if (isCubemap(slot)) rlEnableTextureCubemap(texture);
+                    else rlEnableTexture(texture);
+                    bound.textures[slot] = texture;
+                    stats.textureBinds++;
+                }
+                rlSetUniform(locs[SHADER_LOC_MAP_DIFFUSE + slot], &slot, SHADER_UNIFORM_INT, 1);
+            }
+        }
+
+        // 4. Vertex array
+        if (mesh.vaoId != bound.vao) {
+            rlEnableVertexArray(mesh.vaoId);
+            bound.vao = mesh.vaoId;
+            stats.meshBinds++;
+        }
+
+        // 5. The only per-draw uniforms: where this mesh is
+        Matrix model = MatrixMultiply(p.transform, outer);
+        if (locs[SHADER_LOC_MATRIX_MODEL] != -1) rlSetUniformMatrix(locs[SHADER_LOC_MATRIX_MODEL], p.transform);
+        if (locs[SHADER_LOC_MATRIX_NORMAL] != -1) rlSetUniformMatrix(locs[SHADER_LOC_MATRIX_NORMAL], MatrixTranspose(MatrixInvert(model)));
+        rlSetUniformMatrix(locs[SHADER_LOC_MATRIX_MVP], MatrixMultiply(model, viewProjection));
+
+        if (mesh.indices != nullptr) rlDrawVertexArrayElements(0, mesh.triangleCount * 3, nullptr);
+        else rlDrawVertexArray(0, mesh.vertexCount);
+    }
+
+    release(bound);
+}
@@ -0,0 +1,204 @@
+#include "Scatter.hpp"
+#include "raymath.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // splitmix64: tiny, fast and bit-identical everywhere, one stream per tile
+    struct Random {
+        uint64_t state;
+
+        uint64_t next() {
+            uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+
+        // [0, 1) from the top 24 bits, exact in a float
+        float uniform() { return (float)(next() >> 40) * (1.0f / 16777216.0f); }
+    };
+
+    inline uint64_t mix(uint64_t a, uint64_t b) {
+        Random r = { a ^ (b * 0xD6E8FEB86659FD93ull) };
+        return r.next();
+    }
+
+    inline uint64_t pack(int x, int z) {
+        return ((uint64_t)(uint32_t)z << 32) | (uint32_t)x;
+    }
+}
+
+int Scatter::addSpecies(const Species& species) {
+    Layer layer;
+    layer.species = species;
+    layers.push_back(layer);
+    return (int)layers.size() - 1;
+}
+
+void Scatter::addExclusion(Vector2 center, float radius) {
+    exclusions.push_back({ center, radius });
+}
+
+void Scatter::clear() {
+    layers.clear();
+    exclusions.clear();
+}
+
+void Scatter::run(const TerrainCollider& terrain, Rectangle newArea, JobSystem& jobs, std::vector<Instance>& out) {
+    area = newArea;
+    out.clear();
+    if (!terrain.isBuilt() || area.width <= 0.0f || area.height <= 0.0f) return;
+
+    for (int l = 0; l < (int)layers.size(); l++) {
+        Layer& layer = layers[l];
+
+        // 1. Grid cells spacing / sqrt(2) wide hold one instance at most. Tiles
+        // are at least a spacing wide, so a query never reaches past the 8
+        // tiles around its own.
+        layer.cellSize = layer.species.spacing * 0.70710678f;
+        layer.cellsPerTile = std::max(2, (int)ceilf(settings.tileSize / layer.cellSize));
+        float tileSize = layer.cellSize * layer.cellsPerTile;
+
+        int tilesX = std::max(1, (int)ceilf(area.width / tileSize));
+        int tilesZ = std::max(1, (int)ceilf(area.height / tileSize));
+        layer.cellsX = tilesX * layer.cellsPerTile;
+        layer.cellsZ = tilesZ * layer.cellsPerTile;
+        layer.cells.assign((size_t)layer.cellsX * layer.cellsZ, -1);
+        layer.tiles.assign((size_t)tilesX * tilesZ, std::vector<Instance>());
+
+        // 2. Checkerboard phases. Same-phase tiles are two apart, so the ones
+        // running together only share neighbours that are already finished.
+        for (int phase = 0; phase < 4; phase++) {
+            int phaseX = phase & 1;
+            int phaseZ = phase >> 1;
+            int countX = (tilesX - phaseX + 1) / 2;
+            int countZ = (tilesZ - phaseZ + 1) / 2;
+
+            jobs.parallelFor(countX * countZ, 4, [&](int begin, int end) {
+                for (int i = begin; i < end; i++) {
+                    scatterTile(l, phaseX + 2 * (i % countX), phaseZ + 2 * (i / countX), terrain);
+                }
+            });
+        }
+
+        // 3. Gather in tile order, which doesn't depend on who ran what
+        for (const std::vector<Instance>& tile : layer.tiles) out.insert(out.end(), tile.begin(), tile.end());
+    }
+}
+
+void Scatter::scatterTile(int layerIndex, int tileX, int tileZ, const TerrainCollider& terrain) {
+    Layer& layer = layers[layerIndex];
+    const Species& species = layer.species;
+    const int tilesX = layer.cellsX / layer.cellsPerTile;
+    const float tileSize = layer.cellSize * layer.cellsPerTile;
+    std::vector<Instance>& placed = layer.tiles[tileZ * tilesX + tileX];
+
+    float tileMinX = area.x + tileX * tileSize;
+    float tileMinZ = area.y + tileZ * tileSize;
+    int darts = (int)ceilf(species.attempts * tileSize * tileSize / (species.spacing * species.spacing));
+
+    Random random = { mix(mix(settings.seed, (uint64_t)layerIndex), pack(tileX, tileZ)) };
+
+    for (int d = 0; d < darts; d++) {
+        // Every dart draws all its numbers, so a rejection doesn't shift the rest
+        float fx = random.uniform();
+        float fz = random.uniform();
+        float keep = random.uniform();
+        float scale = Lerp(species.minScale, species.maxScale, random.uniform());
+        float yaw = random.uniform() * 360.0f;
+
+        float x = tileMinX + fx * tileSize;
+        float z = tileMinZ + fz * tileSize;
+
+        // 1. Cheap rules first: inside the area, outside exclusions, density
+        if (x >= area.x + area.width || z >= area.y + area.height) continue;
+
+        bool excluded = false;
+        for (const Exclusion& e : exclusions) {
+            float dx = x - e.center.x, dz = z - e.center.y;
+            if (dx * dx + dz * dz < e.radius * e.radius) {
+                excluded = true;
+                break;
+            }
+        }
+        if (excluded) continue;
+
+        float density = species.density;
+        if (species.patchSize > 0.0f) density *= patchNoise(layerIndex, x, z);
+        if (keep >= density) continue;
+
+        // 2. Poisson-disk test against this species and earlier footprints
+        if (!isClear(layerIndex, x, z)) continue;
+
+        // 3. Ground rules last, they're the expensive part
+        float height;
+        Vector3 normal;
+        if (!terrain.sampleSurface(x, z, height, normal)) continue;
+        if (normal.y < species.slopeLimit) continue;
+        if (height < species.minHeight || height > species.maxHeight) continue;
+
+        // Same rounding as isClear(), kept inside this tile's own cells
+        int firstX = tileX * layer.cellsPerTile, firstZ = tileZ * layer.cellsPerTile;
+        int cx = std::clamp((int)floorf((x - area.x) / layer.cellSize), firstX, firstX + layer.cellsPerTile - 1);
+        int cz = std::clamp((int)floorf((z - area.y) / layer.cellSize), firstZ, firstZ + layer.cellsPerTile - 1);
+        layer.cells[cz * layer.cellsX + cx] = (int32_t)placed.size();
+        placed.push_back({ { x, height, z }, normal, scale, yaw, layerIndex });
+    }
+}
+
+bool Scatter::isClear(int layerIndex, float x, float z) const {
+    const float ownFootprint = layers[layerIndex].species.footprint;
+
+    for (int l = 0; l <= layerIndex; l++) {
+        const Layer& layer = layers[l];
+        const int tilesX = layer.cellsX / layer.cellsPerTile;
+
+        // Same species keeps its spacing, earlier ones keep both footprints apart
+        float radius = (l == layerIndex) ? layer.species.spacing : layer.species.footprint + ownFootprint;
+
+        int x0 = std::max(0, (int)floorf((x - radius - area.x) / layer.cellSize));
+        int x1 = std::min(layer.cellsX - 1, (int)floorf((x + radius - area.x) / layer.cellSize));
+        int z0 = std::max(0, (int)floorf((z - radius - area.y) / layer.cellSize));
+        int z1 = std::min(layer.cellsZ - 1, (int)floorf((z + radius - area.y) / layer.cellSize));
+
+        for (int cz = z0; cz <= z1; cz++) {
+            for (int cx = x0; cx <= x1; cx++) {
+                int32_t index = layer.cells[cz * layer.cellsX + cx];
+                if (index < 0) continue;
+
+                int tile = (cz / layer.cellsPerTile) * tilesX + cx / layer.cellsPerTile;
+                Vector3 p = layer.tiles[tile][index].position;
+                float dx = p.x - x, dz = p.z - z;
+                if (dx * dx + dz * dz < radius * radius) return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Smooth value noise in 0..1 on a lattice patchSize apart, so a species grows
+// in patches and clearings instead of evenly everywhere
+float Scatter::patchNoise(int layerIndex, float x, float z) const {
+    float size = layers[layerIndex].species.patchSize;
+    float gx = (x - area.x) / size;
+    float gz = (z - area.y) / size;
+    int ix = (int)floorf(gx);
+    int iz = (int)floorf(gz);
+    float tx = gx - ix;
+    float tz = gz - iz;
+
+    uint64_t base = mix(mix(settings.seed, (uint64_t)layerIndex), 0x5EEDull);
+    auto corner = [base](int cx, int cz) {
+        Random r = { mix(base, pack(cx, cz)) };
+        return r.uniform();
+    };
+
+    // Smoothstep weights, no creases along the lattice lines
+    tx = tx * tx * (3.0f - 2.0f * tx);
+    tz = tz * tz * (3.0f - 2.0f * tz);
+
+    float top = Lerp(corner(ix, iz), corner(ix + 1, iz), tx);
+    float bottom = Lerp(corner(ix, iz + 1), corner(ix + 1, iz + 1), tx);
+    return Lerp(top, bottom, tz);
+}
@@ -0,0 +1,294 @@
+#include "ShaderCache.hpp"
+#include "GLExt.hpp"
+#include "PackArchive.hpp"
+#include "rlgl.h"
+#include <chrono>
+#include <cstdio>
+
+namespace {
+    // Bump when the entry layout or what goes into the key changes
+    const uint32_t kShaderCacheVersion = 1;
+
+    const char* kDefaultVertexShader = "assets/shaders/model.vs";
+    const char* kDefaultFragmentShader = "assets/shaders/model.fs";
+
+    // From the asset pack if it's mounted, like everything else
+    bool readText(const std::string& path, std::string& out) {
+        std::vector<uint8_t> bytes;
+        if (!PackArchive::readFile(path.c_str(), bytes)) return false;
+        out.assign(bytes.begin(), bytes.end());
+        return true;
+    }
+
+    // The defines have to come after #version, which must be the first line
+    void insertDefines(std::string& source, const std::vector<std::string>& defines) {
+        std::string block;
+        for (const std::string& define : defines) block += "#define " + define + "\n";
+
+        size_t lineEnd = source.find('\n');
+        source.insert(lineEnd == std::string::npos ? source.size() : lineEnd + 1, block);
+    }
+
+    // Which driver compiled it: a binary is only good for the exact same one
+    uint64_t driverKey() {
+        uint64_t key = AssetCache::hash(&kShaderCacheVersion, sizeof(kShaderCacheVersion));
+        const unsigned int names[] = { GLExt::VENDOR, GLExt::RENDERER, GLExt::VERSION };
+        for (unsigned int name : names) {
+            const char* value = GLExt::getString ? (const char*)GLExt::getString(name) : nullptr;
+            std::string text = value ? value : "";
+            key = AssetCache::hash(text.data(), text.size() + 1, key);
+        }
+        return key;
+    }
+
+    // Same locations LoadShaderFromMemory() looks up, so the result works
+    // anywhere a raylib Shader does
+    Shader wrapProgram(unsigned int program) {
+        Shader shader = { program, (int*)RL_CALLOC(RL_MAX_SHADER_LOCATIONS, sizeof(int)) };
+        for (int i = 0; i < RL_MAX_SHADER_LOCATIONS; i++) shader.locs[i] = -1;
+
+        shader.locs[SHADER_LOC_VERTEX_POSITION] = rlGetLocationAttrib(program, RL_DEFAULT_SHADER_ATTRIB_NAME_POSITION);
+        shader.locs[SHADER_LOC_VERTEX_TEXCOORD01] = rlGetLocationAttrib(program, RL_DEFAULT_SHADER_ATTRIB_NAME_TEXCOORD);
+        shader.locs[SHADER_LOC_VERTEX_TEXCOORD02] = rlGetLocationAttrib(program, RL_DEFAULT_SHADER_ATTRIB_NAME_TEXCOORD2);
+        shader.locs[SHADER_LOC_VERTEX_NORMAL] = rlGetLocationAttrib(program, RL_DEFAULT_SHADER_ATTRIB_NAME_NORMAL);
+        shader.locs[SHADER_LOC_VERTEX_TANGENT] = rlGetLocationAttrib(program, RL_DEFAULT_SHADER_ATTRIB_NAME_TANGENT);
+        shader.locs[SHADER_LOC_VERTEX_COLOR] = rlGetLocationAttrib(program, RL_DEFAULT_SHADER_ATTRIB_NAME_COLOR);
+
+        shader.locs[SHADER_LOC_MATRIX_MVP] = rlGetLocationUniform(program, RL_DEFAULT_SHADER_UNIFORM_NAME_MVP);
+        shader.locs[SHADER_LOC_MATRIX_VIEW] = rlGetLocationUniform(program, RL_DEFAULT_SHADER_UNIFORM_NAME_VIEW);
+        shader.locs[SHADER_LOC_MATRIX_PROJECTION] = rlGetLocationUniform(program, RL_DEFAULT_SHADER_UNIFORM_NAME_PROJECTION);
+        shader.locs[SHADER_LOC_MATRIX_MODEL] = rlGetLocationUniform(program, RL_DEFAULT_SHADER_UNIFORM_NAME_MODEL);
+        shader.locs[SHADER_LOC_MATRIX_NORMAL] = rlGetLocationUniform(program, RL_DEFAULT_SHADER_UNIFORM_NAME_NORMAL);
+
+        shader.locs[SHADER_LOC_COLOR_DIFFUSE] = rlGetLocationUniform(program, RL_DEFAULT_SHADER_UNIFORM_NAME_COLOR);
+        shader.locs[SHADER_LOC_MAP_DIFFUSE] = rlGetLocationUniform(program, RL_DEFAULT_SHADER_SAMPLER2D_NAME_TEXTURE0);
+        shader.locs[SHADER_LOC_MAP_SPECULAR] = rlGetLocationUniform(program, RL_DEFAULT_SHADER_SAMPLER2D_NAME_TEXTURE1);
+        shader.locs[SHADER_LOC_MAP_NORMAL] = rlGetLocationUniform(program, RL_DEFAULT_SHADER_SAMPLER2D_NAME_TEXTURE2);
+        return shader;
+    }
+
+    Shader defaultShader() {
+        return { rlGetShaderIdDefault(), rlGetShaderLocsDefault() };
+    }
+
+    void logInfo(unsigned int object, const char* what, const std::string& path, bool program) {
+        char message[1024] = {};
+        if (program) GLExt::getProgramInfoLog(object, sizeof(message), nullptr, message);
+        else GLExt::getShaderInfoLog(object, sizeof(message), nullptr, message);
+        TraceLog(LOG_WARNING, "SHADERS: %s failed for %s: %s", what, path.c_str(), message);
+    }
+}
+
+int ShaderCache::add(const char* vsPath, const char* fsPath, const std::vector<std::string>& defines) {
+    std::string vs = vsPath ? vsPath : kDefaultVertexShader;
+    std::string fs = fsPath ? fsPath : kDefaultFragmentShader;
+
+    for (int i = 0; i < (int)variants.size(); i++) {
+        if (variants[i].vsPath == vs && variants[i].fsPath == fs && variants[i].defines == defines) return i;
+    }
+
+    Variant v;
+    v.vsPath = vs;
+    v.fsPath = fs;
+    v.defines = defines;
+    variants.push_back(v);
+    return (int)variants.size() - 1;
+}
+
+void ShaderCache::build(JobSystem& jobs, const AssetCache& cache) {
+    auto start = std::chrono::steady_clock::now();
+    GLExt::load();
+
+    int first = 0;
+    while (first < (int)variants.size() && variants[first].built) first++;
+    int count = (int)variants.size() - first;
+    if (count == 0) return;
+
+    const bool rawGL = GLExt::hasShaderPrograms();
+    const bool useBinaries = GLExt::hasProgramBinaries();
+    const uint64_t driver = driverKey();
+
+    // 1. Read, specialise and hash the sources, and look for cached programs,
+    // all on the workers
+    jobs.parallelFor(count, 1, [&](int begin, int end) {
+        for (int i = begin; i < end; i++) prepare(variants[first + i], driver, cache, useBinaries);
+    });
+
+    // Let the driver spread compiles over as many threads as it likes
+    if (rawGL && GLExt::maxShaderCompilerThreads) GLExt::maxShaderCompilerThreads(0xFFFFFFFFu);
+
+    // 2. Cached programs first. What's left gets every compile queued, then
+    // every link, and only then are any results asked for, which is the
+    // first point the driver has to block.
+    std::vector<Variant*> pending;
+    for (int i = first; i < (int)variants.size(); i++) {
+        Variant& v = variants[i];
+        if (!rawGL) {
+            v.shader = LoadShaderFromMemory(v.vsSource.c_str(), v.fsSource.c_str());
+            if (v.shader.id == rlGetShaderIdDefault()) stats.failed++;
+            else stats.compiled++;
+            v.built = true;
+        } else if (loadBinary(v)) {
+            stats.cached++;
+            v.built = true;
+        } else {
+            startCompile(v);
+            pending.push_back(&v);
+        }
+    }
+    for (Variant* v : pending) startLink(*v, useBinaries);
+
+    // 3. Collect, and keep the new programs for next time
+    for (Variant* v : pending) {
+        if (finishLink(*v, cache, useBinaries)) stats.compiled++;
+        else stats.failed++;
+        v->built = true;
+    }
+
+    for (int i = first; i < (int)variants.size(); i++) {
+        Variant& v = variants[i];
+        v.vsSource = std::string();
+        v.fsSource = std::string();
+        v.binary = std::vector<uint8_t>();
+    }
+
+    stats.variants = (int)variants.size();
+    stats.milliseconds += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    TraceLog(LOG_INFO, "SHADERS: %d variants, %d from cache, %d compiled, %d failed, %.1f ms", stats.variants,
+             stats.cached, stats.compiled, stats.failed, stats.milliseconds);
+}
+
+Shader ShaderCache::get(int handle) {
+    Variant& v = variants[handle];
+    v.taken = true;
+    return v.shader;
+}
+
+void ShaderCache::releaseUnused() {
+    for (Variant& v : variants) {
+        if (!v.built || v.taken) continue;
+        if (v.shader.id != rlGetShaderIdDefault()) UnloadShader(v.shader);
+        v.shader = {};
+        v.taken = true;
+    }
+}
+
+// Worker side: no GL in here
+void ShaderCache::prepare(Variant& v, uint64_t driver, const AssetCache& cache, bool useBinaries) {
+    if (!readText(v.vsPath, v.vsSource)) TraceLog(LOG_WARNING, "SHADERS: Can't read %s", v.vsPath.c_str());
+    if (!readText(v.fsPath, v.fsSource)) TraceLog(LOG_WARNING, "SHADERS: Can't read %s", v.fsPath.c_str());
+    insertDefines(v.vsSource, v.defines);
+    insertDefines(v.fsSource, v.defines);
+
+    // Entry per variant, its key per exact text: editing a shader replaces
+    // the entry instead of piling up new ones
+    std::string name = v.vsPath + "|" + v.fsPath;
+    for (const std::string& define : v.defines) name += "|" + define;
+    char entry[32];
+    snprintf(entry, sizeof(entry), "shader-%016llx", (unsigned long long)AssetCache::hash(name.data(), name.size()));
+    v.entryName = entry;
+
+    v.key = AssetCache::hash(v.vsSource.data(), v.vsSource.size(), driver);
+    v.key = AssetCache::hash(v.fsSource.data(), v.fsSource.size(), v.key);
+
+    std::vector<uint8_t> bytes;
+    if (!useBinaries || !cache.load(v.entryName, v.key, bytes)) return;
+
+    CacheReader reader(bytes);
+    if (!reader.get(v.binaryFormat) || !reader.getArray(v.binary) || !reader.atEnd()) v.binary.clear();
+}
+
+// A binary the driver turns down (it was updated under the same version
+// string, say) just means compiling after all
+bool ShaderCache::loadBinary(Variant& v) {
+    if (v.binary.empty()) return false;
+
+    unsigned int program = GLExt::createProgram();
+    GLExt::programBinary(program, v.binaryFormat, v.binary.data(), (int)v.binary.size());
+
+    int linked = 0;
+    GLExt::getProgramiv(program, GLExt::LINK_STATUS, &linked);
+    if (!linked) {
+        GLExt::deleteProgram(program);
+        return false;
+    }
+
+    v.shader = wrapProgram(program);
+    return true;
+}
+
+void ShaderCache::startCompile(Variant& v) {
+    const char* vsText = v.vsSource.c_str();
+    const char* fsText = v.fsSource.c_str();
+
+    v.vs = GLExt::createShader(GLExt::VERTEX_SHADER);
+    GLExt::shaderSource(v.vs, 1, &vsText, nullptr);
+    GLExt::compileShader(v.vs);
+
+    v.fs = GLExt::createShader(GLExt::FRAGMENT_SHADER);
+    GLExt::shaderSource(v.fs, 1, &fsText, nullptr);
+    GLExt::compileShader(v.fs);
+}
+
+void ShaderCache::startLink(Variant& v, bool useBinaries) {
+    v.program = GLExt::createProgram();
+    GLExt::attachShader(v.program, v.vs);
+    GLExt::attachShader(v.program, v.fs);
+
+    // rlLoadShaderProgram() does the same, meshes upload to these slots
+    GLExt::bindAttribLocation(v.program, RL_DEFAULT_SHADER_ATTRIB_LOCATION_POSITION, RL_DEFAULT_SHADER_ATTRIB_NAME_POSITION);
+    GLExt::bindAttribLocation(v.program, RL_DEFAULT_SHADER_ATTRIB_LOCATION_TEXCOORD, RL_DEFAULT_SHADER_ATTRIB_NAME_TEXCOORD);
+    GLExt::bindAttribLocation(v.program, RL_DEFAULT_SHADER_ATTRIB_LOCATION_NORMAL, RL_DEFAULT_SHADER_ATTRIB_NAME_NORMAL);
+    GLExt::bindAttribLocation(v.program, RL_DEFAULT_SHADER_ATTRIB_LOCATION_COLOR, RL_DEFAULT_SHADER_ATTRIB_NAME_COLOR);
+    GLExt::bindAttribLocation(v.program, RL_DEFAULT_SHADER_ATTRIB_LOCATION_TANGENT, RL_DEFAULT_SHADER_ATTRIB_NAME_TANGENT);
+    GLExt::bindAttribLocation(v.program, RL_DEFAULT_SHADER_ATTRIB_LOCATION_TEXCOORD2, RL_DEFAULT_SHADER_ATTRIB_NAME_TEXCOORD2);
+
+    if (useBinaries) GLExt::programParameteri(v.program, GLExt::PROGRAM_BINARY_RETRIEVABLE_HINT, 1);
+    GLExt::linkProgram(v.program);
+}
+
+bool ShaderCache::finishLink(Variant& v, const AssetCache& cache, bool useBinaries) {
+    int linked = 0;
+    GLExt::getProgramiv(v.program, GLExt::LINK_STATUS, &linked);
+
+    if (!linked) {
+        // Most link failures are a stage that didn't compile, say which
+        int compiled = 0;
+        GLExt::getShaderiv(v.vs, GLExt::COMPILE_STATUS, &compiled);
+        if (!compiled) logInfo(v.vs, "Vertex shader", v.vsPath, false);
+        GLExt::getShaderiv(v.fs, GLExt::COMPILE_STATUS, &compiled);
+        if (!compiled) logInfo(v.fs, "Fragment shader", v.fsPath, false);
+        logInfo(v.program, "Link", v.vsPath + " + " + v.fsPath, true);
+    }
+
+    // The program keeps what it needs, the stages can go either way
+    GLExt::detachShader(v.program, v.vs);
+    GLExt::detachShader(v.program, v.fs);
+    GLExt::deleteShader(v.vs);
+    GLExt::deleteShader(v.fs);
+    v.vs = v.fs = 0;
+
+    if (!linked) {
+        GLExt::deleteProgram(v.program);
+        v.program = 0;
+        v.shader = defaultShader();
+        return false;
+    }
+
+    v.shader = wrapProgram(v.program);
+
+    int length = 0;
+    if (useBinaries) GLExt::getProgramiv(v.program, GLExt::PROGRAM_BINARY_LENGTH, &length);
+    if (length > 0) {
+        std::vector<uint8_t> binary((size_t)length);
+        uint32_t format = 0;
+        GLExt::getProgramBinary(v.program, length, &length, &format, binary.data());
+        binary.resize((size_t)length);
+
+        CacheWriter writer;
+        writer.put(format);
+        writer.putArray(binary);
+        if (!cache.store(v.entryName, v.key, writer.bytes)) TraceLog(LOG_WARNING, "SHADERS: Couldn't cache %s", v.entryName.c_str());
+    }
+    return true;
+}
@@ -0,0 +1,275 @@
+#include "TerrainGenerator.hpp"
+#include "Simd.hpp"
+#include "raymath.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+using simd::F4;
+
+namespace {
+    const int kMaxOctaves = 16;
+
+    // splitmix64, only used to turn the seed into per-octave lattice offsets
+    uint64_t splitmix(uint64_t x) {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    // Gustavson's permutation polynomial, (34x^2 + x) mod 289. Every value
+    // involved is a whole number below 2^24, so floats hold them exactly and
+    // no integer multiplies are needed (SSE2 has none for 32-bit lanes).
+    inline F4 mod289(F4 x) {
+        return x - floor(x * F4::set1(1.0f / 289.0f)) * F4::set1(289.0f);
+    }
+
+    inline F4 permute(F4 x) {
+        return mod289((x * F4::set1(34.0f) + F4::set1(1.0f)) * x);
+    }
+
+    // Gradient picked by the hash, dotted with the offset from its lattice point
+    inline F4 gradient(F4 hash, F4 dx, F4 dz) {
+        F4 gx = hash * F4::set1(1.0f / 41.0f);
+        gx = (gx - floor(gx)) * F4::set1(2.0f) - F4::set1(1.0f);
+        F4 gz = abs(gx) - F4::set1(0.5f);
+        gx = gx - floor(gx + F4::set1(0.5f));
+        return gx * dx + gz * dz;
+    }
+
+    // 2D gradient noise, roughly -1..1. The offsets shift the lattice so every
+    // octave (and every seed) reads a different part of the permutation.
+    F4 gradientNoise(F4 x, F4 z, F4 offsetX, F4 offsetZ) {
+        const F4 one = F4::set1(1.0f);
+
+        F4 cellX = floor(x), cellZ = floor(z);
+        F4 dx = x - cellX, dz = z - cellZ;
+        F4 ix = mod289(cellX + offsetX);
+        F4 iz = mod289(cellZ + offsetZ);
+
+        F4 px0 = permute(ix), px1 = permute(ix + one);
+        F4 g00 = gradient(permute(px0 + iz), dx, dz);
+        F4 g10 = gradient(permute(px1 + iz), dx - one, dz);
+        F4 g01 = gradient(permute(px0 + iz + one), dx, dz - one);
+        F4 g11 = gradient(permute(px1 + iz + one), dx - one, dz - one);
+
+        // Quintic fade, so the slope (and the lighting) has no creases
+        F4 u = dx * dx * dx * (dx * (dx * F4::set1(6.0f) - F4::set1(15.0f)) + F4::set1(10.0f));
+        F4 v = dz * dz * dz * (dz * (dz * F4::set1(6.0f) - F4::set1(15.0f)) + F4::set1(10.0f));
+
+        F4 top = g00 + (g10 - g00) * u;
+        F4 bottom = g01 + (g11 - g01) * u;
+        return (top + (bottom - top) * v) * F4::set1(2.0f);
+    }
+}
+
+void TerrainGenerator::generate(JobSystem& jobs, Heightfield& out) const {
+    int quads = std::max(1, (int)ceilf(settings.size / settings.spacing));
+
+    out.spacing = settings.spacing;
+    out.samplesX = quads + 1;
+    out.samplesZ = quads + 1;
+    out.origin = { -0.5f * quads * settings.spacing, -0.5f * quads * settings.spacing };
+    out.heights.assign((size_t)out.samplesX * out.samplesZ, 0.0f);
+
+    generateHeights(jobs, out);
+    erode(jobs, out);
+    smooth(jobs, out);
+}
+
+void TerrainGenerator::generateHeights(JobSystem& jobs, Heightfield& field) const {
+    const int octaves = std::clamp(settings.octaves, 1, kMaxOctaves);
+
+    // 1. Per-octave lattice offsets and frequencies from the seed
+    float offsetX[kMaxOctaves], offsetZ[kMaxOctaves], frequency[kMaxOctaves], weight[kMaxOctaves];
+    float f = 1.0f / settings.wavelength, w = 1.0f, weightSum = 0.0f;
+    for (int o = 0; o < octaves; o++) {
+        uint64_t h = splitmix(((uint64_t)settings.seed << 8) | (uint64_t)o);
+        offsetX[o] = (float)(h % 289);
+        offsetZ[o] = (float)((h >> 32) % 289);
+        frequency[o] = f;
+        weight[o] = w;
+        weightSum += w;
+        f *= settings.lacunarity;
+        w *= settings.gain;
+    }
+
+    const float amplitude = settings.amplitude;
+    const float ridges = Clamp(settings.ridges, 0.0f, 1.0f);
+    const float invWeightSum = 1.0f / weightSum;
+
+    // 2. One job per chunk of samples, four samples per noise call
+    const int cq = std::max(1, settings.chunkQuads);
+    const int chunksX = (field.samplesX + cq - 1) / cq;
+    const int chunksZ = (field.samplesZ + cq - 1) / cq;
+
+    jobs.parallelFor(chunksX * chunksZ, 1, [&](int begin, int end) {
+        for (int c = begin; c < end; c++) {
+            int x0 = (c % chunksX) * cq, x1 = std::min(x0 + cq, field.samplesX);
+            int z0 = (c / chunksX) * cq, z1 = std::min(z0 + cq, field.samplesZ);
+
+            for (int z = z0; z < z1; z++) {
+                F4 worldZ = F4::set1(field.origin.y + z * field.spacing);
+                float* row = &field.heights[(size_t)z * field.samplesX];
+
+                for (int x = x0; x < x1; x += 4) {
+                    float wx = field.origin.x + x * field.spacing;
+                    float sp = field.spacing;
+                    F4 worldX = F4::set(wx, wx + sp, wx + 2.0f * sp, wx + 3.0f * sp);
+
+                    F4 base = F4::set1(0.0f);
+                    F4 crest = F4::set1(0.0f);
+                    for (int o = 0; o < octaves; o++) {
+                        F4 freq = F4::set1(frequency[o]);
+                        F4 n = gradientNoise(worldX * freq, worldZ * freq, F4::set1(offsetX[o]), F4::set1(offsetZ[o]));
+
+                        // Ridged share: sharp where the noise crosses zero
+                        F4 r = F4::set1(1.0f) - min(abs(n), F4::set1(1.0f));
+                        base = base + n * F4::set1(weight[o]);
+                        crest = crest + r * r * F4::set1(weight[o]);
+                    }
+
+                    F4 hills = base * F4::set1(invWeightSum);
+                    F4 peaks = crest * F4::set1(2.0f * invWeightSum) - F4::set1(1.0f);
+                    F4 h = (hills * F4::set1(1.0f - ridges) + peaks * F4::set1(ridges)) * F4::set1(amplitude);
+
+                    float lanes[4];
+                    h.store(lanes);
+                    for (int i = 0; i < 4 && x + i < x1; i++) row[x + i] = lanes[i];
+                }
+            }
+        }
+    });
+}
+
+// Thermal erosion: wherever two neighbours differ by more than the talus
+// slope, a share of the excess slides down. Each cell only writes itself,
+// reading last pass's heights, so rows run in parallel and the result
+// doesn't depend on the order. Material moves, it's never lost.
+void TerrainGenerator::erode(JobSystem& jobs, Heightfield& field) const {
+    const int sx = field.samplesX, sz = field.samplesZ;
+    const float maxStep = settings.talus * field.spacing;
+    const float rate = 0.1f;    // Below 1/8 so four neighbours can't overshoot
+
+    std::vector<float> next(field.heights.size());
+
+    for (int pass = 0; pass < settings.erosionPasses; pass++) {
+        const std::vector<float>& h = field.heights;
+
+        jobs.parallelFor(sz, 32, [&](int rowBegin, int rowEnd) {
+            for (int z = rowBegin; z < rowEnd; z++) {
+                for (int x = 0; x < sx; x++) {
+                    size_t i = (size_t)z * sx + x;
+                    float here = h[i];
+                    float delta = 0.0f;
+
+                    auto exchange = [&](size_t n) {
+                        float d = h[n] - here;
+                        if (d > maxStep) delta += rate * (d - maxStep);
+                        else if (-d > maxStep) delta -= rate * (-d - maxStep);
+                    };
+                    if (x > 0) exchange(i - 1);
+                    if (x < sx - 1) exchange(i + 1);
+                    if (z > 0) exchange(i - sx);
+                    if (z < sz - 1) exchange(i + sx);
+
+                    next[i] = here + delta;
+                }
+            }
+        });
+
+        field.heights.swap(next);
+    }
+}
+
+// Light low-pass to take the grid-scale noise off (and the terraces
+// erosion leaves behind)
+void TerrainGenerator::smooth(JobSystem& jobs, Heightfield& field) const {
+    const int sx = field.samplesX, sz = field.samplesZ;
+    std::vector<float> next(field.heights.size());
+
+    for (int pass = 0; pass < settings.smoothPasses; pass++) {
+        const std::vector<float>& h = field.heights;
+
+        jobs.parallelFor(sz, 32, [&](int rowBegin, int rowEnd) {
+            for (int z = rowBegin; z < rowEnd; z++) {
+                for (int x = 0; x < sx; x++) {
+                    size_t i = (size_t)z * sx + x;
+                    float left = h[x > 0 ? i - 1 : i], right = h[x < sx - 1 ? i + 1 : i];
+                    float down = h[z > 0 ? i - sx : i], up = h[z < sz - 1 ? i + sx : i];
+                    next[i] = 0.5f * h[i] + 0.125f * (left + right + down + up);
+                }
+            }
+        });
+
+        field.heights.swap(next);
+    }
+}
+
+void TerrainGenerator::buildChunks(const Heightfield& field, JobSystem& jobs, std::vector<Chunk>& out) const {
+    const int cq = std::max(1, std::min(settings.chunkQuads, 254));    // 16-bit indices
+    const int quadsX = field.samplesX - 1, quadsZ = field.samplesZ - 1;
+    const int chunksX = (quadsX + cq - 1) / cq;
+    const int chunksZ = (quadsZ + cq - 1) / cq;
+
+    out.assign((size_t)chunksX * chunksZ, Chunk{});
+    if (quadsX <= 0 || quadsZ <= 0) return;
+
+    auto height = [&field](int x, int z) { return field.heights[(size_t)z * field.samplesX + x]; };
+
+    jobs.parallelFor(chunksX * chunksZ, 1, [&](int begin, int end) {
+        for (int c = begin; c < end; c++) {
+            int qx0 = (c % chunksX) * cq, qx1 = std::min(qx0 + cq, quadsX);
+            int qz0 = (c / chunksX) * cq, qz1 = std::min(qz0 + cq, quadsZ);
+            int w = qx1 - qx0 + 1, d = qz1 - qz0 + 1;
+
+            Chunk& chunk = out[c];
+            Mesh& mesh = chunk.mesh;
+            mesh = Mesh{};
+            mesh.vertexCount = w * d;
+            mesh.triangleCount = 2 * (w - 1) * (d - 1);
+            mesh.vertices = (float*)MemAlloc(mesh.vertexCount * 3 * sizeof(float));
+            mesh.normals = (float*)MemAlloc(mesh.vertexCount * 3 * sizeof(float));
+            mesh.indices = (unsigned short*)MemAlloc(mesh.triangleCount * 3 * sizeof(unsigned short));
+
+            chunk.bounds = { { FLT_MAX, FLT_MAX, FLT_MAX }, { -FLT_MAX, -FLT_MAX, -FLT_MAX } };
+
+            // 1. Vertices straight from the field, normals from central differences
+            // over the whole field so neighbouring chunks light seamlessly
+            for (int z = qz0; z <= qz1; z++) {
+                for (int x = qx0; x <= qx1; x++) {
+                    int v = (z - qz0) * w + (x - qx0);
+                    Vector3 p = field.vertex(x, z);
+
+                    int xl = std::max(x - 1, 0), xr = std::min(x + 1, quadsX);
+                    int zd = std::max(z - 1, 0), zu = std::min(z + 1, quadsZ);
+                    float slopeX = (height(xr, z) - height(xl, z)) / ((xr - xl) * field.spacing);
+                    float slopeZ = (height(x, zu) - height(x, zd)) / ((zu - zd) * field.spacing);
+                    Vector3 n = Vector3Normalize({ -slopeX, 1.0f, -slopeZ });
+
+                    mesh.vertices[v*3 + 0] = p.x;
+                    mesh.vertices[v*3 + 1] = p.y;
+                    mesh.vertices[v*3 + 2] = p.z;
+                    mesh.normals[v*3 + 0] = n.x;
+                    mesh.normals[v*3 + 1] = n.y;
+                    mesh.normals[v*3 + 2] = n.z;
+
+                    chunk.bounds.min = Vector3Min(chunk.bounds.min, p);
+                    chunk.bounds.max = Vector3Max(chunk.bounds.max, p);
+                }
+            }
+
+            // 2. Two triangles per quad, split the way the collider splits them
+            int t = 0;
+            for (int z = 0; z < d - 1; z++) {
+                for (int x = 0; x < w - 1; x++) {
+                    unsigned short v00 = (unsigned short)(z * w + x), v10 = (unsigned short)(v00 + 1);
+                    unsigned short v01 = (unsigned short)(v00 + w), v11 = (unsigned short)(v01 + 1);
+                    unsigned short tri[6] = { v00, v01, v11, v00, v11, v10 };
+                    for (unsigned short idx : tri) mesh.indices[t++] = idx;
+                }
+            }
+        }
+    });
+}
@@ -0,0 +1,197 @@
+#include "TextRenderer.hpp"
+#include "rlgl.h"
+#include <cmath>
+
+namespace {
+    // Printable ASCII, which is all the UI uses
+    const int firstCodepoint = 32;
+    const int glyphCount = 95;
+}
+
+TextRenderer::~TextRenderer() {
+    shutdown();
+}
+
+bool TextRenderer::init(const char* fontPath, Shader shader, int bakeSize) {
+    int dataSize = 0;
+    unsigned char* data = LoadFileData(fontPath, &dataSize);
+    if (data == nullptr) {
+        TraceLog(LOG_WARNING, "TEXT: Could not read %s, falling back to the default font", fontPath);
+        UnloadShader(shader);
+        return false;
+    }
+
+    // 1. Rasterise every glyph as a distance field (stb_truetype under the hood)
+    font.baseSize = bakeSize;
+    font.glyphCount = glyphCount;
+    font.glyphPadding = 0;
+    font.glyphs = LoadFontData(data, dataSize, bakeSize, nullptr, glyphCount, FONT_SDF);
+    UnloadFileData(data);
+
+    if (font.glyphs == nullptr) {
+        TraceLog(LOG_WARNING, "TEXT: Failed to bake %s", fontPath);
+        UnloadShader(shader);
+        return false;
+    }
+
+    // 2. Pack them into one atlas texture (skyline packing)
+    Image atlas = GenImageFontAtlas(font.glyphs, &font.recs, glyphCount, bakeSize, 0, 1);
+    font.texture = LoadTextureFromImage(atlas);
+    UnloadImage(atlas);
+
+    // The SDF edge is reconstructed from filtered samples, so bilinear is a must
+    SetTextureFilter(font.texture, TEXTURE_FILTER_BILINEAR);
+
+    // 3. Default vertex shader, SDF fragment shader
+    sdfShader = shader;
+
+    // Reserve enough for a full menu so the batch doesn't grow mid-frame
+    batchQuads.reserve(512);
+    batch.reserve(32);
+
+    ready = true;
+    return true;
+}
+
+void TextRenderer::shutdown() {
+    if (!ready) return;
+
+    // UnloadFont frees the glyph images, recs and atlas texture
+    UnloadFont(font);
+    UnloadShader(sdfShader);
+    font = {};
+    layoutCache.clear();
+    ready = false;
+}
+
+int TextRenderer::getGlyphIndex(int codepoint) const {
+    int index = codepoint - firstCodepoint;
+    if (index < 0 || index >= glyphCount) index = '?' - firstCodepoint;
+    return index;
+}
+
+void TextRenderer::buildLayout(const char* text, TextLayout& out) const {
+    out.quads.clear();
+
+    float x = 0.0f;
+    float y = 0.0f;
+    float width = 0.0f;
+    float lineHeight = (float)font.baseSize;
+
+    for (const char* c = text; *c != '\0'; c++) {
+        if (*c == '\n') {
+            width = fmaxf(width, x);
+            x = 0.0f;
+            y += lineHeight;
+            continue;
+        }
+
+        int index = getGlyphIndex((unsigned char)*c);
+        const GlyphInfo& glyph = font.glyphs[index];
+        const Rectangle& rec = font.recs[index];
+
+        // Whitespace only advances the pen
+        if (*c != ' ' && *c != '\t') {
+            GlyphQuad q;
+            q.dest = { x + glyph.offsetX, y + glyph.offsetY, rec.width, rec.height };
+            q.source = rec;
+            out.quads.push_back(q);
+        }
+
+        x += (glyph.advanceX == 0) ? rec.width : (float)glyph.advanceX;
+    }
+
+    out.size = { fmaxf(width, x), y + lineHeight };
+}
+
+const TextRenderer::TextLayout& TextRenderer::getLayout(const char* text, bool cacheLayout) {
+    if (!cacheLayout) {
+        buildLayout(text, scratchLayout);
+        return scratchLayout;
+    }
+
+    lookupKey.assign(text);
+    auto it = layoutCache.find(lookupKey);
+    if (it != layoutCache.end()) return it->second;
+
+    TextLayout& layout = layoutCache[lookupKey];
+    buildLayout(text, layout);
+    return layout;
+}
+
+Vector2 TextRenderer::measure(const char* text, float fontSize, bool cacheLayout) {
+    if (!ready) return { (float)MeasureText(text, (int)fontSize), fontSize };
+
+    const TextLayout& layout = getLayout(text, cacheLayout);
+    float scale = fontSize / (float)font.baseSize;
+    return { layout.size.x * scale, layout.size.y * scale };
+}
+
+void TextRenderer::draw(const char* text, Vector2 position, float fontSize, Color color, bool cacheLayout) {
+    if (!ready) {
+        DrawText(text, (int)position.x, (int)position.y, (int)fontSize, color);
+        return;
+    }
+
+    const TextLayout& layout = getLayout(text, cacheLayout);
+
+    QueuedText queued;
+    queued.firstQuad = batchQuads.size();
+    queued.quadCount = layout.quads.size();
+    queued.position = position;
+    queued.scale = fontSize / (float)font.baseSize;
+    queued.color = color;
+
+    batchQuads.insert(batchQuads.end(), layout.quads.begin(), layout.quads.end());
+    batch.push_back(queued);
+}
+
+void TextRenderer::drawCentered(const char* text, Vector2 center, float fontSize, Color color, bool cacheLayout) {
+    Vector2 size = measure(text, fontSize, cacheLayout);
+    draw(text, { center.x - size.x / 2.0f, center.y - size.y / 2.0f }, fontSize, color, cacheLayout);
+}
+
+void TextRenderer::flush() {
+    if (batch.empty()) return;
+
+    float texWidth = (float)font.texture.width;
+    float texHeight = (float)font.texture.height;
+
+    // Make sure the whole batch fits in rlgl's vertex buffer so it really is one draw
+    rlCheckRenderBatchLimit(4 * (int)batchQuads.size());
+
+    BeginShaderMode(sdfShader);
+    rlSetTexture(font.texture.id);
+    rlBegin(RL_QUADS);
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+
+        for (const QueuedText& t : batch) {
+            rlColor4ub(t.color.r, t.color.g, t.color.b, t.color.a);
+
+            for (size_t i = t.firstQuad; i < t.firstQuad + t.quadCount; i++) {
+                const GlyphQuad& q = batchQuads[i];
+
+                float x0 = t.position.x + q.dest.x * t.scale;
+                float y0 = t.position.y + q.dest.y * t.scale;
+                float x1 = x0 + q.dest.width * t.scale;
+                float y1 = y0 + q.dest.height * t.scale;
+
+                float u0 = q.source.x / texWidth;
+                float v0 = q.source.y / texHeight;
+                float u1 = (q.source.x + q.source.width) / texWidth;
+                float v1 = (q.source.y + q.source.height) / texHeight;
+
+                // Same winding DrawTexturePro uses
+                rlTexCoord2f(u0, v0); rlVertex2f(x0, y0);
+                rlTexCoord2f(u0, v1); rlVertex2f(x0, y1);
+                rlTexCoord2f(u1, v1); rlVertex2f(x1, y1);
+                rlTexCoord2f(u1, v0); rlVertex2f(x1, y0);
+            }
+        }
+    rlEnd();
+    rlSetTexture(0);
+    EndShaderMode();
+
+    batch.clear();
+    batchQuads.clear();
+}
@@ -0,0 +1,234 @@
+#include "Trace.hpp"
+#include "Memory.hpp"
+#include "raylib.h"
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace trace {
+    namespace detail {
+        std::atomic<bool> recording{ false };
+    }
+
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        // Events a thread can get ahead of the writer before it starts dropping
+        const uint64_t kRingSize = 1 << 14;
+        const auto kDrainInterval = std::chrono::milliseconds(10);
+
+        struct Event {
+            const char* name;
+            int64_t beginNs;        // From the session start
+            int64_t durationNs;
+        };
+
+        // One producer (the owning thread), one consumer (the writer)
+        struct ThreadBuffer {
+            Event events[kRingSize];
+            std::atomic<uint64_t> head{ 0 };            // Next slot the owner writes
+            std::atomic<uint64_t> tail{ 0 };            // Next slot the writer reads
+            std::atomic<uint64_t> dropped{ 0 };
+            std::atomic<const char*> name{ nullptr };
+            int id = 0;
+        };
+
+        // Buffers live until exit, a thread that ended may still have events queued
+        std::mutex buffersMutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+        thread_local ThreadBuffer* localBuffer = nullptr;
+        thread_local const char* localName = nullptr;
+
+        std::atomic<int64_t> epochNs{ 0 };
+
+        // Session state, only touched by whoever calls start/stop/endFrame
+        std::thread writer;
+        FILE* file = nullptr;
+        int framesLeft = 0;
+        bool frameOpen = false;
+        Clock::time_point frameBegin;
+
+        std::mutex writerMutex;
+        std::condition_variable writerWake;
+        bool writerStop = false;
+
+        int64_t toNs(Clock::time_point t) {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+        }
+
+        ThreadBuffer& getBuffer() {
+            if (!localBuffer) {
+                // Once per thread, the only allocation on the recording path
+                memory::UntrackedScope untracked;
+                std::unique_ptr<ThreadBuffer> buffer(new ThreadBuffer());
+                buffer->name.store(localName, std::memory_order_relaxed);
+
+                std::lock_guard<std::mutex> lock(buffersMutex);
+                buffer->id = (int)buffers.size() + 1;
+                localBuffer = buffer.get();
+                buffers.push_back(std::move(buffer));
+            }
+            return *localBuffer;
+        }
+
+        // Writer thread: everything published so far goes to the file
+        void drain(std::vector<ThreadBuffer*>& scratch, bool& first) {
+            {
+                std::lock_guard<std::mutex> lock(buffersMutex);
+                scratch.clear();
+                for (const std::unique_ptr<ThreadBuffer>& b : buffers) scratch.push_back(b.get());
+            }
+
+            for (ThreadBuffer* b : scratch) {
+                uint64_t head = b->head.load(std::memory_order_acquire);
+                uint64_t tail = b->tail.load(std::memory_order_relaxed);
+
+                for (; tail != head; tail++) {
+                    const Event& e = b->events[tail % kRingSize];
+                    fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}",
+                            first ? "" : ",\n", e.name, e.beginNs / 1000.0, e.durationNs / 1000.0, b->id);
+                    first = false;
+                }
+                b->tail.store(tail, std::memory_order_release);
+            }
+        }
+
+        void writerLoop() {
+            std::vector<ThreadBuffer*> scratch;
+            bool first = true;
+
+            while (true) {
+                bool finishing;
+                {
+                    std::unique_lock<std::mutex> lock(writerMutex);
+                    writerWake.wait_for(lock, kDrainInterval, [] { return writerStop; });
+                    finishing = writerStop;
+                }
+
+                drain(scratch, first);
+                if (finishing) break;
+            }
+
+            // Row labels, and a word about anything that didn't fit
+            uint64_t dropped = 0;
+            for (ThreadBuffer* b : scratch) {
+                dropped += b->dropped.exchange(0, std::memory_order_relaxed);
+
+                const char* name = b->name.load(std::memory_order_relaxed);
+                if (!name) continue;
+                fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                        first ? "" : ",\n", b->id, name);
+                first = false;
+            }
+            fprintf(file, "\n]}\n");
+            fclose(file);
+            file = nullptr;
+
+            if (dropped > 0) TraceLog(LOG_WARNING, "TRACE: %llu events dropped, the writer fell behind", (unsigned long long)dropped);
+            TraceLog(LOG_INFO, "TRACE: Capture written");
+        }
+    }
+
+    bool start(const char* path, int frameCount) {
+        if (isRecording()) return false;
+        if (writer.joinable()) writer.join();
+
+        file = fopen(path, "w");
+        if (!file) {
+            TraceLog(LOG_WARNING, "TRACE: Can't open '%s' for writing", path);
+            return false;
+        }
+        fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+        // Nobody is draining now, so stragglers from the last session can be skipped here
+        {
+            std::lock_guard<std::mutex> lock(buffersMutex);
+            for (std::unique_ptr<ThreadBuffer>& b : buffers) {
+                b->tail.store(b->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+                b->dropped.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        epochNs.store(toNs(Clock::now()), std::memory_order_relaxed);
+        framesLeft = frameCount;
+        frameOpen = false;
+        writerStop = false;
+        writer = std::thread(writerLoop);
+
+        detail::recording.store(true, std::memory_order_release);
+        if (frameCount > 0) TraceLog(LOG_INFO, "TRACE: Recording %d frames to %s", frameCount, path);
+        else TraceLog(LOG_INFO, "TRACE: Recording to %s", path);
+        return true;
+    }
+
+    void stop() {
+        if (!isRecording()) return;
+        detail::recording.store(false, std::memory_order_relaxed);
+
+        {
+            std::lock_guard<std::mutex> lock(writerMutex);
+            writerStop = true;
+        }
+        writerWake.notify_one();
+    }
+
+    void shutdown() {
+        stop();
+        if (writer.joinable()) writer.join();
+    }
+
+    void setThreadName(const char* name) {
+        localName = name;
+        if (localBuffer) localBuffer->name.store(name, std::memory_order_relaxed);
+    }
+
+    void record(const char* name, Clock::time_point begin, Clock::time_point end) {
+        if (!isRecording()) return;
+
+        // Spans that started before the session would land at negative times
+        int64_t beginNs = toNs(begin) - epochNs.load(std::memory_order_relaxed);
+        if (beginNs < 0) return;
+
+        ThreadBuffer& b = getBuffer();
+        uint64_t head = b.head.load(std::memory_order_relaxed);
+        if (head - b.tail.load(std::memory_order_acquire) == kRingSize) {
+            b.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        b.events[head % kRingSize] = { name, beginNs, toNs(end) - toNs(begin) };
+        b.head.store(head + 1, std::memory_order_release);
+    }
+
+    void endFrame() {
+        if (!isRecording()) return;
+
+        // The first call only opens a frame, loading isn't one
+        Clock::time_point now = Clock::now();
+        bool closed = frameOpen;
+        if (closed) record("frame", frameBegin, now);
+        frameBegin = now;
+        frameOpen = true;
+
+        if (closed && framesLeft > 0 && --framesLeft == 0) stop();
+    }
+
+    void Phases::begin(const char* name) {
+        end();
+        if (!log && !isRecording()) return;
+        current = name;
+        started = Clock::now();
+    }
+
+    void Phases::end() {
+        if (!current) return;
+        Clock::time_point now = Clock::now();
+        record(current, started, now);
+        if (log) TraceLog(LOG_INFO, "LOAD: %-20s %8.2f ms", current, std::chrono::duration<float, std::milli>(now - started).count());
+        current = nullptr;
+    }
+}
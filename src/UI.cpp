@@ -0,0 +1,191 @@
+#include "UI.hpp"
+#include "raymath.h"
+#include "rlgl.h"
+
+UIScreen::~UIScreen() {
+    unload();
+}
+
+void UIScreen::unload() {
+    if (cache.id != 0) {
+        UnloadRenderTexture(cache);
+        cache = {};
+    }
+    dirty = true;
+}
+
+int UIScreen::add(const UIWidget& widget) {
+    widgets.push_back(widget);
+    layoutWidth = 0; // Force a layout pass on the next update/draw
+    return (int)widgets.size() - 1;
+}
+
+void UIScreen::invalidate(const UIWidget& widget) {
+    // Uncached widgets are redrawn every frame anyway
+    if (widget.cached) dirty = true;
+}
+
+void UIScreen::setText(int id, const std::string& text) {
+    UIWidget& w = widgets[id];
+    if (w.text == text) return;
+    w.text = text;
+    w.dynamicText = true;
+    invalidate(w);
+}
+
+void UIScreen::setValue(int id, float value) {
+    UIWidget& w = widgets[id];
+    value = Clamp(value, 0.0f, 1.0f);
+    if (w.value == value) return;
+    w.value = value;
+
+    // Keep the handle centred on the track at the new value
+    w.handle.x = w.bounds.x + (w.value * w.bounds.width) - (w.handle.width / 2.0f);
+    invalidate(w);
+}
+
+void UIScreen::setVisible(int id, bool visible) {
+    UIWidget& w = widgets[id];
+    if (w.visible == visible) return;
+    w.visible = visible;
+    invalidate(w);
+}
+
+void UIScreen::layout(int screenWidth, int screenHeight) {
+    float sw = (float)screenWidth;
+    float sh = (float)screenHeight;
+
+    for (UIWidget& w : widgets) {
+        if (w.type == WidgetType::Overlay) {
+            w.bounds = { 0, 0, sw, sh };
+            continue;
+        }
+
+        float width = w.size.x * sw;
+        float height = w.size.y * sh;
+        w.bounds = { w.anchor.x * sw - width / 2.0f, w.anchor.y * sh - height / 2.0f, width, height };
+
+        if (w.type == WidgetType::Slider) {
+            // Use the CENTER of the track Y for the handle Y
+            Vector2 handleSize = { w.handleSize.x * sw, w.handleSize.y * sh };
+            w.handle = {
+                w.bounds.x + (w.value * w.bounds.width) - handleSize.x / 2.0f,
+                w.bounds.y + (w.bounds.height / 2.0f) - (handleSize.y / 2.0f),
+                handleSize.x,
+                handleSize.y
+            };
+        }
+    }
+
+    layoutWidth = screenWidth;
+    layoutHeight = screenHeight;
+    dirty = true;
+}
+
+void UIScreen::update() {
+    if (GetScreenWidth() != layoutWidth || GetScreenHeight() != layoutHeight) {
+        layout(GetScreenWidth(), GetScreenHeight());
+    }
+
+    clickedId = -1;
+    Vector2 mousePos = GetMousePosition();
+
+    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
+        for (int i = 0; i < (int)widgets.size(); i++) {
+            const UIWidget& w = widgets[i];
+            if (!w.visible) continue;
+
+            if (w.type == WidgetType::Button && CheckCollisionPointRec(mousePos, w.bounds)) clickedId = i;
+            if (w.type == WidgetType::Slider && CheckCollisionPointRec(mousePos, w.handle)) draggingId = i;
+        }
+    }
+
+    if (IsMouseButtonReleased(MOUSE_LEFT_BUTTON)) draggingId = -1;
+
+    if (draggingId >= 0) {
+        const Rectangle& track = widgets[draggingId].bounds;
+        float mouseX = Clamp(mousePos.x, track.x, track.x + track.width);
+        setValue(draggingId, (mouseX - track.x) / track.width);
+    }
+}
+
+void UIScreen::drawWidget(const UIWidget& w, TextRenderer& text) const {
+    float fontSize = w.textSize * (float)layoutHeight;
+    Vector2 center = { w.bounds.x + w.bounds.width / 2.0f, w.bounds.y + w.bounds.height / 2.0f };
+
+    switch (w.type) {
+        case WidgetType::Overlay:
+        case WidgetType::Panel:
+            DrawRectangleRec(w.bounds, w.color);
+            break;
+
+        case WidgetType::Button:
+            DrawRectangleRec(w.bounds, w.color);
+            text.drawCentered(w.text.c_str(), center, fontSize, w.textColor, !w.dynamicText);
+            break;
+
+        case WidgetType::Label:
+            text.drawCentered(w.text.c_str(), center, fontSize, w.textColor, !w.dynamicText);
+            break;
+
+        case WidgetType::Slider:
+            DrawRectangleRec(w.bounds, w.color);
+            DrawRectangleRec(w.handle, w.textColor);
+            break;
+
+        case WidgetType::Crosshair:
+            DrawCircle((int)center.x, (int)center.y, 4, w.color); // Clean dot crosshair
+            DrawCircleLines((int)center.x, (int)center.y, 10, Fade(w.color, 0.5f)); // Subtle ring
+            break;
+    }
+}
+
+void UIScreen::rebuildCache(TextRenderer& text) {
+    if (cache.id == 0 || cache.texture.width != layoutWidth || cache.texture.height != layoutHeight) {
+        if (cache.id != 0) UnloadRenderTexture(cache);
+        cache = LoadRenderTexture(layoutWidth, layoutHeight);
+    }
+
+    BeginTextureMode(cache);
+        ClearBackground(BLANK);
+
+        // Colour blends as usual but alpha accumulates, which leaves the
+        // texture premultiplied so it composites exactly like drawing direct
+        rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA, RL_FUNC_ADD, RL_FUNC_ADD);
+        BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+            for (const UIWidget& w : widgets) {
+                if (w.cached && w.visible) drawWidget(w, text);
+            }
+            text.flush();
+        EndBlendMode();
+    EndTextureMode();
+
+    dirty = false;
+}
+
+void UIScreen::draw(TextRenderer& text) {
+    if (GetScreenWidth() != layoutWidth || GetScreenHeight() != layoutHeight) {
+        layout(GetScreenWidth(), GetScreenHeight());
+    }
+
+    bool hasCached = false;
+    for (const UIWidget& w : widgets) {
+        if (w.cached && w.visible) { hasCached = true; break; }
+    }
+
+    // 1. Static panels: one textured quad unless something changed
+    if (hasCached) {
+        if (dirty) rebuildCache(text);
+
+        BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+            // Render textures are stored bottom-up, hence the negative height
+            DrawTextureRec(cache.texture, { 0, 0, (float)layoutWidth, -(float)layoutHeight }, { 0, 0 }, WHITE);
+        EndBlendMode();
+    }
+
+    // 2. Everything else, shapes share rlgl's batch and text goes out in one draw
+    for (const UIWidget& w : widgets) {
+        if (!w.cached && w.visible) drawWidget(w, text);
+    }
+    text.flush();
+}
@@ -0,0 +1,183 @@
+#include "VertexPacking.hpp"
+#include "GLExt.hpp"
+#include "raymath.h"
+#include "rlgl.h"
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace {
+    // raylib's attribute slots, bound by name in every shader it loads
+    const unsigned int kPositionSlot = 0;
+    const unsigned int kTexcoordSlot = 1;
+    const unsigned int kNormalSlot = 2;
+
+    // vboId slots: raylib keeps the index buffer in 6, 0..5 are vertex data
+    const int kIndexBuffer = 6;
+
+    int16_t toSnorm16(float v) {
+        return (int16_t)lroundf(Clamp(v, -1.0f, 1.0f) * 32767.0f);
+    }
+
+    bool canPack(const Mesh& mesh) {
+        return mesh.vertices && mesh.vaoId != 0 && mesh.vboId != nullptr
+            && !mesh.colors && !mesh.boneIds && !mesh.boneWeights && !mesh.animVertices;
+    }
+
+    size_t floatBytes(const Mesh& mesh) {
+        size_t perVertex = 3 * sizeof(float);
+        if (mesh.texcoords) perVertex += 2 * sizeof(float);
+        if (mesh.normals) perVertex += 3 * sizeof(float);
+        if (mesh.tangents) perVertex += 4 * sizeof(float);
+        if (mesh.texcoords2) perVertex += 2 * sizeof(float);
+        return perVertex * (size_t)mesh.vertexCount;
+    }
+}
+
+namespace VertexPacking {
+    void encodeOctahedral(Vector3 n, int16_t out[2]) {
+        // Project onto the octahedron |x| + |y| + |z| = 1, then fold the
+        // lower half over the diagonals so it fits in the unit square
+        float l1 = fabsf(n.x) + fabsf(n.y) + fabsf(n.z);
+        if (l1 <= 0.0f) {
+            out[0] = 0;
+            out[1] = 0;
+            return;
+        }
+
+        float x = n.x / l1, y = n.y / l1;
+        if (n.z < 0.0f) {
+            float fx = (1.0f - fabsf(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+            float fy = (1.0f - fabsf(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+            x = fx;
+            y = fy;
+        }
+        out[0] = toSnorm16(x);
+        out[1] = toSnorm16(y);
+    }
+
+    // IEEE binary16, round to nearest even. UVs only, so no need to be fast.
+    uint16_t toHalf(float value) {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+
+        uint32_t sign = (bits >> 16) & 0x8000u;
+        uint32_t rawExponent = (bits >> 23) & 0xFFu;
+        uint32_t mantissa = bits & 0x7FFFFFu;
+
+        if (rawExponent == 0xFFu) return (uint16_t)(sign | 0x7C00u | (mantissa ? 0x200u : 0u));
+
+        int exponent = (int)rawExponent - 127 + 15;
+        if (exponent >= 31) return (uint16_t)(sign | 0x7C00u);
+
+        // Too small for a normal half: subnormal, or zero
+        if (exponent <= 0) {
+            if (exponent < -10) return (uint16_t)sign;
+            mantissa |= 0x800000u;
+            uint32_t shift = (uint32_t)(14 - exponent);
+            uint32_t half = mantissa >> shift;
+            uint32_t rest = mantissa & ((1u << shift) - 1u);
+            uint32_t middle = 1u << (shift - 1u);
+            if (rest > middle || (rest == middle && (half & 1u))) half++;
+            return (uint16_t)(sign | half);
+        }
+
+        // A carry out of the mantissa rolls into the exponent, which is right
+        uint32_t half = sign | ((uint32_t)exponent << 10) | (mantissa >> 13);
+        uint32_t rest = mantissa & 0x1FFFu;
+        if (rest > 0x1000u || (rest == 0x1000u && (half & 1u))) half++;
+        return (uint16_t)half;
+    }
+
+    bool packModel(Model& model, Shader defaultShader, Stats& stats) {
+        if (model.meshCount <= 0) return false;
+        for (int m = 0; m < model.meshCount; m++) {
+            if (!canPack(model.meshes[m])) return false;
+        }
+
+        GLExt::load();
+        if (!GLExt::vertexAttribPointer) return false;
+
+        // 1. One box for the whole model, so a single matrix decodes every mesh
+        Vector3 lo = { FLT_MAX, FLT_MAX, FLT_MAX };
+        Vector3 hi = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+        for (int m = 0; m < model.meshCount; m++) {
+            const Vector3* v = (const Vector3*)model.meshes[m].vertices;
+            for (int i = 0; i < model.meshes[m].vertexCount; i++) {
+                lo = Vector3Min(lo, v[i]);
+                hi = Vector3Max(hi, v[i]);
+            }
+        }
+
+        // Flat along an axis still needs an invertible matrix
+        Vector3 extent = Vector3Subtract(hi, lo);
+        extent = { fmaxf(extent.x, 1e-4f), fmaxf(extent.y, 1e-4f), fmaxf(extent.z, 1e-4f) };
+
+        std::vector<Vertex> packed;
+        for (int m = 0; m < model.meshCount; m++) {
+            Mesh& mesh = model.meshes[m];
+
+            // 2. Pack. Normals are scaled by the extent before encoding: the
+            // normal matrix undoes that scale along with the model's own.
+            packed.assign(mesh.vertexCount, Vertex{});
+            const Vector3* positions = (const Vector3*)mesh.vertices;
+            const Vector3* normals = (const Vector3*)mesh.normals;
+
+            for (int i = 0; i < mesh.vertexCount; i++) {
+                Vertex& out = packed[i];
+                out.position[0] = (uint16_t)lroundf(Clamp((positions[i].x - lo.x) / extent.x, 0.0f, 1.0f) * 65535.0f);
+                out.position[1] = (uint16_t)lroundf(Clamp((positions[i].y - lo.y) / extent.y, 0.0f, 1.0f) * 65535.0f);
+                out.position[2] = (uint16_t)lroundf(Clamp((positions[i].z - lo.z) / extent.z, 0.0f, 1.0f) * 65535.0f);
+
+                Vector3 n = normals ? normals[i] : (Vector3){ 0.0f, 1.0f, 0.0f };
+                encodeOctahedral(Vector3Normalize(Vector3Multiply(n, extent)), out.normal);
+
+                if (mesh.texcoords) {
+                    out.texcoord[0] = toHalf(mesh.texcoords[i * 2]);
+                    out.texcoord[1] = toHalf(mesh.texcoords[i * 2 + 1]);
+                }
+            }
+
+            // 3. Swap raylib's float buffers for one interleaved buffer. The
+            // index buffer is kept and re-attached to the new VAO (canPack()
+            // saw a VAO already, so they're supported).
+            unsigned int vao = rlLoadVertexArray();
+            rlEnableVertexArray(vao);
+
+            unsigned int vbo = rlLoadVertexBuffer(packed.data(), (int)(packed.size() * sizeof(Vertex)), false);
+            const int stride = (int)sizeof(Vertex);
+            GLExt::vertexAttribPointer(kPositionSlot, 3, GLExt::UNSIGNED_SHORT, 1, stride, (const void*)offsetof(Vertex, position));
+            GLExt::vertexAttribPointer(kNormalSlot, 2, GLExt::SHORT, 1, stride, (const void*)offsetof(Vertex, normal));
+            GLExt::vertexAttribPointer(kTexcoordSlot, 2, GLExt::HALF_FLOAT, 0, stride, (const void*)offsetof(Vertex, texcoord));
+            rlEnableVertexAttribute(kPositionSlot);
+            rlEnableVertexAttribute(kNormalSlot);
+            rlEnableVertexAttribute(kTexcoordSlot);
+            if (mesh.vboId[kIndexBuffer] != 0) rlEnableVertexBufferElement(mesh.vboId[kIndexBuffer]);
+            rlDisableVertexArray();
+
+            for (int b = 0; b < kIndexBuffer; b++) {
+                rlUnloadVertexBuffer(mesh.vboId[b]);
+                mesh.vboId[b] = 0;
+            }
+            rlUnloadVertexArray(mesh.vaoId);
+            mesh.vaoId = vao;
+            mesh.vboId[0] = vbo;
+
+            stats.meshes++;
+            stats.floatBytes += floatBytes(mesh);
+            stats.packedBytes += packed.size() * sizeof(Vertex);
+        }
+
+        // 4. Decode: 0..1 -> bounds, ahead of the model's own transform
+        Matrix decode = MatrixMultiply(MatrixScale(extent.x, extent.y, extent.z), MatrixTranslate(lo.x, lo.y, lo.z));
+        model.transform = MatrixMultiply(decode, model.transform);
+
+        if (defaultShader.id != 0) {
+            for (int i = 0; i < model.materialCount; i++) {
+                if (model.materials[i].shader.id == rlGetShaderIdDefault()) model.materials[i].shader = defaultShader;
+            }
+        }
+        return true;
+    }
+}
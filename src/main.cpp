@@ -1,7 +1,8 @@
 #include "Game.hpp"
+#include "GameConfig.hpp"
 
-int main() {
-    Game game;
+int main(int argc, char** argv) {
+    Game game(GameConfig::fromArgs(argc, argv));
     game.run();
     return 0;
-}
\ No newline at end of file
+}
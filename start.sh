@@ -10,4 +10,4 @@ ninja &> build_output.txt
 
 cd ..
 
-build/src/MyGame
\ No newline at end of file
+build/src/MyGame --pack=build/assets.pack
\ No newline at end of file
@@ -0,0 +1,70 @@
+// Packs the files the game loads into one archive (PackArchive.hpp).
+//
+// Run from the repo root, so names come out the way the game asks for them:
+//   build/tools/djo_pack [--out=assets.pack] [dir ...]
+// With no dirs it packs assets/. The build runs it as the pack_assets target,
+// which writes the build tree's assets.pack.
+
+#include "raylib.h"
+#include "PackArchive.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+    // What the game loads. The packs' .blend/.fbx sources, previews and
+    // licences stay loose, so do benchmark paths (F6 writes those).
+    const char* kPackedExtensions[] = { ".obj", ".mtl", ".png", ".jpg", ".jpeg", ".ttf", ".vs", ".fs" };
+
+    bool isPacked(const std::filesystem::path& path) {
+        std::string extension = path.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return (char)tolower(c); });
+        for (const char* packed : kPackedExtensions) {
+            if (extension == packed) return true;
+        }
+        return false;
+    }
+}
+
+int main(int argc, char** argv) {
+    SetTraceLogLevel(LOG_WARNING);
+
+    const char* out = "assets.pack";
+    std::vector<std::string> dirs;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--out=", 6) == 0) out = argv[i] + 6;
+        else dirs.push_back(argv[i]);
+    }
+    if (dirs.empty()) dirs.push_back("assets");
+
+    // Relative to here, which is where the game will be started from
+    namespace fs = std::filesystem;
+    std::error_code error;
+    fs::path root = fs::current_path();
+    std::vector<std::string> files;
+    for (const std::string& dir : dirs) {
+        for (fs::recursive_directory_iterator it(dir, error), end; it != end && !error; it.increment(error)) {
+            if (!it->is_regular_file() || !isPacked(it->path())) continue;
+            fs::path name = it->path().is_absolute() ? it->path().lexically_relative(root) : it->path();
+            files.push_back(name.generic_string());
+        }
+        if (error) {
+            fprintf(stderr, "djo_pack: can't walk %s: %s\n", dir.c_str(), error.message().c_str());
+            return 1;
+        }
+    }
+
+    PackArchive::BuildStats stats;
+    if (!PackArchive::build(out, files, stats)) {
+        fprintf(stderr, "djo_pack: failed to write %s\n", out);
+        return 1;
+    }
+
+    const double megabyte = 1024.0 * 1024.0;
+    printf("djo_pack: %d files (%d compressed), %.1f MB -> %.1f MB in %s\n", stats.files, stats.compressed,
+           stats.inputBytes / megabyte, stats.outputBytes / megabyte, out);
+    return 0;
+}